@@ -0,0 +1,110 @@
+// Copyright 2022 Andi Hellmund
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <data_crunching/dataframe.hpp>
+
+using namespace dacr;
+
+// Measures the row-wise and bulk insertion into a DataFrame.
+//
+// Usage: benchmark_insert [rows]
+//
+// The rows are inserted by scalar insert calls (with and without reserving
+// the capacity up front), by a single insertRanges call and by appending
+// chunks of 1000 rows. The default is 10M rows.
+
+using InsertTable = DataFrame<
+    Column<"id", int>,
+    Column<"age", int>,
+    Column<"revenue", double>
+>;
+
+template <typename Func>
+double measureSeconds (Func&& function) {
+    const auto start = std::chrono::steady_clock::now();
+    function();
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+void report (const std::string& name, std::size_t num_rows, double seconds, const InsertTable& table) {
+    std::cout << "rows: " << num_rows << ", " << name << ": " << seconds << "s"
+        << ", ns/row: " << seconds * 1e9 / static_cast<double>(num_rows)
+        << ", capacity: " << table.getCapacity()
+        << (table.getSize() == num_rows ? "" : " (size mismatch)") << "\n";
+}
+
+int main (int argc, char* argv[]) {
+    const std::size_t num_rows = argc > 1 ? std::stoul(argv[1]) : 10'000'000;
+
+    {
+        InsertTable table{};
+        const double seconds = measureSeconds([&]() {
+            for (std::size_t i = 0; i < num_rows; ++i) {
+                table.insert(static_cast<int>(i), static_cast<int>(i % 100), static_cast<double>(i));
+            }
+        });
+        report("insert", num_rows, seconds, table);
+    }
+
+    {
+        InsertTable table{};
+        const double seconds = measureSeconds([&]() {
+            table.reserve(num_rows);
+            for (std::size_t i = 0; i < num_rows; ++i) {
+                table.insert(static_cast<int>(i), static_cast<int>(i % 100), static_cast<double>(i));
+            }
+        });
+        report("insert (reserved)", num_rows, seconds, table);
+    }
+
+    std::vector<int> ids(num_rows);
+    std::vector<int> ages(num_rows);
+    std::vector<double> revenues(num_rows);
+    for (std::size_t i = 0; i < num_rows; ++i) {
+        ids[i] = static_cast<int>(i);
+        ages[i] = static_cast<int>(i % 100);
+        revenues[i] = static_cast<double>(i);
+    }
+
+    {
+        InsertTable table{};
+        const double seconds = measureSeconds([&]() {
+            table.insertRanges(ids, ages, revenues);
+        });
+        report("insertRanges", num_rows, seconds, table);
+    }
+
+    {
+        constexpr std::size_t CHUNK_SIZE = 1000;
+        InsertTable chunk{};
+        chunk.insertRanges(
+            std::vector<int>(ids.begin(), ids.begin() + std::min(CHUNK_SIZE, num_rows)),
+            std::vector<int>(ages.begin(), ages.begin() + std::min(CHUNK_SIZE, num_rows)),
+            std::vector<double>(revenues.begin(), revenues.begin() + std::min(CHUNK_SIZE, num_rows))
+        );
+        InsertTable table{};
+        const double seconds = measureSeconds([&]() {
+            for (std::size_t i = 0; i + CHUNK_SIZE <= num_rows; i += CHUNK_SIZE) {
+                table.append(chunk);
+            }
+        });
+        report("append (chunks of 1000)", num_rows - num_rows % CHUNK_SIZE, seconds, table);
+    }
+}
@@ -0,0 +1,101 @@
+// Copyright 2022 Andi Hellmund
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <data_crunching/dataframe.hpp>
+
+using namespace dacr;
+
+// Compares the single-threaded hash join with the radix-partitioned join.
+//
+// Usage: benchmark_join [rows ...]
+//
+// For each row count n, a fact table with n rows is joined with a dimension
+// table of n / 4 rows on a 64-bit key. The default row counts are 1M, 10M and 100M.
+
+using FactTable = DataFrame<
+    Column<"id", std::int64_t>,
+    Column<"amount", double>
+>;
+
+using DimensionTable = DataFrame<
+    Column<"id", std::int64_t>,
+    Column<"category", int>
+>;
+
+template <typename Func>
+double measureSeconds (Func&& function) {
+    const auto start = std::chrono::steady_clock::now();
+    function();
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+void runBenchmark (std::size_t num_rows) {
+    const std::size_t num_dimension_rows = std::max(num_rows / 4, std::size_t{1});
+    std::mt19937_64 generator{42};
+    std::uniform_int_distribution<std::int64_t> key_distribution(0, static_cast<std::int64_t>(num_dimension_rows) - 1);
+
+    FactTable facts{};
+    std::vector<std::int64_t> fact_ids(num_rows);
+    std::vector<double> fact_amounts(num_rows);
+    for (std::size_t i = 0; i < num_rows; ++i) {
+        fact_ids[i] = key_distribution(generator);
+        fact_amounts[i] = static_cast<double>(i);
+    }
+    facts.insertRanges(fact_ids, fact_amounts);
+
+    DimensionTable dimensions{};
+    std::vector<std::int64_t> dimension_ids(num_dimension_rows);
+    std::vector<int> dimension_categories(num_dimension_rows);
+    for (std::size_t i = 0; i < num_dimension_rows; ++i) {
+        dimension_ids[i] = static_cast<std::int64_t>(i);
+        dimension_categories[i] = static_cast<int>(i % 100);
+    }
+    dimensions.insertRanges(dimension_ids, dimension_categories);
+
+    std::size_t result_size_hash {0};
+    const double seconds_hash = measureSeconds([&]() {
+        result_size_hash = facts.join<Join::Inner, "id">(dimensions).getSize();
+    });
+    std::size_t result_size_partitioned {0};
+    const double seconds_partitioned = measureSeconds([&]() {
+        result_size_partitioned = facts.join<Join::Inner, "id">(dimensions, PartitionedHashJoin{}).getSize();
+    });
+
+    std::cout << "rows: " << num_rows
+        << ", hash join: " << seconds_hash << "s"
+        << ", partitioned hash join (" << internal::getNumberOfThreads(0) << " threads): " << seconds_partitioned << "s"
+        << ", speedup: " << seconds_hash / seconds_partitioned
+        << (result_size_hash == result_size_partitioned ? "" : " (result size mismatch)") << "\n";
+}
+
+int main (int argc, char* argv[]) {
+    std::vector<std::size_t> row_counts {1'000'000, 10'000'000, 100'000'000};
+    if (argc > 1) {
+        row_counts.clear();
+        for (int i = 1; i < argc; ++i) {
+            row_counts.push_back(std::stoul(argv[i]));
+        }
+    }
+    for (auto num_rows : row_counts) {
+        runBenchmark(num_rows);
+    }
+}
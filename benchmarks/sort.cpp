@@ -0,0 +1,90 @@
+// Copyright 2022 Andi Hellmund
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <data_crunching/dataframe.hpp>
+
+using namespace dacr;
+
+// Compares the sequential sort with the parallel multi-way merge sort.
+//
+// Usage: benchmark_sort [rows [max_threads]]
+//
+// A DataFrame with a string and an integer key is sorted by both keys with
+// 1, 2, 4, ... up to max_threads threads. The default is 10M rows and the
+// number of hardware threads.
+
+using SortTable = DataFrame<
+    Column<"city", std::string>,
+    Column<"age", int>,
+    Column<"revenue", double>
+>;
+
+template <typename Func>
+double measureSeconds (Func&& function) {
+    const auto start = std::chrono::steady_clock::now();
+    function();
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+SortTable createTable (std::size_t num_rows) {
+    std::mt19937_64 generator{42};
+    std::uniform_int_distribution<int> city_distribution(0, 9999);
+    std::uniform_int_distribution<int> age_distribution(0, 99);
+
+    std::vector<std::string> cities(num_rows);
+    std::vector<int> ages(num_rows);
+    std::vector<double> revenues(num_rows);
+    for (std::size_t i = 0; i < num_rows; ++i) {
+        cities[i] = "city_" + std::to_string(city_distribution(generator));
+        ages[i] = age_distribution(generator);
+        revenues[i] = static_cast<double>(i);
+    }
+    SortTable table{};
+    table.insertRanges(cities, ages, revenues);
+    return table;
+}
+
+int main (int argc, char* argv[]) {
+    const std::size_t num_rows = argc > 1 ? std::stoul(argv[1]) : 10'000'000;
+    const std::size_t max_threads = argc > 2 ? std::stoul(argv[2]) : internal::getNumberOfThreads(0);
+
+    auto table = createTable(num_rows);
+
+    std::size_t result_size {0};
+    const double seconds_sequential = measureSeconds([&]() {
+        result_size = table.sort<SortOrder::Ascending, "city", "age">().getSize();
+    });
+    std::cout << "rows: " << num_rows << ", sequential sort: " << seconds_sequential << "s\n";
+
+    for (std::size_t num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+        const double seconds_parallel = measureSeconds([&]() {
+            result_size = table.sort<SortOrder::Ascending, "city", "age">(ParallelPolicy{num_threads}).getSize();
+        });
+        std::cout << "rows: " << num_rows
+            << ", parallel sort (" << num_threads << " threads): " << seconds_parallel << "s"
+            << ", speedup: " << seconds_sequential / seconds_parallel
+            << (result_size == num_rows ? "" : " (result size mismatch)") << "\n";
+        if (num_threads < max_threads && num_threads * 2 > max_threads) {
+            num_threads = max_threads / 2;
+        }
+    }
+}
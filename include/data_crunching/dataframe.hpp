@@ -16,13 +16,24 @@
 #define DATA_CRUNCHING_DATAFRAME_HPP
 
 #include <ranges>
+#include <stdexcept>
 #include <vector>
 #include <iostream>
 
+#include "data_crunching/internal/categorical.hpp"
+#include "data_crunching/internal/dataframe_expression.hpp"
 #include "data_crunching/internal/dataframe_general.hpp"
+#include "data_crunching/internal/dataframe_join.hpp"
+#include "data_crunching/internal/dataframe_lazy.hpp"
 #include "data_crunching/internal/dataframe_print.hpp"
+#include "data_crunching/internal/dataframe_query.hpp"
 #include "data_crunching/internal/dataframe_sort.hpp"
 #include "data_crunching/internal/dataframe_summarize.hpp"
+#include "data_crunching/internal/dataframe_view.hpp"
+#include "data_crunching/internal/growth_policy.hpp"
+#include "data_crunching/internal/memory_resource.hpp"
+#include "data_crunching/internal/parallel.hpp"
+#include "data_crunching/internal/shared_column.hpp"
 #include "data_crunching/internal/column.hpp"
 #include "data_crunching/internal/name_list.hpp"
 #include "data_crunching/internal/type_list.hpp"
@@ -43,8 +54,24 @@ public:
     )
     friend class DataFrame;
 
+    template <typename, typename ...>
+    friend class LazyFrame;
+
+    template <internal::IsColumn ...OtherColumns>
+    friend class DataFrameView;
+
     DataFrame() = default;
 
+    /**
+     * Creates a DataFrame allocating its columns from the given memory resource (which must outlive the DataFrame).
+     * The DataFrames created by select, apply, query, join, sort and gather use the same memory resource.
+    */
+    explicit DataFrame (MemoryResource* memory_resource) : memory_resource_{memory_resource} {
+        std::apply([memory_resource](auto& ...columns) {
+            ((columns = std::remove_cvref_t<decltype(columns)>{memory_resource}), ...);
+        }, column_store_data_);
+    }
+
     // ############################################################################
     // API: Column Details
     // ############################################################################
@@ -75,7 +102,7 @@ public:
     void insert (TypesToInsert&& ...values) {
         // this step is necessary to guarantee exception-saftey to at least keep the state of the column store
         // as before the call
-        assureSufficientCapacityInColumnStore(1, IndicesForColumnStore{});
+        assureSufficientCapacityInColumnStore(1, false, IndicesForColumnStore{});
         insertImpl<TypesToInsert...>(std::forward<TypesToInsert>(values)..., IndicesForColumnStore{});
     }
 
@@ -89,7 +116,7 @@ public:
     )
     std::size_t insertRanges (Ranges&& ...ranges) {
         const std::size_t min_size = internal::getMinSizeFromRanges(std::forward<Ranges>(ranges)...);
-        assureSufficientCapacityInColumnStore(min_size, IndicesForColumnStore{});
+        assureSufficientCapacityInColumnStore(min_size, true, IndicesForColumnStore{});
         internal::insertRangesIntoContainers(column_store_data_, IndicesForColumnStore{}, min_size, std::forward<Ranges>(ranges)...);
         return min_size;
     }
@@ -98,13 +125,66 @@ public:
     // API: Append
     // ############################################################################
     void append (const DataFrame& df) {
-        assureSufficientCapacityInColumnStore(df.getSize(), IndicesForColumnStore{});
+        assureSufficientCapacityInColumnStore(df.getSize(), true, IndicesForColumnStore{});
         appendImpl(df, IndicesForColumnStore{});
     }
 
+    // ############################################################################
+    // API: Capacity
+    // ############################################################################
+    /**
+     * Returns the number of rows the DataFrame can hold without reallocating any column.
+    */
+    std::size_t getCapacity () const {
+        return getCapacityImpl(IndicesForColumnStore{});
+    }
+
+    /**
+     * Reserves the capacity for at least the given number of rows in all columns.
+    */
+    void reserve (std::size_t num_rows) {
+        reserveImpl(num_rows, IndicesForColumnStore{});
+    }
+
+    /**
+     * Releases the unused capacity of all columns (columns shared with other DataFrames are kept as is).
+    */
+    void shrinkToFit () {
+        shrinkToFitImpl(IndicesForColumnStore{});
+    }
+
+    /**
+     * Removes all rows keeping the capacity of the columns (columns shared with other DataFrames are released).
+    */
+    void clear () {
+        clearImpl(IndicesForColumnStore{});
+    }
+
+    const GrowthPolicy& getGrowthPolicy () const {
+        return growth_policy_;
+    }
+
+    void setGrowthPolicy (GrowthPolicy growth_policy) {
+        if (not (growth_policy.factor > 1.0)) {
+            throw std::invalid_argument("growth factor must be larger than one");
+        }
+        growth_policy_ = growth_policy;
+    }
+
+    // ############################################################################
+    // API: Memory Resource
+    // ############################################################################
+    MemoryResource* getMemoryResource () const {
+        return memory_resource_;
+    }
+
     // ############################################################################
     // API: Column (Read) Access
     // ############################################################################
+    /**
+     * Returns the column itself (not its copy-on-write buffer), such that the reference stays valid
+     * and reflects later modifications of this DataFrame.
+    */
     template <FixedString ColumnName>
     requires (internal::is_name_in_columns<ColumnName, Columns...>)
     const auto& getColumn () const {
@@ -132,6 +212,25 @@ public:
         }
     }
 
+    // ############################################################################
+    // API: View
+    // ############################################################################
+    /**
+     * Returns a non-owning view of the selected columns without copying them (in contrast to select).
+     * The view is invalidated by any modification of this DataFrame.
+    */
+    template <FixedString ...ColumnNames>
+    requires (
+        sizeof...(ColumnNames) > 0 &&
+        internal::are_names_unique<internal::NameList<ColumnNames...>> &&
+        internal::are_names_in_columns<internal::NameList<ColumnNames...>, Columns...>
+    )
+    auto view () const {
+        using NewDataFrameView = typename internal::GetDataFrameWithColumnsByName<internal::NameList<ColumnNames...>, Columns...>::ColumnSpecs::template To<DataFrameView>;
+        using SelectedColumnIndices = internal::GetColumnIndicesByNames<internal::NameList<ColumnNames...>, Columns...>;
+        return viewImpl<NewDataFrameView>(SelectedColumnIndices{});
+    }
+
     // ############################################################################
     // API: Apply
     // ############################################################################
@@ -144,12 +243,11 @@ public:
         if constexpr (sizeof...(Columns) > 0) {
             using SelectedNamesForApply = internal::GetSelectNameList<SelectNames, Columns...>;
             using SelectedColumnIndices = internal::GetColumnIndicesByNames<SelectedNamesForApply, Columns...>;
-            using SelectedTypesForFunc = internal::GetColumnTypesByNames<SelectedNamesForApply, Columns...>;
-            using NamedTupleForFuncArgs = internal::ConstructNamedTuple<SelectedNamesForApply, SelectedTypesForFunc>;
-            using FuncReturnType = std::invoke_result_t<Func, NamedTupleForFuncArgs>;
+            using RowViewForFunc = internal::RowView<ColumnStoreDataType, SelectedNamesForApply, SelectedColumnIndices>;
+            using FuncReturnType = std::invoke_result_t<Func, RowViewForFunc>;
             using NewDataFrame = internal::ConstructDataFrameForApply<SelectedNamesForApply, NewColumnName, FuncReturnType, Columns...>;
             
-            return applyImpl<NewDataFrame, NamedTupleForFuncArgs, SelectedNamesForApply::getSize()>(
+            return applyImpl<NewDataFrame, RowViewForFunc, SelectedNamesForApply::getSize()>(
                 std::forward<Func>(function),
                 SelectedColumnIndices{}
             );
@@ -159,61 +257,158 @@ public:
         }
     }
 
+    /**
+     * Parallel apply: the function is invoked for morsels of rows on multiple threads and the values
+     * of the new column are stitched together in the original row order. The function must be safe to
+     * invoke concurrently (e.g. free of side-effects), the order of the invocations is unspecified.
+    */
+    template <FixedString NewColumnName, typename SelectNames = SelectAll, typename Func>
+    requires (
+        NewColumnName.getLength() > 0 &&
+        internal::is_valid_select<SelectNames, Columns...>
+    )
+    auto apply (Func&& function, ParallelPolicy policy) {
+        if constexpr (sizeof...(Columns) > 0) {
+            using SelectedNamesForApply = internal::GetSelectNameList<SelectNames, Columns...>;
+            using SelectedColumnIndices = internal::GetColumnIndicesByNames<SelectedNamesForApply, Columns...>;
+            using RowViewForFunc = internal::RowView<ColumnStoreDataType, SelectedNamesForApply, SelectedColumnIndices>;
+            using FuncReturnType = std::invoke_result_t<Func, RowViewForFunc>;
+            using NewDataFrame = internal::ConstructDataFrameForApply<SelectedNamesForApply, NewColumnName, FuncReturnType, Columns...>;
+
+            return applyParallelImpl<NewDataFrame, RowViewForFunc, SelectedNamesForApply::getSize()>(
+                std::forward<Func>(function),
+                policy,
+                SelectedColumnIndices{}
+            );
+        }
+        else {
+            return DataFrame{};
+        }
+    }
+
     // ############################################################################
     // API: Query
     // ############################################################################
     template <typename SelectNames = SelectAll, typename Func>
-    requires (internal::is_valid_select<SelectNames, Columns...>)
+    requires (internal::is_valid_select<SelectNames, Columns...> && not internal::IsExpression<Func>)
     auto query (Func&& function) {
         if constexpr (sizeof...(Columns) > 0) {
-            using SelectedNamesForApply = internal::GetSelectNameList<SelectNames, Columns...>;
-            using SelectedColumnIndices = internal::GetColumnIndicesByNames<SelectedNamesForApply, Columns...>;
-            using SelectedTypesForFunc = internal::GetColumnTypesByNames<SelectedNamesForApply, Columns...>;
-            using NamedTupleForFuncArgs = internal::ConstructNamedTuple<SelectedNamesForApply, SelectedTypesForFunc>;
-            using FuncReturnType = std::invoke_result_t<Func, NamedTupleForFuncArgs>;
-            static_assert(std::is_same_v<FuncReturnType, bool>, "Callback return type for query() must be bool");
+            return gather(querySelection<SelectNames>(std::forward<Func>(function)));
+        }
+        else {
+            return DataFrame{};
+        }
+    }
 
-            return queryImpl<NamedTupleForFuncArgs>(std::forward<Func>(function), SelectedColumnIndices{}, IndicesForColumnStore{});
+    /**
+     * Parallel query: the function is evaluated for morsels of rows on multiple threads (see parallel apply)
+     * and the selected rows are copied column by column in parallel.
+    */
+    template <typename SelectNames = SelectAll, typename Func>
+    requires (internal::is_valid_select<SelectNames, Columns...> && not internal::IsExpression<Func>)
+    auto query (Func&& function, ParallelPolicy policy) {
+        if constexpr (sizeof...(Columns) > 0) {
+            return gather(querySelection<SelectNames>(std::forward<Func>(function), policy).getRowIndices(), policy);
         }
         else {
             return DataFrame{};
         }
     }
 
+    /**
+     * Returns the selection of rows for which the function returns true without copying any row.
+     * The selected rows are materialized with gather(selection).
+    */
+    template <typename SelectNames = SelectAll, typename Func>
+    requires (internal::is_valid_select<SelectNames, Columns...> && not internal::IsExpression<Func>)
+    Selection querySelection (Func&& function) const {
+        return internal::selectRows(getSize(), createRowPredicate<SelectNames>(std::forward<Func>(function)));
+    }
+
+    template <typename SelectNames = SelectAll, typename Func>
+    requires (internal::is_valid_select<SelectNames, Columns...> && not internal::IsExpression<Func>)
+    Selection querySelection (Func&& function, ParallelPolicy policy) const {
+        return internal::selectRowsParallel(getSize(), internal::getNumberOfThreads(policy.num_threads), createRowPredicate<SelectNames>(std::forward<Func>(function)));
+    }
+
+    /**
+     * Returns the subset of the selection for which the function returns true, i.e. the function is
+     * only invoked for the rows in the selection.
+    */
+    template <typename SelectNames = SelectAll, typename Func>
+    requires (internal::is_valid_select<SelectNames, Columns...> && not internal::IsExpression<Func>)
+    Selection querySelection (Func&& function, const Selection& selection) const {
+        assureSelectionMatchesSize(selection);
+        return internal::selectRows(selection, createRowPredicate<SelectNames>(std::forward<Func>(function)));
+    }
+
+    /**
+     * Returns the rows satisfying the predicate expression, e.g. col<"age"> > 30 && col<"city"> == "Berlin".
+     * The expression is evaluated column-at-a-time into a mask before the selected rows are copied.
+    */
+    template <internal::IsExpression Expr>
+    requires (internal::is_valid_expression<Expr, Columns...>)
+    DataFrame query (const Expr& expression) const {
+        return gather(querySelection(expression));
+    }
+
+    template <internal::IsExpression Expr>
+    requires (internal::is_valid_expression<Expr, Columns...>)
+    Selection querySelection (const Expr& expression) const {
+        return internal::toSelection(internal::evaluateExpression(expression, column_store_data_, getSize(), TypeList<Columns...>{}));
+    }
+
+    template <internal::IsExpression Expr>
+    requires (internal::is_valid_expression<Expr, Columns...>)
+    Selection querySelection (const Expr& expression, const Selection& selection) const {
+        assureSelectionMatchesSize(selection);
+        return internal::toSelection(internal::evaluateExpression(expression, column_store_data_, getSize(), TypeList<Columns...>{}), selection);
+    }
+
     // ############################################################################
     // API: Join
     // ############################################################################
-    template <Join JoinType, FixedString ...JoinNames, typename ...OtherColumns>
-    requires (sizeof...(JoinNames) > 0 &&
-        internal::are_names_unique<internal::NameList<JoinNames...>> &&
-        internal::are_names_in_columns<internal::NameList<JoinNames...>, Columns...> &&
-        internal::are_names_in_columns<internal::NameList<JoinNames...>, Columns...> &&
-        internal::are_names_unique<
-            internal::NameListMerge<
-                internal::NameListDifference<internal::GetColumnNames<Columns...>, internal::NameList<JoinNames...>>,
-                internal::NameListDifference<internal::GetColumnNames<OtherColumns...>, internal::NameList<JoinNames...>>
-            >
-        > &&
-        internal::are_columns_the_same_in_two_lists_by_names<internal::NameList<JoinNames...>, TypeList<Columns...>, TypeList<OtherColumns...>>
-    )
-    auto join (const DataFrame<OtherColumns...>& df) {
+    template <Join JoinType, FixedString ...JoinNames, typename ...OtherColumns, internal::IsJoinStrategy Strategy = HashJoin>
+    requires (internal::is_valid_join<internal::NameList<JoinNames...>, TypeList<Columns...>, TypeList<OtherColumns...>>)
+    auto join (const DataFrame<OtherColumns...>& df, Strategy strategy = {}) {
         if constexpr (sizeof...(Columns) > 0) {
-            // compute all the indices
-            using JoinIndicesSelf = internal::GetColumnIndicesByNames<internal::NameList<JoinNames...>, Columns...>;
-            using JoinIndicesOther = internal::GetColumnIndicesByNames<internal::NameList<JoinNames...>, OtherColumns...>;
-            using ColumnNamesToCopyOther = internal::NameListDifference<internal::GetColumnNames<OtherColumns...>, internal::NameList<JoinNames...>>;
-            using DataIndicesToCopyOther = internal::GetColumnIndicesByNames<ColumnNamesToCopyOther, OtherColumns...>;
-
-            using DataIndicesInResultOther = internal::IntegerSequenceByRange<sizeof...(Columns), sizeof...(Columns) + sizeof...(OtherColumns) - sizeof...(JoinNames)>;
-            using JoinedDataFrame = internal::DataFrameMerge<DataFrame, internal::GetDataFrameWithColumnsByName<ColumnNamesToCopyOther, OtherColumns...>>;
-            
-            return joinImpl<JoinType, JoinedDataFrame, JoinIndicesSelf, JoinIndicesOther, DataIndicesInResultOther, DataIndicesToCopyOther>(df);
+            return joinColumnStores<JoinType, JoinNames...>(column_store_data_, getSize(), df.column_store_data_, df.getSize(), TypeList<OtherColumns...>{}, strategy, memory_resource_);
         }
         else {
             return DataFrame{};
         }
     }
 
+    /**
+     * Joins the DataFrames and keeps the joined rows satisfying the filter expression.
+     *
+     * The top-level conjunctions of the filter are pushed down: conjunctions referencing only the columns
+     * of one side are evaluated on this side before joining (unless the join keeps unmatched rows of the
+     * other side), the remaining conjunctions are evaluated on the joined DataFrame. The filter of semi
+     * and anti joins must not reference both left and right non-join columns in one conjunction.
+    */
+    template <Join JoinType, FixedString ...JoinNames, typename ...OtherColumns, internal::IsExpression Expr, internal::IsJoinStrategy Strategy = HashJoin>
+    requires (
+        internal::is_valid_join<internal::NameList<JoinNames...>, TypeList<Columns...>, TypeList<OtherColumns...>> &&
+        internal::is_valid_join_filter<JoinType, internal::NameList<JoinNames...>, internal::GetColumnNames<Columns...>, internal::GetColumnNames<OtherColumns...>, Expr>
+    )
+    auto join (const DataFrame<OtherColumns...>& df, const Expr& filter, Strategy strategy = {}) {
+        using Pushdown = internal::JoinPushdown<JoinType, internal::NameList<JoinNames...>, internal::GetColumnNames<Columns...>, internal::GetColumnNames<OtherColumns...>>;
+        const auto conjunctions = internal::splitConjunctions(filter);
+        const auto filter_self = internal::combineConjunctions(internal::filterConjunctions<typename Pushdown::Left>(conjunctions));
+        const auto filter_other = internal::combineConjunctions(internal::filterConjunctions<typename Pushdown::Right>(conjunctions));
+        const auto filter_joined = internal::combineConjunctions(internal::filterConjunctions<typename Pushdown::Residual>(conjunctions));
+
+        auto&& self = internal::queryUnlessTautology(*this, filter_self);
+        auto joined = self.template join<JoinType, JoinNames...>(internal::queryUnlessTautology(df, filter_other), strategy);
+        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(filter_joined)>, internal::Tautology>) {
+            return joined;
+        }
+        else {
+            return joined.query(filter_joined);
+        }
+    }
+
     // ############################################################################
     // API: Summarize
     // ############################################################################
@@ -222,33 +417,30 @@ public:
     // ToDo group-by names are not part of summarize-ops
     auto summarize () {
         if constexpr (sizeof...(Columns) > 0) {
-            if constexpr (GroupBy::NumColumns == 0) {
-                using CompoundSummarizer = internal::GetCompoundSummarizer<TypeList<Ops...>, Columns...>;
-                using NewDataFrame = typename internal::GetNewColumnsForOps<TypeList<Ops...>, Columns...>::template To<DataFrame>;
-                
-                using Executer = internal::SummarizationExecuterNoGroupBy<NewDataFrame, CompoundSummarizer>;
-                Executer executer{};
-                for (std::size_t loop_index = 0; loop_index < getSize(); ++loop_index) {
-                    executer.summarize(column_store_data_, loop_index);
-                }
-                return executer.constructResult();
-            }
-            else {
-                using GroupByIndices = internal::GetColumnIndicesByNames<typename GroupBy::Names, Columns...>;
-                using GroupByTypes = typename internal::GetColumnTypesByNames<typename GroupBy::Names, Columns...>::template To<std::tuple>;
-
-                using CompoundSummarizer = internal::GetCompoundSummarizer<TypeList<Ops...>, Columns...>;
-                using DataFrameGroupBy = internal::GetDataFrameWithColumnsByName<typename GroupBy::Names, Columns...>;
-                using DataFrameOps = typename internal::GetNewColumnsForOps<TypeList<Ops...>, Columns...>::template To<DataFrame>;
-                using NewDataFrame = internal::DataFrameMerge<DataFrameGroupBy, DataFrameOps>;
-                
-                using Executer = internal::SummarizationExecuterGroupBy<NewDataFrame, GroupByIndices, GroupByTypes, CompoundSummarizer>;
-                Executer executer{};
-                for (std::size_t loop_index = 0; loop_index < getSize(); ++loop_index) {
-                    executer.summarize(column_store_data_, loop_index);
-                }
-                return executer.constructResult();
+            auto executer = createSummarizationExecuter<GroupBy, Ops...>();
+            executer.summarizeRange(column_store_data_, 0, getSize());
+            return executer.constructResult();
+        }
+        else {
+            return DataFrame{};
+        }
+    }
+
+    template <internal::IsGroupBySpec GroupBy, internal::IsSummarizeOp ...Ops>
+    requires (internal::are_valid_summarize_ops<TypeList<Ops...>, Columns...>)
+    auto summarize (ParallelPolicy policy) {
+        if constexpr (sizeof...(Columns) > 0) {
+            using Executer = decltype(createSummarizationExecuter<GroupBy, Ops...>());
+            const std::size_t num_chunks = std::max(std::min(internal::getNumberOfThreads(policy.num_threads), getSize()), std::size_t{1});
+            std::vector<Executer> executers(num_chunks);
+            internal::parallelFor(num_chunks, num_chunks, [&](std::size_t chunk_index) {
+                const auto [begin, end] = internal::getChunkRange(getSize(), num_chunks, chunk_index);
+                executers[chunk_index].summarizeRange(column_store_data_, begin, end);
+            });
+            for (std::size_t chunk_index = 1; chunk_index < num_chunks; ++chunk_index) {
+                executers[0].merge(executers[chunk_index]);
             }
+            return executers[0].constructResult();
         }
         else {
             return DataFrame{};
@@ -265,30 +457,163 @@ public:
         internal::are_names_in_columns<internal::NameList<SortByNames...>, Columns...>
     )
     auto sort () {
-        if constexpr (sizeof...(Columns) > 0) {
-            using ColumnIndices = internal::GetColumnIndicesByNames<internal::NameList<SortByNames...>, Columns...>;
-            using ElementComparison = internal::ConstructElementComparison<Order, ColumnIndices>;
-            using ColumnStoreElementComparison = internal::ColumnStoreRowComparisonProxy<ColumnStoreDataType, ElementComparison>;
-
-            std::vector<ColumnStoreElementComparison> row_comparison_proxy {};
-            row_comparison_proxy.reserve(getSize());
-            for (std::size_t i = 0; i < getSize(); ++i) {
-                row_comparison_proxy.push_back({column_store_data_, i});
-            }
-            std::sort(row_comparison_proxy.begin(), row_comparison_proxy.end());
+        return sortImpl<SortKeysForNames<Order, SortByNames...>, false>();
+    }
 
-            DataFrame result{};
-            result.assureSufficientCapacityInColumnStore(getSize(), IndicesForColumnStore{});
-            for (const auto& order : row_comparison_proxy) {
-                sortByImpl(result, order.getIndex(), IndicesForColumnStore{});
-            }
-            return result;
-        }
-        else {
-            return DataFrame{};
+    /**
+     * Sorts the DataFrame with an individual sort order per column, e.g. sort<Asc<"a">, Desc<"b">>().
+    */
+    template <typename ...SortKeySpecs>
+    requires (internal::is_valid_sort_key_spec_list<TypeList<SortKeySpecs...>, Columns...>)
+    auto sort () {
+        return sortImpl<SortKeysForSpecs<SortKeySpecs...>, false>();
+    }
+
+    /**
+     * Sorts the DataFrame such that rows comparing equal keep their original order.
+    */
+    template <SortOrder Order, FixedString ...SortByNames>
+    requires (
+        sizeof...(SortByNames) > 0 &&
+        internal::are_names_unique<internal::NameList<SortByNames...>> &&
+        internal::are_names_in_columns<internal::NameList<SortByNames...>, Columns...>
+    )
+    auto stableSort () {
+        return sortImpl<SortKeysForNames<Order, SortByNames...>, true>();
+    }
+
+    template <typename ...SortKeySpecs>
+    requires (internal::is_valid_sort_key_spec_list<TypeList<SortKeySpecs...>, Columns...>)
+    auto stableSort () {
+        return sortImpl<SortKeysForSpecs<SortKeySpecs...>, true>();
+    }
+
+    /**
+     * Sorts the DataFrame with a parallel multi-way merge sort on the threads of the policy.
+     * In contrast to the sequential sort, rows comparing equal keep their original order.
+    */
+    template <SortOrder Order, FixedString ...SortByNames>
+    requires (
+        sizeof...(SortByNames) > 0 &&
+        internal::are_names_unique<internal::NameList<SortByNames...>> &&
+        internal::are_names_in_columns<internal::NameList<SortByNames...>, Columns...>
+    )
+    auto sort (ParallelPolicy policy) {
+        return sortParallelImpl<SortKeysForNames<Order, SortByNames...>>(policy);
+    }
+
+    template <typename ...SortKeySpecs>
+    requires (internal::is_valid_sort_key_spec_list<TypeList<SortKeySpecs...>, Columns...>)
+    auto sort (ParallelPolicy policy) {
+        return sortParallelImpl<SortKeysForSpecs<SortKeySpecs...>>(policy);
+    }
+
+    /**
+     * Returns the first k rows of the sorted DataFrame (or all rows if k >= getSize()) without sorting
+     * the complete DataFrame. Rows comparing equal keep their original order.
+    */
+    template <SortOrder Order, FixedString ...SortByNames>
+    requires (
+        sizeof...(SortByNames) > 0 &&
+        internal::are_names_unique<internal::NameList<SortByNames...>> &&
+        internal::are_names_in_columns<internal::NameList<SortByNames...>, Columns...>
+    )
+    auto topN (std::size_t k) {
+        return topNImpl<SortKeysForNames<Order, SortByNames...>>(k);
+    }
+
+    template <typename ...SortKeySpecs>
+    requires (internal::is_valid_sort_key_spec_list<TypeList<SortKeySpecs...>, Columns...>)
+    auto topN (std::size_t k) {
+        return topNImpl<SortKeysForSpecs<SortKeySpecs...>>(k);
+    }
+
+    /**
+     * Returns the permutation of row indices which sorts the DataFrame, i.e. the i-th row of
+     * the sorted DataFrame is the row argsort()[i] of this DataFrame.
+    */
+    template <SortOrder Order, FixedString ...SortByNames>
+    requires (
+        sizeof...(SortByNames) > 0 &&
+        internal::are_names_unique<internal::NameList<SortByNames...>> &&
+        internal::are_names_in_columns<internal::NameList<SortByNames...>, Columns...>
+    )
+    std::vector<std::size_t> argsort () const {
+        return argsortImpl<SortKeysForNames<Order, SortByNames...>, false>();
+    }
+
+    template <typename ...SortKeySpecs>
+    requires (internal::is_valid_sort_key_spec_list<TypeList<SortKeySpecs...>, Columns...>)
+    std::vector<std::size_t> argsort () const {
+        return argsortImpl<SortKeysForSpecs<SortKeySpecs...>, false>();
+    }
+
+    template <SortOrder Order, FixedString ...SortByNames>
+    requires (
+        sizeof...(SortByNames) > 0 &&
+        internal::are_names_unique<internal::NameList<SortByNames...>> &&
+        internal::are_names_in_columns<internal::NameList<SortByNames...>, Columns...>
+    )
+    std::vector<std::size_t> argsort (ParallelPolicy policy) const {
+        return argsortParallelImpl<SortKeysForNames<Order, SortByNames...>>(policy);
+    }
+
+    template <typename ...SortKeySpecs>
+    requires (internal::is_valid_sort_key_spec_list<TypeList<SortKeySpecs...>, Columns...>)
+    std::vector<std::size_t> argsort (ParallelPolicy policy) const {
+        return argsortParallelImpl<SortKeysForSpecs<SortKeySpecs...>>(policy);
+    }
+
+    // ############################################################################
+    // API: Gather
+    // ############################################################################
+    /**
+     * Returns a new DataFrame with the rows at the given row indices (in the given order).
+     * The columns are copied one after another. All row indices must be smaller than getSize().
+    */
+    DataFrame gather (const std::vector<std::size_t>& row_indices) const {
+        DataFrame result{memory_resource_};
+        gatherImpl(result, row_indices, IndicesForColumnStore{});
+        return result;
+    }
+
+    /**
+     * Returns a new DataFrame with the selected rows. If all rows are selected, the new DataFrame
+     * shares the columns with this DataFrame (copy-on-write).
+    */
+    DataFrame gather (const Selection& selection) const {
+        assureSelectionMatchesSize(selection);
+        if (selection.getSize() == getSize()) {
+            return *this;
         }
+        return gather(selection.getRowIndices());
+    }
+
+    /**
+     * Gathers the columns in parallel, one column per task.
+    */
+    DataFrame gather (const std::vector<std::size_t>& row_indices, ParallelPolicy policy) const {
+        DataFrame result{memory_resource_};
+        internal::parallelFor(sizeof...(Columns), internal::getNumberOfThreads(policy.num_threads), [&](std::size_t column_index) {
+            gatherColumnImpl(result, row_indices, column_index, IndicesForColumnStore{});
+        });
+        return result;
+    }
+
+    // ############################################################################
+    // API: Lazy
+    // ############################################################################
+    /**
+     * Returns a LazyFrame recording select, query, apply and sort operations on this DataFrame.
+     * The operations are executed by LazyFrame::collect(). The DataFrame must outlive the LazyFrame,
+     * hence a LazyFrame cannot be created from a temporary DataFrame.
+    */
+    LazyFrame<DataFrame> lazy () const& {
+        return LazyFrame<DataFrame>{*this};
     }
 
+    LazyFrame<DataFrame> lazy () const&& = delete;
+
     // ############################################################################
     // API: Print
     // ############################################################################
@@ -311,20 +636,56 @@ public:
     }
 
 private:
-    using ColumnStoreDataType = internal::ConstructColumnStoreDataType<std::vector, Columns...>;
+    using ColumnStoreDataType = internal::ConstructColumnStoreDataType<internal::SharedColumn, Columns...>;
     using IndicesForColumnStore = std::index_sequence_for<Columns...>;
 
+    /**
+     * Grows the columns that cannot take amount_to_insert further rows without reallocating (or that are shared
+     * and thus need to be copied before writing). Scalar insertions grow by the growth policy, bulk insertions
+     * reserve the exact size if it exceeds the geometric growth (or if the column has no capacity yet).
+    */
     template <std::size_t ...Indices>
-    void assureSufficientCapacityInColumnStore (std::size_t amount_to_insert, std::integer_sequence<std::size_t, Indices...>) {
-        if constexpr (sizeof...(Columns) > 0) {
-            const auto& first_column_data = std::get<0>(column_store_data_);
-            if (first_column_data.size() + amount_to_insert >= first_column_data.capacity()) {
-                const std::size_t new_capacity = first_column_data.capacity() * 1.50;
-                ((std::get<Indices>(column_store_data_).reserve(new_capacity)), ...);
+    void assureSufficientCapacityInColumnStore (std::size_t amount_to_insert, bool is_bulk_insertion, std::integer_sequence<std::size_t, Indices...>) {
+        const std::size_t required_capacity = getSize() + amount_to_insert;
+        auto assure_capacity = [&](auto& column) {
+            const std::size_t capacity = column.capacity();
+            if (required_capacity > capacity || column.isShared()) {
+                if (is_bulk_insertion && capacity == 0) {
+                    column.reserve(required_capacity);
+                }
+                else {
+                    column.reserve(growth_policy_.getCapacity(capacity, required_capacity));
+                }
             }
+        };
+        (assure_capacity(std::get<Indices>(column_store_data_)), ...);
+    }
+
+    template <std::size_t ...Indices>
+    std::size_t getCapacityImpl (std::integer_sequence<std::size_t, Indices...>) const {
+        if constexpr (sizeof...(Columns) > 0) {
+            return std::min({std::get<Indices>(column_store_data_).capacity()...});
+        }
+        else {
+            return 0;
         }
     }
 
+    template <std::size_t ...Indices>
+    void reserveImpl (std::size_t num_rows, std::integer_sequence<std::size_t, Indices...>) {
+        (std::get<Indices>(column_store_data_).reserve(num_rows), ...);
+    }
+
+    template <std::size_t ...Indices>
+    void shrinkToFitImpl (std::integer_sequence<std::size_t, Indices...>) {
+        (std::get<Indices>(column_store_data_).shrink_to_fit(), ...);
+    }
+
+    template <std::size_t ...Indices>
+    void clearImpl (std::integer_sequence<std::size_t, Indices...>) {
+        (std::get<Indices>(column_store_data_).clear(), ...);
+    }
+
     template <typename ...TypesToInsert, std::size_t ...Indices>
     void insertImpl (TypesToInsert&& ...values, std::integer_sequence<std::size_t, Indices...>) {
         (std::get<Indices>(column_store_data_).push_back(std::forward<TypesToInsert>(values)), ...);
@@ -332,79 +693,241 @@ private:
 
     template <typename NewDataFrame, std::size_t ...Indices>
     auto selectImpl(std::integer_sequence<std::size_t, Indices...>) {
-        NewDataFrame result;
-        result.insertRanges(std::get<Indices>(column_store_data_)...);
+        NewDataFrame result{memory_resource_};
+        result.column_store_data_ = typename NewDataFrame::ColumnStoreDataType{std::get<Indices>(column_store_data_)...};
         return result;
     }
 
+    /**
+     * Shares the columns with the given indices as the first columns of the result (copy-on-write).
+    */
+    template <typename NewDataFrame, std::size_t ...ResultIndices, std::size_t ...Indices>
+    void shareColumnsImpl (NewDataFrame& result, std::integer_sequence<std::size_t, ResultIndices...>, std::integer_sequence<std::size_t, Indices...>) const {
+        ((std::get<ResultIndices>(result.column_store_data_) = std::get<Indices>(column_store_data_)), ...);
+    }
+
+    template <typename NewDataFrameView, std::size_t ...Indices>
+    NewDataFrameView viewImpl (std::integer_sequence<std::size_t, Indices...>) const {
+        return NewDataFrameView{typename NewDataFrameView::ColumnStoreDataType{std::get<Indices>(column_store_data_).get()...}, getSize()};
+    }
+
     template <std::size_t ...Indices>
     void appendImpl (const DataFrame& df, std::integer_sequence<std::size_t, Indices...>) {
         internal::insertRangesIntoContainers(column_store_data_, IndicesForColumnStore{}, df.getSize(), std::get<Indices>(df.column_store_data_)...);
     }
 
-    template <typename NewDataFrame, typename NamedTupleForFunc, std::size_t NumSelectedNames, typename Func, std::size_t ...Indices>
+    template <typename NewDataFrame, typename RowViewForFunc, std::size_t NumSelectedNames, typename Func, std::size_t ...Indices>
     auto applyImpl (Func&& function, std::integer_sequence<std::size_t, Indices...>) {
-        NewDataFrame result;
-        result.template assureSufficientCapacityInColumnStore(getSize(), typename NewDataFrame::IndicesForColumnStore{});
-        internal::insertRangesIntoContainers(result.column_store_data_, std::make_index_sequence<NumSelectedNames>{}, getSize(), std::get<Indices>(column_store_data_)...);
-        
-        auto& result_column = std::get<NumSelectedNames>(result.column_store_data_);
-        for (int i = 0LU; i < getSize(); ++i) {
+        NewDataFrame result{memory_resource_};
+        shareColumnsImpl(result, std::make_index_sequence<NumSelectedNames>{}, std::integer_sequence<std::size_t, Indices...>{});
+
+        auto& result_column = std::get<NumSelectedNames>(result.column_store_data_).getMutable();
+        result_column.reserve(getSize());
+        for (std::size_t row_index = 0; row_index < getSize(); ++row_index) {
             result_column.push_back(
-                std::forward<Func>(function)(NamedTupleForFunc{std::get<Indices>(column_store_data_)[i]...})
+                std::forward<Func>(function)(RowViewForFunc{column_store_data_, row_index})
             );
         }
         return result;
     }
 
-    template <typename NamedTupleForFunc, typename Func, std::size_t ...IndicesForFunc, std::size_t ...IndicesForCopy>
-    auto queryImpl (Func&& function, std::integer_sequence<std::size_t, IndicesForFunc...>, std::integer_sequence<std::size_t, IndicesForCopy...>) {
-        DataFrame result;
-        for (int i = 0LU; i < getSize(); ++i) {
-            bool keep_row = std::forward<Func>(function)(NamedTupleForFunc{std::get<IndicesForFunc>(column_store_data_)[i]...});
-            if (keep_row) {
-                ((std::get<IndicesForCopy>(result.column_store_data_).push_back(
-                    std::get<IndicesForCopy>(column_store_data_)[i])),...);
+    template <typename NewDataFrame, typename RowViewForFunc, std::size_t NumSelectedNames, typename Func, std::size_t ...Indices>
+    auto applyParallelImpl (Func&& function, ParallelPolicy policy, std::integer_sequence<std::size_t, Indices...>) {
+        using ValueType = std::invoke_result_t<Func, RowViewForFunc>;
+        const std::size_t num_threads = internal::getNumberOfThreads(policy.num_threads);
+        NewDataFrame result{memory_resource_};
+        shareColumnsImpl(result, std::make_index_sequence<NumSelectedNames>{}, std::integer_sequence<std::size_t, Indices...>{});
+
+        auto& result_column = std::get<NumSelectedNames>(result.column_store_data_).getMutable();
+        if constexpr (std::is_default_constructible_v<ValueType> && not std::is_same_v<ValueType, bool>) {
+            // the morsels write into disjoint ranges of the pre-sized column
+            result_column.resize(getSize());
+            internal::parallelForMorsels(getSize(), num_threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+                for (std::size_t row_index = begin; row_index < end; ++row_index) {
+                    result_column[row_index] = function(RowViewForFunc{column_store_data_, row_index});
+                }
+            });
+        }
+        else {
+            // std::vector<bool> packs bits (no concurrent writes) and other types lack a default value
+            std::vector<std::vector<ValueType>> morsel_values(internal::getNumberOfMorsels(getSize()));
+            internal::parallelForMorsels(getSize(), num_threads, [&](std::size_t morsel_index, std::size_t begin, std::size_t end) {
+                auto& values = morsel_values[morsel_index];
+                values.reserve(end - begin);
+                for (std::size_t row_index = begin; row_index < end; ++row_index) {
+                    values.push_back(function(RowViewForFunc{column_store_data_, row_index}));
+                }
+            });
+            for (auto& values : morsel_values) {
+                result_column.insert(result_column.end(), std::make_move_iterator(values.begin()), std::make_move_iterator(values.end()));
             }
         }
         return result;
     }
 
-    template <Join JoinType, typename NewDataFrame, typename JoinIndicesSelf, typename JoinIndicesOther, typename DataIndicesInResultOther, typename DataIndicesToCopyOther, typename DataFrameOther>
-    auto joinImpl(const DataFrameOther& df) {
-        NewDataFrame result{};
-        if constexpr (JoinType == Join::Inner) {
-            for (auto i = 0LU; i < getSize(); ++i) {
-                for (auto j = 0LU; j < df.getSize(); ++j) {
-                    if (compareJoinIndices(df, i, j, JoinIndicesSelf{}, JoinIndicesOther{})) {
-                        addJoinedColumnData(result.column_store_data_, df, i, j, IndicesForColumnStore{}, DataIndicesInResultOther{}, DataIndicesToCopyOther{});
-                    }
-                }
+    template <typename SelectNames, typename Func>
+    auto createRowPredicate (Func&& function) const {
+        using SelectedNamesForQuery = internal::GetSelectNameList<SelectNames, Columns...>;
+        using SelectedColumnIndices = internal::GetColumnIndicesByNames<SelectedNamesForQuery, Columns...>;
+        using RowViewForFunc = internal::RowView<ColumnStoreDataType, SelectedNamesForQuery, SelectedColumnIndices>;
+        using FuncReturnType = std::invoke_result_t<Func, RowViewForFunc>;
+        static_assert(std::is_same_v<FuncReturnType, bool>, "Callback return type for query() must be bool");
+
+        return [this, &function](std::size_t row_index) {
+            return static_cast<bool>(function(RowViewForFunc{column_store_data_, row_index}));
+        };
+    }
+
+    void assureSelectionMatchesSize (const Selection& selection) const {
+        if (selection.getNumberOfRows() != getSize()) {
+            throw std::invalid_argument("selection does not match the number of rows of the DataFrame");
+        }
+    }
+
+    template <internal::IsGroupBySpec GroupBy, internal::IsSummarizeOp ...Ops>
+    static auto createSummarizationExecuter () {
+        using CompoundSummarizer = internal::GetCompoundSummarizer<TypeList<Ops...>, Columns...>;
+        if constexpr (GroupBy::NumColumns == 0) {
+            using NewDataFrame = typename internal::GetNewColumnsForOps<TypeList<Ops...>, Columns...>::template To<DataFrame>;
+            return internal::SummarizationExecuterNoGroupBy<NewDataFrame, CompoundSummarizer>{};
+        }
+        else {
+            using GroupByIndices = internal::GetColumnIndicesByNames<typename GroupBy::Names, Columns...>;
+            using GroupByTypes = typename internal::GetColumnTypesByNames<typename GroupBy::Names, Columns...>::template To<std::tuple>;
+            using DataFrameGroupBy = internal::GetDataFrameWithColumnsByName<typename GroupBy::Names, Columns...>;
+            using DataFrameOps = typename internal::GetNewColumnsForOps<TypeList<Ops...>, Columns...>::template To<DataFrame>;
+            using NewDataFrame = internal::DataFrameMerge<DataFrameGroupBy, DataFrameOps>;
+            return internal::SummarizationExecuterGroupBy<NewDataFrame, GroupByIndices, GroupByTypes, CompoundSummarizer>{};
+        }
+    }
+
+    /**
+     * Joins two column stores with the columns of this DataFrame and OtherColumns (used for DataFrames and views).
+    */
+    template <Join JoinType, FixedString ...JoinNames, typename ColumnStoreDataSelf, typename ColumnStoreDataOther, typename ...OtherColumns, typename Strategy>
+    static auto joinColumnStores (const ColumnStoreDataSelf& self, std::size_t self_size, const ColumnStoreDataOther& other, std::size_t other_size, TypeList<OtherColumns...>, Strategy strategy, MemoryResource* memory_resource = getDefaultMemoryResource()) {
+        // compute all the indices
+        using JoinIndicesSelf = internal::GetColumnIndicesByNames<internal::NameList<JoinNames...>, Columns...>;
+        using JoinIndicesOther = internal::GetColumnIndicesByNames<internal::NameList<JoinNames...>, OtherColumns...>;
+        using ColumnNamesToCopyOther = internal::NameListDifference<internal::GetColumnNames<OtherColumns...>, internal::NameList<JoinNames...>>;
+        using DataIndicesToCopyOther = internal::GetColumnIndicesByNames<ColumnNamesToCopyOther, OtherColumns...>;
+
+        using DataIndicesInResultOther = internal::IntegerSequenceByRange<sizeof...(Columns), sizeof...(Columns) + sizeof...(OtherColumns) - sizeof...(JoinNames)>;
+        using ColumnsToCopyOther = typename internal::GetDataFrameWithColumnsByName<ColumnNamesToCopyOther, OtherColumns...>::ColumnSpecs;
+        using JoinedDataFrame = typename internal::GetJoinedColumns<JoinType, internal::NameList<JoinNames...>, TypeList<Columns...>, ColumnsToCopyOther>::template To<DataFrame>;
+
+        JoinedDataFrame result{memory_resource};
+        const auto joined_rows = internal::computeJoinedRows<JoinType>(strategy, self, self_size, other, other_size, JoinIndicesSelf{}, JoinIndicesOther{});
+        if constexpr (internal::is_filtering_join<JoinType>) {
+            addJoinedColumnData(result.column_store_data_, self, other, joined_rows, IndicesForColumnStore{}, std::integer_sequence<std::size_t>{}, std::integer_sequence<std::size_t>{});
+        }
+        else {
+            addJoinedColumnData(result.column_store_data_, self, other, joined_rows, IndicesForColumnStore{}, DataIndicesInResultOther{}, DataIndicesToCopyOther{});
+            if constexpr (internal::keeps_unmatched_right_rows<JoinType>) {
+                fillJoinColumnsForUnmatchedRightRows(result.column_store_data_, other, joined_rows, JoinIndicesSelf{}, JoinIndicesOther{});
             }
         }
         return result;
     }
 
-    template <typename DataFrameOther, std::size_t ...JoinIndicesSelf, std::size_t ...JoinIndicesOther>
-    requires (sizeof...(JoinIndicesSelf) == sizeof...(JoinIndicesOther))
-    bool compareJoinIndices (const DataFrameOther& df, std::size_t row_index_self, std::size_t row_index_other, std::integer_sequence<std::size_t, JoinIndicesSelf...>, std::integer_sequence<std::size_t, JoinIndicesOther...>) {
-        return ((std::get<JoinIndicesSelf>(column_store_data_)[row_index_self] == std::get<JoinIndicesOther>(df.column_store_data_)[row_index_other]) && ...);
+    template <typename JoinedColumnStoreData, typename ColumnStoreDataSelf, typename ColumnStoreDataOther, std::size_t ...ColumnIndicesSelf, std::size_t ...DataIndicesInResultOther, std::size_t ...DataIndicesToCopyOther>
+    static void addJoinedColumnData (JoinedColumnStoreData& joined_data, const ColumnStoreDataSelf& self, const ColumnStoreDataOther& other, const internal::JoinedRowIndices& joined_rows, std::integer_sequence<std::size_t, ColumnIndicesSelf...>, std::integer_sequence<std::size_t, DataIndicesInResultOther...>, std::integer_sequence<std::size_t, DataIndicesToCopyOther...>) {
+        ((internal::gatherJoinedRowsIntoContainer(std::get<ColumnIndicesSelf>(joined_data), std::get<ColumnIndicesSelf>(self), joined_rows.left)), ...);
+        ((internal::gatherJoinedRowsIntoContainer(std::get<DataIndicesInResultOther>(joined_data), std::get<DataIndicesToCopyOther>(other), joined_rows.right)), ...);
+    }
+
+    template <typename JoinedColumnStoreData, typename ColumnStoreDataOther, std::size_t ...JoinIndicesSelf, std::size_t ...JoinIndicesOther>
+    static void fillJoinColumnsForUnmatchedRightRows (JoinedColumnStoreData& joined_data, const ColumnStoreDataOther& other, const internal::JoinedRowIndices& joined_rows, std::integer_sequence<std::size_t, JoinIndicesSelf...>, std::integer_sequence<std::size_t, JoinIndicesOther...>) {
+        ((internal::fillJoinColumnForUnmatchedRightRows(std::get<JoinIndicesSelf>(joined_data), std::get<JoinIndicesOther>(other), joined_rows)), ...);
     }
 
-    template <typename JoinedColumnStoreData, typename DataFrameOther, std::size_t ...ColumnIndicesSelf, std::size_t ...DataIndicesInResultOther, std::size_t ...DataIndicesToCopyOther>
-    void addJoinedColumnData (JoinedColumnStoreData& joined_data, const DataFrameOther& df, std::size_t row_index_self, std::size_t row_index_other, std::integer_sequence<std::size_t, ColumnIndicesSelf...>, std::integer_sequence<std::size_t, DataIndicesInResultOther...>, std::integer_sequence<std::size_t, DataIndicesToCopyOther...>) {
-        ((std::get<ColumnIndicesSelf>(joined_data).push_back(std::get<ColumnIndicesSelf>(column_store_data_)[row_index_self])), ...);
-        ((std::get<DataIndicesInResultOther>(joined_data).push_back(std::get<DataIndicesToCopyOther>(df.column_store_data_)[row_index_other])), ...);
+    template <SortOrder Order, FixedString ...SortByNames>
+    using SortKeysForNames = internal::ConstructSortKeys<Order, internal::GetColumnIndicesByNames<internal::NameList<SortByNames...>, Columns...>>;
+
+    template <typename ...SortKeySpecs>
+    using SortKeysForSpecs = internal::ConstructSortKeysBySpecs<TypeList<SortKeySpecs...>, Columns...>;
+
+    template <typename SortKeys, bool Stable>
+    auto sortImpl () {
+        if constexpr (sizeof...(Columns) > 0) {
+            return gather(argsortImpl<SortKeys, Stable>());
+        }
+        else {
+            return DataFrame{};
+        }
+    }
+
+    template <typename SortKeys>
+    auto sortParallelImpl (ParallelPolicy policy) {
+        if constexpr (sizeof...(Columns) > 0) {
+            return gather(argsortParallelImpl<SortKeys>(policy), policy);
+        }
+        else {
+            return DataFrame{};
+        }
+    }
+
+    template <typename SortKeys>
+    auto topNImpl (std::size_t k) {
+        if constexpr (sizeof...(Columns) > 0) {
+            using ElementComparison = internal::ConstructElementComparisonBySortKeys<SortKeys>;
+            return gather(internal::argsortTopRows<ElementComparison>(column_store_data_, getSize(), k));
+        }
+        else {
+            return DataFrame{};
+        }
+    }
+
+    template <typename SortKeys, bool Stable>
+    std::vector<std::size_t> argsortImpl () const {
+        return argsortColumnStore<SortKeys, Stable>(column_store_data_, getSize());
+    }
+
+    /**
+     * Sorts the row indices of a column store with the columns of this DataFrame (used for DataFrames and views).
+    */
+    template <typename SortKeys, bool Stable, typename ColumnStoreData>
+    static std::vector<std::size_t> argsortColumnStore (const ColumnStoreData& column_store_data, std::size_t size) {
+        using ElementComparison = internal::ConstructElementComparisonBySortKeys<SortKeys>;
+        using SortColumnTypes = typename internal::GetColumnStoreValueTypes<ColumnStoreData, internal::GetSortKeyIndices<SortKeys>>::type;
+        if constexpr (internal::is_radix_sortable<SortColumnTypes>) {
+            if (size >= internal::MIN_ROWS_FOR_RADIX_SORT) {
+                return internal::argsortRowsByRadix<SortKeys>(column_store_data, size);
+            }
+        }
+        if constexpr (internal::has_string_prefix_key<SortKeys, ColumnStoreData>) {
+            return internal::argsortRowsByStringPrefix<SortKeys, Stable>(column_store_data, size);
+        }
+        else if constexpr (internal::has_categorical_key<SortKeys, ColumnStoreData>) {
+            return internal::argsortRowsByCategoricalRank<SortKeys, Stable>(column_store_data, size);
+        }
+        else if constexpr (Stable) {
+            return internal::argsortRowsStable<ElementComparison>(column_store_data, size);
+        }
+        else {
+            return internal::argsortRows<ElementComparison>(column_store_data, size);
+        }
+    }
+
+    template <typename SortKeys>
+    std::vector<std::size_t> argsortParallelImpl (ParallelPolicy policy) const {
+        using ElementComparison = internal::ConstructElementComparisonBySortKeys<SortKeys>;
+        return internal::argsortRowsParallel<ElementComparison>(column_store_data_, getSize(), internal::getNumberOfThreads(policy.num_threads));
+    }
+
+    template <std::size_t ...Indices>
+    void gatherImpl (DataFrame& result, const std::vector<std::size_t>& row_indices, std::integer_sequence<std::size_t, Indices...>) const {
+        ((internal::gatherIntoContainer(std::get<Indices>(result.column_store_data_), std::get<Indices>(column_store_data_), row_indices)), ...);
     }
 
     template <std::size_t ...Indices>
-    void sortByImpl (DataFrame& result, std::size_t index, std::integer_sequence<std::size_t, Indices...>) {
-        ((std::get<Indices>(result.column_store_data_).push_back(
-            std::get<Indices>(column_store_data_)[index]
-        )), ...);
+    void gatherColumnImpl (DataFrame& result, const std::vector<std::size_t>& row_indices, std::size_t column_index, std::integer_sequence<std::size_t, Indices...>) const {
+        ((Indices == column_index ? internal::gatherIntoContainer(std::get<Indices>(result.column_store_data_), std::get<Indices>(column_store_data_), row_indices) : void()), ...);
     }
 
     ColumnStoreDataType column_store_data_{};
+    GrowthPolicy growth_policy_{};
+    MemoryResource* memory_resource_ {getDefaultMemoryResource()};
 };
 
 #define dacr_param auto data
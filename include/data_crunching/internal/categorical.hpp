@@ -0,0 +1,271 @@
+// Copyright 2022 Andi Hellmund
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef DATA_CRUNCHING_INTERNAL_CATEGORICAL_HPP
+#define DATA_CRUNCHING_INTERNAL_CATEGORICAL_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <ostream>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace dacr {
+
+// ############################################################################
+// Class: Categorical Dictionary
+// ############################################################################
+/**
+ * Dictionary assigning a dense integer code to each distinct string.
+ *
+ * The codes are assigned in the order the strings are encoded, code 0 being the empty string.
+ * Encoding is thread-safe. Decoding is lock-free: the strings are stored in chunks of doubling
+ * size which are never moved, such that a decoded string stays valid for the lifetime of the
+ * dictionary.
+*/
+class CategoricalDictionary {
+public:
+    static constexpr std::size_t FIRST_CHUNK_SIZE = 64;
+    static constexpr std::size_t NUM_CHUNKS = 27; // FIRST_CHUNK_SIZE * (2^27 - 1) > 2^32 codes
+
+    CategoricalDictionary () {
+        encode(std::string_view{});
+    }
+
+    CategoricalDictionary (const CategoricalDictionary&) = delete;
+    CategoricalDictionary& operator= (const CategoricalDictionary&) = delete;
+
+    ~CategoricalDictionary () {
+        for (auto& chunk : chunks_) {
+            delete[] chunk.load(std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Returns the code of the string, adding the string to the dictionary if not yet present.
+    */
+    std::uint32_t encode (std::string_view value) {
+        {
+            std::shared_lock lock{mutex_};
+            if (auto it = codes_.find(value); it != codes_.end()) {
+                return it->second;
+            }
+        }
+        std::unique_lock lock{mutex_};
+        if (auto it = codes_.find(value); it != codes_.end()) {
+            return it->second;
+        }
+        const std::size_t code = size_.load(std::memory_order_relaxed);
+        if (code > std::numeric_limits<std::uint32_t>::max()) {
+            throw std::length_error("categorical dictionary exceeds the maximum number of codes");
+        }
+        const auto [chunk_index, offset] = getLocation(code);
+        if (offset == 0) {
+            chunks_[chunk_index].store(new std::string[FIRST_CHUNK_SIZE << chunk_index], std::memory_order_release);
+        }
+        std::string& entry = chunks_[chunk_index].load(std::memory_order_relaxed)[offset];
+        entry = value;
+        codes_.emplace(std::string_view{entry}, static_cast<std::uint32_t>(code));
+        size_.store(code + 1, std::memory_order_release);
+        return static_cast<std::uint32_t>(code);
+    }
+
+    /**
+     * Returns the string of a code returned by encode.
+    */
+    std::string_view decode (std::uint32_t code) const {
+        const auto [chunk_index, offset] = getLocation(code);
+        return chunks_[chunk_index].load(std::memory_order_acquire)[offset];
+    }
+
+    /**
+     * Returns the code of the string if present, without adding the string to the dictionary.
+    */
+    std::optional<std::uint32_t> find (std::string_view value) const {
+        std::shared_lock lock{mutex_};
+        if (auto it = codes_.find(value); it != codes_.end()) {
+            return it->second;
+        }
+        return std::nullopt;
+    }
+
+    std::size_t getSize () const {
+        return size_.load(std::memory_order_acquire);
+    }
+
+private:
+    static std::pair<std::size_t, std::size_t> getLocation (std::size_t code) {
+        const std::size_t chunk_index = std::bit_width(code / FIRST_CHUNK_SIZE + 1) - 1;
+        return {chunk_index, code - FIRST_CHUNK_SIZE * ((std::size_t{1} << chunk_index) - 1)};
+    }
+
+    mutable std::shared_mutex mutex_{};
+    std::unordered_map<std::string_view, std::uint32_t> codes_{};
+    std::array<std::atomic<std::string*>, NUM_CHUNKS> chunks_{};
+    std::atomic<std::size_t> size_ {0};
+};
+
+/**
+ * Returns the dictionary shared by all categorical values, such that equal strings have equal
+ * codes across DataFrames (e.g. for joins). The dictionary only grows: it is meant for columns
+ * with a limited number of distinct values.
+*/
+inline CategoricalDictionary& getCategoricalDictionary () {
+    static CategoricalDictionary dictionary{};
+    return dictionary;
+}
+
+// ############################################################################
+// Class: Categorical
+// ############################################################################
+template <typename T>
+concept IsStringLike = std::is_convertible_v<const T&, std::string_view>;
+
+/**
+ * Dictionary-encoded string storing only the integer code of the string.
+ *
+ * Equality and hashing operate on the codes. The ordering is lexicographical by the strings.
+*/
+class Categorical {
+public:
+    Categorical () = default;
+
+    Categorical (std::string_view value) : code_{getCategoricalDictionary().encode(value)} {}
+
+    Categorical (const std::string& value) : Categorical{std::string_view{value}} {}
+
+    Categorical (const char* value) : Categorical{std::string_view{value}} {}
+
+    static Categorical fromCode (std::uint32_t code) {
+        Categorical categorical{};
+        categorical.code_ = code;
+        return categorical;
+    }
+
+    std::uint32_t getCode () const {
+        return code_;
+    }
+
+    std::string_view view () const {
+        return getCategoricalDictionary().decode(code_);
+    }
+
+    std::string str () const {
+        return std::string{view()};
+    }
+
+    friend bool operator== (const Categorical& lhs, const Categorical& rhs) {
+        return lhs.code_ == rhs.code_;
+    }
+
+    friend std::strong_ordering operator<=> (const Categorical& lhs, const Categorical& rhs) {
+        if (lhs.code_ == rhs.code_) {
+            return std::strong_ordering::equal;
+        }
+        return lhs.view() <=> rhs.view();
+    }
+
+    /**
+     * Compares with strings without encoding them.
+    */
+    template <IsStringLike T>
+    friend bool operator== (const Categorical& lhs, const T& rhs) {
+        return lhs.view() == std::string_view{rhs};
+    }
+
+    template <IsStringLike T>
+    friend std::strong_ordering operator<=> (const Categorical& lhs, const T& rhs) {
+        return lhs.view() <=> std::string_view{rhs};
+    }
+
+    friend std::ostream& operator<< (std::ostream& stream, const Categorical& categorical) {
+        return stream << categorical.view();
+    }
+
+private:
+    std::uint32_t code_ {0};
+};
+
+namespace internal {
+
+// ############################################################################
+// Util: Categorical Ranks
+// ############################################################################
+/**
+ * Returns the categorical value of a column element, nullptr for missing values (e.g. in columns of outer joins).
+*/
+template <typename T>
+const Categorical* getCategoricalValue (const T& value) {
+    if constexpr (std::is_same_v<T, Categorical>) {
+        return &value;
+    }
+    else {
+        return value.has_value() ? &*value : nullptr;
+    }
+}
+
+/**
+ * Returns the lexicographical rank of each distinct code occurring in the first size rows of the column.
+ * Only these codes are sorted (not the whole dictionary).
+*/
+template <typename Container>
+std::unordered_map<std::uint32_t, std::uint32_t> rankCategoricalCodes (const Container& column, std::size_t size) {
+    std::unordered_map<std::uint32_t, std::uint32_t> ranks{};
+    for (std::size_t row_index = 0; row_index < size; ++row_index) {
+        if (const Categorical* value = getCategoricalValue(column[row_index])) {
+            ranks.try_emplace(value->getCode(), 0);
+        }
+    }
+    std::vector<Categorical> distinct_values{};
+    distinct_values.reserve(ranks.size());
+    for (const auto& [code, rank] : ranks) {
+        distinct_values.push_back(Categorical::fromCode(code));
+    }
+    std::sort(distinct_values.begin(), distinct_values.end(), [](const Categorical& lhs, const Categorical& rhs) {
+        return lhs.view() < rhs.view();
+    });
+    for (std::size_t rank = 0; rank < distinct_values.size(); ++rank) {
+        ranks[distinct_values[rank].getCode()] = static_cast<std::uint32_t>(rank);
+    }
+    return ranks;
+}
+
+} // namespace internal
+
+} // namespace dacr
+
+template <>
+struct std::hash<dacr::Categorical> {
+    std::size_t operator() (const dacr::Categorical& categorical) const noexcept {
+        return std::hash<std::uint32_t>{}(categorical.getCode());
+    }
+};
+
+#endif // DATA_CRUNCHING_INTERNAL_CATEGORICAL_HPP
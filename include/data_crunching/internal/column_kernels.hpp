@@ -0,0 +1,555 @@
+// Copyright 2022 Andi Hellmund
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef DATA_CRUNCHING_INTERNAL_COLUMN_KERNELS_HPP
+#define DATA_CRUNCHING_INTERNAL_COLUMN_KERNELS_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define DACR_X86_SIMD_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace dacr::internal {
+
+// ############################################################################
+// Util: Scalar Column Reduction
+// ############################################################################
+inline constexpr std::size_t NUM_COLUMN_ACCUMULATORS = 8;
+
+/**
+ * Reduces a contiguous column with independent accumulators.
+ *
+ * The accumulators break the dependency chain of the reduction, such that the
+ * loop is pipelined and can be auto-vectorized by the compiler.
+*/
+template <typename Accumulator, typename T, typename Op>
+inline Accumulator reduceColumn (const T* values, std::size_t size, Accumulator init, Op operation) {
+    std::array<Accumulator, NUM_COLUMN_ACCUMULATORS> accumulators{};
+    accumulators.fill(init);
+    std::size_t index {0};
+    for (; index + NUM_COLUMN_ACCUMULATORS <= size; index += NUM_COLUMN_ACCUMULATORS) {
+        for (std::size_t lane = 0; lane < NUM_COLUMN_ACCUMULATORS; ++lane) {
+            accumulators[lane] = operation(accumulators[lane], static_cast<Accumulator>(values[index + lane]));
+        }
+    }
+    Accumulator result = init;
+    for (auto accumulator : accumulators) {
+        result = operation(result, accumulator);
+    }
+    for (; index < size; ++index) {
+        result = operation(result, static_cast<Accumulator>(values[index]));
+    }
+    return result;
+}
+
+struct AddOp {
+    template <typename T>
+    T operator() (T lhs, T rhs) const {
+        return lhs + rhs;
+    }
+};
+
+struct MinOp {
+    template <typename T>
+    T operator() (T lhs, T rhs) const {
+        return rhs < lhs ? rhs : lhs;
+    }
+};
+
+struct MaxOp {
+    template <typename T>
+    T operator() (T lhs, T rhs) const {
+        return rhs > lhs ? rhs : lhs;
+    }
+};
+
+// ############################################################################
+// Util: SIMD Level
+// ############################################################################
+enum class SimdLevel {
+    Scalar,
+    Avx2,
+    Avx512,
+};
+
+/**
+ * Returns the widest SIMD instruction set of the CPU for which kernels exist (detected once at runtime).
+*/
+inline SimdLevel getSupportedSimdLevel () {
+    static const SimdLevel supported_simd_level = []() {
+#if defined(DACR_X86_SIMD_KERNELS)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) {
+            return SimdLevel::Avx512;
+        }
+        if (__builtin_cpu_supports("avx2")) {
+            return SimdLevel::Avx2;
+        }
+#endif
+        return SimdLevel::Scalar;
+    }();
+    return supported_simd_level;
+}
+
+inline std::atomic<SimdLevel>& getSimdLevelStorage () {
+    static std::atomic<SimdLevel> simd_level {getSupportedSimdLevel()};
+    return simd_level;
+}
+
+/**
+ * Returns the SIMD instruction set used by the column kernels (by default the supported one).
+*/
+inline SimdLevel getSimdLevel () {
+    return getSimdLevelStorage().load(std::memory_order_relaxed);
+}
+
+/**
+ * Restricts the column kernels to the given SIMD instruction set (at most the supported one),
+ * e.g. to compare the kernels of all instruction sets on a single machine.
+*/
+inline void setSimdLevel (SimdLevel simd_level) {
+    getSimdLevelStorage().store(std::min(simd_level, getSupportedSimdLevel()), std::memory_order_relaxed);
+}
+
+// ############################################################################
+// Util: SIMD Column Reduction
+// ############################################################################
+/**
+ * The SIMD kernels are compiled for their instruction set by the target attribute, such that they are
+ * available without compiler flags (e.g. -mavx2) and only called if the CPU supports the instruction set.
+*/
+#if defined(DACR_X86_SIMD_KERNELS)
+// the _mm512_undefined_* intrinsics of GCC (used by the reductions) are flagged as uninitialized when
+// inlined into functions with a target attribute
+#if !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+[[gnu::target("avx512f")]] inline double sumColumnAvx512 (const double* values, std::size_t size) {
+    __m512d sum0 = _mm512_setzero_pd();
+    __m512d sum1 = _mm512_setzero_pd();
+    std::size_t index {0};
+    for (; index + 16 <= size; index += 16) {
+        sum0 = _mm512_add_pd(sum0, _mm512_loadu_pd(values + index));
+        sum1 = _mm512_add_pd(sum1, _mm512_loadu_pd(values + index + 8));
+    }
+    double result = _mm512_reduce_add_pd(_mm512_add_pd(sum0, sum1));
+    for (; index < size; ++index) {
+        result += values[index];
+    }
+    return result;
+}
+
+[[gnu::target("avx512f")]] inline float sumColumnAvx512 (const float* values, std::size_t size) {
+    __m512 sum0 = _mm512_setzero_ps();
+    __m512 sum1 = _mm512_setzero_ps();
+    std::size_t index {0};
+    for (; index + 32 <= size; index += 32) {
+        sum0 = _mm512_add_ps(sum0, _mm512_loadu_ps(values + index));
+        sum1 = _mm512_add_ps(sum1, _mm512_loadu_ps(values + index + 16));
+    }
+    float result = _mm512_reduce_add_ps(_mm512_add_ps(sum0, sum1));
+    for (; index < size; ++index) {
+        result += values[index];
+    }
+    return result;
+}
+
+[[gnu::target("avx512f")]] inline double minColumnAvx512 (const double* values, std::size_t size, double init) {
+    __m512d min = _mm512_set1_pd(init);
+    std::size_t index {0};
+    for (; index + 8 <= size; index += 8) {
+        min = _mm512_min_pd(_mm512_loadu_pd(values + index), min);
+    }
+    double result = MinOp{}(init, _mm512_reduce_min_pd(min));
+    for (; index < size; ++index) {
+        result = MinOp{}(result, values[index]);
+    }
+    return result;
+}
+
+[[gnu::target("avx512f")]] inline double maxColumnAvx512 (const double* values, std::size_t size, double init) {
+    __m512d max = _mm512_set1_pd(init);
+    std::size_t index {0};
+    for (; index + 8 <= size; index += 8) {
+        max = _mm512_max_pd(_mm512_loadu_pd(values + index), max);
+    }
+    double result = MaxOp{}(init, _mm512_reduce_max_pd(max));
+    for (; index < size; ++index) {
+        result = MaxOp{}(result, values[index]);
+    }
+    return result;
+}
+
+#if !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+[[gnu::target("avx2")]] inline double sumColumnAvx2 (const double* values, std::size_t size) {
+    __m256d sum0 = _mm256_setzero_pd();
+    __m256d sum1 = _mm256_setzero_pd();
+    std::size_t index {0};
+    for (; index + 8 <= size; index += 8) {
+        sum0 = _mm256_add_pd(sum0, _mm256_loadu_pd(values + index));
+        sum1 = _mm256_add_pd(sum1, _mm256_loadu_pd(values + index + 4));
+    }
+    alignas(32) std::array<double, 4> lanes{};
+    _mm256_store_pd(lanes.data(), _mm256_add_pd(sum0, sum1));
+    double result = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    for (; index < size; ++index) {
+        result += values[index];
+    }
+    return result;
+}
+
+[[gnu::target("avx2")]] inline float sumColumnAvx2 (const float* values, std::size_t size) {
+    __m256 sum0 = _mm256_setzero_ps();
+    __m256 sum1 = _mm256_setzero_ps();
+    std::size_t index {0};
+    for (; index + 16 <= size; index += 16) {
+        sum0 = _mm256_add_ps(sum0, _mm256_loadu_ps(values + index));
+        sum1 = _mm256_add_ps(sum1, _mm256_loadu_ps(values + index + 8));
+    }
+    alignas(32) std::array<float, 8> lanes{};
+    _mm256_store_ps(lanes.data(), _mm256_add_ps(sum0, sum1));
+    float result {0};
+    for (auto lane : lanes) {
+        result += lane;
+    }
+    for (; index < size; ++index) {
+        result += values[index];
+    }
+    return result;
+}
+
+[[gnu::target("avx2")]] inline double minColumnAvx2 (const double* values, std::size_t size, double init) {
+    __m256d min = _mm256_set1_pd(init);
+    std::size_t index {0};
+    for (; index + 4 <= size; index += 4) {
+        min = _mm256_min_pd(_mm256_loadu_pd(values + index), min);
+    }
+    alignas(32) std::array<double, 4> lanes{};
+    _mm256_store_pd(lanes.data(), min);
+    double result = init;
+    for (auto lane : lanes) {
+        result = MinOp{}(result, lane);
+    }
+    for (; index < size; ++index) {
+        result = MinOp{}(result, values[index]);
+    }
+    return result;
+}
+
+[[gnu::target("avx2")]] inline double maxColumnAvx2 (const double* values, std::size_t size, double init) {
+    __m256d max = _mm256_set1_pd(init);
+    std::size_t index {0};
+    for (; index + 4 <= size; index += 4) {
+        max = _mm256_max_pd(_mm256_loadu_pd(values + index), max);
+    }
+    alignas(32) std::array<double, 4> lanes{};
+    _mm256_store_pd(lanes.data(), max);
+    double result = init;
+    for (auto lane : lanes) {
+        result = MaxOp{}(result, lane);
+    }
+    for (; index < size; ++index) {
+        result = MaxOp{}(result, values[index]);
+    }
+    return result;
+}
+#endif
+
+// ############################################################################
+// Util: Column Kernels
+// ############################################################################
+/**
+ * Reduction kernels over contiguous columns.
+ *
+ * On x86-64, the floating-point kernels use explicit AVX-512 or AVX2 intrinsics if the CPU
+ * supports them (detected at runtime, independent of the compiler flags), otherwise the
+ * multi-accumulator scalar reduction is used. Floating-point sums are reassociated and may
+ * therefore differ in rounding from a sequential summation.
+*/
+template <typename T>
+inline T sumColumn (const T* values, std::size_t size) {
+#if defined(DACR_X86_SIMD_KERNELS)
+    if constexpr (std::is_same_v<T, double> || std::is_same_v<T, float>) {
+        switch (getSimdLevel()) {
+            case SimdLevel::Avx512: return sumColumnAvx512(values, size);
+            case SimdLevel::Avx2: return sumColumnAvx2(values, size);
+            case SimdLevel::Scalar: break;
+        }
+    }
+#endif
+    return reduceColumn<T>(values, size, T{0}, AddOp{});
+}
+
+template <typename T>
+inline double sumColumnAsDouble (const T* values, std::size_t size) {
+    if constexpr (std::is_same_v<T, double>) {
+        return sumColumn(values, size);
+    }
+    else {
+        return reduceColumn<double>(values, size, 0.0, AddOp{});
+    }
+}
+
+template <typename T>
+inline T minColumn (const T* values, std::size_t size, T init) {
+#if defined(DACR_X86_SIMD_KERNELS)
+    if constexpr (std::is_same_v<T, double>) {
+        switch (getSimdLevel()) {
+            case SimdLevel::Avx512: return minColumnAvx512(values, size, init);
+            case SimdLevel::Avx2: return minColumnAvx2(values, size, init);
+            case SimdLevel::Scalar: break;
+        }
+    }
+#endif
+    return reduceColumn<T>(values, size, init, MinOp{});
+}
+
+template <typename T>
+inline T maxColumn (const T* values, std::size_t size, T init) {
+#if defined(DACR_X86_SIMD_KERNELS)
+    if constexpr (std::is_same_v<T, double>) {
+        switch (getSimdLevel()) {
+            case SimdLevel::Avx512: return maxColumnAvx512(values, size, init);
+            case SimdLevel::Avx2: return maxColumnAvx2(values, size, init);
+            case SimdLevel::Scalar: break;
+        }
+    }
+#endif
+    return reduceColumn<T>(values, size, init, MaxOp{});
+}
+
+/**
+ * Returns the sum of squared deviations from mean of a contiguous column.
+*/
+template <typename T>
+inline double sumSquaredDeviationsColumn (const T* values, std::size_t size, double mean) {
+    std::array<double, NUM_COLUMN_ACCUMULATORS> accumulators{};
+    std::size_t index {0};
+    for (; index + NUM_COLUMN_ACCUMULATORS <= size; index += NUM_COLUMN_ACCUMULATORS) {
+        for (std::size_t lane = 0; lane < NUM_COLUMN_ACCUMULATORS; ++lane) {
+            const double deviation = static_cast<double>(values[index + lane]) - mean;
+            accumulators[lane] += deviation * deviation;
+        }
+    }
+    double result {0};
+    for (auto accumulator : accumulators) {
+        result += accumulator;
+    }
+    for (; index < size; ++index) {
+        const double deviation = static_cast<double>(values[index]) - mean;
+        result += deviation * deviation;
+    }
+    return result;
+}
+
+// ############################################################################
+// Util: Scalar Comparison Kernels
+// ############################################################################
+struct EqualOp;
+struct NotEqualOp;
+struct LessOp;
+struct LessEqualOp;
+struct GreaterOp;
+struct GreaterEqualOp;
+
+/**
+ * The comparison operations define the mirrored operation which yields the same result
+ * with swapped operands, e.g. (a < b) == (b > a).
+*/
+struct EqualOp {
+    using Mirrored = EqualOp;
+
+    template <typename L, typename R>
+    bool operator() (const L& lhs, const R& rhs) const {
+        return lhs == rhs;
+    }
+};
+
+struct NotEqualOp {
+    using Mirrored = NotEqualOp;
+
+    template <typename L, typename R>
+    bool operator() (const L& lhs, const R& rhs) const {
+        return lhs != rhs;
+    }
+};
+
+struct LessOp {
+    using Mirrored = GreaterOp;
+
+    template <typename L, typename R>
+    bool operator() (const L& lhs, const R& rhs) const {
+        return lhs < rhs;
+    }
+};
+
+struct LessEqualOp {
+    using Mirrored = GreaterEqualOp;
+
+    template <typename L, typename R>
+    bool operator() (const L& lhs, const R& rhs) const {
+        return lhs <= rhs;
+    }
+};
+
+struct GreaterOp {
+    using Mirrored = LessOp;
+
+    template <typename L, typename R>
+    bool operator() (const L& lhs, const R& rhs) const {
+        return lhs > rhs;
+    }
+};
+
+struct GreaterEqualOp {
+    using Mirrored = LessEqualOp;
+
+    template <typename L, typename R>
+    bool operator() (const L& lhs, const R& rhs) const {
+        return lhs >= rhs;
+    }
+};
+
+/**
+ * Writes the comparison result of each value as 0 or 1 into the mask.
+ *
+ * The loop is free of branches, such that it is auto-vectorized for arithmetic columns.
+*/
+template <typename T, typename U, typename Op>
+inline void compareColumnWithValueScalar (const T* values, std::size_t size, const U& value, Op operation, std::uint8_t* mask) {
+    for (std::size_t index = 0; index < size; ++index) {
+        mask[index] = static_cast<std::uint8_t>(operation(values[index], value));
+    }
+}
+
+template <typename T, typename U, typename Op>
+inline void compareColumns (const T* lhs, const U* rhs, std::size_t size, Op operation, std::uint8_t* mask) {
+    for (std::size_t index = 0; index < size; ++index) {
+        mask[index] = static_cast<std::uint8_t>(operation(lhs[index], rhs[index]));
+    }
+}
+
+inline void andMasks (std::uint8_t* mask, const std::uint8_t* other, std::size_t size) {
+    for (std::size_t index = 0; index < size; ++index) {
+        mask[index] &= other[index];
+    }
+}
+
+inline void orMasks (std::uint8_t* mask, const std::uint8_t* other, std::size_t size) {
+    for (std::size_t index = 0; index < size; ++index) {
+        mask[index] |= other[index];
+    }
+}
+
+inline void invertMask (std::uint8_t* mask, std::size_t size) {
+    for (std::size_t index = 0; index < size; ++index) {
+        mask[index] ^= std::uint8_t{1};
+    }
+}
+
+inline std::size_t countMask (const std::uint8_t* mask, std::size_t size) {
+    return reduceColumn<std::size_t>(mask, size, std::size_t{0}, AddOp{});
+}
+
+// ############################################################################
+// Util: SIMD Comparison Kernels
+// ############################################################################
+#if defined(DACR_X86_SIMD_KERNELS)
+/**
+ * Mask bytes (in little-endian order) for each 4-bit result of _mm256_movemask_pd.
+*/
+inline constexpr std::array<std::uint32_t, 16> MASK_BYTES_BY_BITS = []() {
+    std::array<std::uint32_t, 16> mask_bytes{};
+    for (std::uint32_t bits = 0; bits < mask_bytes.size(); ++bits) {
+        for (std::uint32_t lane = 0; lane < 4; ++lane) {
+            if ((bits >> lane) & 1) {
+                mask_bytes[bits] |= std::uint32_t{1} << (8 * lane);
+            }
+        }
+    }
+    return mask_bytes;
+}();
+
+template <typename Op>
+inline constexpr int getSimdComparePredicate () {
+    if constexpr (std::is_same_v<Op, EqualOp>) {
+        return _CMP_EQ_OQ;
+    }
+    else if constexpr (std::is_same_v<Op, NotEqualOp>) {
+        return _CMP_NEQ_UQ;
+    }
+    else if constexpr (std::is_same_v<Op, LessOp>) {
+        return _CMP_LT_OQ;
+    }
+    else if constexpr (std::is_same_v<Op, LessEqualOp>) {
+        return _CMP_LE_OQ;
+    }
+    else if constexpr (std::is_same_v<Op, GreaterOp>) {
+        return _CMP_GT_OQ;
+    }
+    else {
+        return _CMP_GE_OQ;
+    }
+}
+
+template <typename Op>
+[[gnu::target("avx2")]] inline void compareColumnWithValueAvx2 (const double* values, std::size_t size, double value, Op operation, std::uint8_t* mask) {
+    constexpr int predicate = getSimdComparePredicate<Op>();
+    const __m256d broadcast_value = _mm256_set1_pd(value);
+    std::size_t index {0};
+    for (; index + 4 <= size; index += 4) {
+        const __m256d result = _mm256_cmp_pd(_mm256_loadu_pd(values + index), broadcast_value, predicate);
+        std::memcpy(mask + index, &MASK_BYTES_BY_BITS[_mm256_movemask_pd(result)], 4);
+    }
+    compareColumnWithValueScalar(values + index, size - index, value, operation, mask + index);
+}
+#endif
+
+// ############################################################################
+// Util: Comparison Kernels
+// ############################################################################
+/**
+ * Comparison kernel of a contiguous column against a single value producing a byte mask.
+ *
+ * If the CPU supports AVX2 (detected at runtime), double columns compared against arithmetic
+ * values use explicit SIMD intrinsics, otherwise the auto-vectorized scalar loop is used.
+*/
+template <typename T, typename U, typename Op>
+inline void compareColumnWithValue (const T* values, std::size_t size, const U& value, Op operation, std::uint8_t* mask) {
+#if defined(DACR_X86_SIMD_KERNELS)
+    if constexpr (std::is_same_v<T, double> && std::is_arithmetic_v<U>) {
+        if (getSimdLevel() != SimdLevel::Scalar) {
+            compareColumnWithValueAvx2(values, size, static_cast<double>(value), operation, mask);
+            return;
+        }
+    }
+#endif
+    compareColumnWithValueScalar(values, size, value, operation, mask);
+}
+
+} // namespace dacr::internal
+
+#endif // DATA_CRUNCHING_INTERNAL_COLUMN_KERNELS_HPP
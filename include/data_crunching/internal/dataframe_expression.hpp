@@ -0,0 +1,636 @@
+// Copyright 2022 Andi Hellmund
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef DATA_CRUNCHING_INTERNAL_DATAFRAME_EXPRESSION_HPP
+#define DATA_CRUNCHING_INTERNAL_DATAFRAME_EXPRESSION_HPP
+
+#include <cstdint>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "data_crunching/internal/column.hpp"
+#include "data_crunching/internal/categorical.hpp"
+#include "data_crunching/internal/column_kernels.hpp"
+#include "data_crunching/internal/dataframe_join.hpp"
+#include "data_crunching/internal/dataframe_query.hpp"
+#include "data_crunching/internal/fixed_string.hpp"
+#include "data_crunching/internal/name_list.hpp"
+#include "data_crunching/internal/type_list.hpp"
+
+namespace dacr {
+
+namespace internal {
+
+// ############################################################################
+// Class: Expression Nodes
+// ############################################################################
+/**
+ * Nodes of a predicate expression over the columns of a DataFrame.
+ *
+ * Each node exposes the names of the columns it references as Names, such that an expression
+ * is validated against the columns of a DataFrame at compile time.
+*/
+template <FixedString Name>
+struct ColumnReference {
+    using Names = NameList<Name>;
+
+    static constexpr FixedString NAME = Name;
+};
+
+template <typename T>
+struct Literal {
+    using Names = NameList<>;
+
+    T value;
+};
+
+template <typename Op, typename Lhs, typename Rhs>
+struct Comparison {
+    using Names = NameListUnion<typename Lhs::Names, typename Rhs::Names>;
+
+    Lhs lhs;
+    Rhs rhs;
+};
+
+template <typename Lhs, typename Rhs>
+struct Conjunction {
+    using Names = NameListUnion<typename Lhs::Names, typename Rhs::Names>;
+
+    Lhs lhs;
+    Rhs rhs;
+};
+
+template <typename Lhs, typename Rhs>
+struct Disjunction {
+    using Names = NameListUnion<typename Lhs::Names, typename Rhs::Names>;
+
+    Lhs lhs;
+    Rhs rhs;
+};
+
+template <typename Operand>
+struct Negation {
+    using Names = typename Operand::Names;
+
+    Operand operand;
+};
+
+/**
+ * Expression selecting all rows, e.g. the conjunction of no predicates.
+*/
+struct Tautology {
+    using Names = NameList<>;
+};
+
+// ############################################################################
+// Concept: Is Expression
+// ############################################################################
+template <typename>
+struct IsColumnReferenceImpl : std::false_type {};
+
+template <FixedString Name>
+struct IsColumnReferenceImpl<ColumnReference<Name>> : std::true_type {};
+
+template <typename T>
+concept IsColumnReference = IsColumnReferenceImpl<std::remove_cvref_t<T>>::value;
+
+template <typename>
+struct IsExpressionImpl : std::false_type {};
+
+template <typename Op, typename Lhs, typename Rhs>
+struct IsExpressionImpl<Comparison<Op, Lhs, Rhs>> : std::true_type {};
+
+template <typename Lhs, typename Rhs>
+struct IsExpressionImpl<Conjunction<Lhs, Rhs>> : std::true_type {};
+
+template <typename Lhs, typename Rhs>
+struct IsExpressionImpl<Disjunction<Lhs, Rhs>> : std::true_type {};
+
+template <typename Operand>
+struct IsExpressionImpl<Negation<Operand>> : std::true_type {};
+
+template <>
+struct IsExpressionImpl<Tautology> : std::true_type {};
+
+template <typename T>
+concept IsExpression = IsExpressionImpl<std::remove_cvref_t<T>>::value;
+
+// ############################################################################
+// Trait: Expression Names
+// ############################################################################
+template <IsExpression Expr>
+using GetExpressionNames = typename std::remove_cvref_t<Expr>::Names;
+
+template <IsExpression Expr, typename ...Columns>
+constexpr bool is_valid_expression = are_names_in_columns<GetExpressionNames<Expr>, Columns...>;
+
+// ############################################################################
+// Util: Expression Construction
+// ############################################################################
+/**
+ * String literals are stored as std::string, such that the expression does not refer to
+ * external memory and a string column is compared without converting the literal per row.
+*/
+template <typename T>
+using GetLiteralType = std::conditional_t<
+    std::is_same_v<std::decay_t<T>, const char*> || std::is_same_v<std::decay_t<T>, char*>,
+    std::string,
+    std::decay_t<T>
+>;
+
+template <typename T>
+auto toOperand (T&& value) {
+    if constexpr (IsColumnReference<T>) {
+        return std::remove_cvref_t<T>{};
+    }
+    else {
+        return Literal<GetLiteralType<T>>{std::forward<T>(value)};
+    }
+}
+
+template <typename Lhs, typename Rhs>
+concept AreComparisonOperands = (
+    (IsColumnReference<Lhs> || IsColumnReference<Rhs>) &&
+    not IsExpression<Lhs> &&
+    not IsExpression<Rhs>
+);
+
+template <typename Op, typename Lhs, typename Rhs>
+auto makeComparison (Lhs&& lhs, Rhs&& rhs) {
+    using LhsOperand = decltype(toOperand(std::forward<Lhs>(lhs)));
+    using RhsOperand = decltype(toOperand(std::forward<Rhs>(rhs)));
+    return Comparison<Op, LhsOperand, RhsOperand>{toOperand(std::forward<Lhs>(lhs)), toOperand(std::forward<Rhs>(rhs))};
+}
+
+template <typename Lhs, typename Rhs>
+requires (AreComparisonOperands<Lhs, Rhs>)
+auto operator== (Lhs&& lhs, Rhs&& rhs) {
+    return makeComparison<EqualOp>(std::forward<Lhs>(lhs), std::forward<Rhs>(rhs));
+}
+
+template <typename Lhs, typename Rhs>
+requires (AreComparisonOperands<Lhs, Rhs>)
+auto operator!= (Lhs&& lhs, Rhs&& rhs) {
+    return makeComparison<NotEqualOp>(std::forward<Lhs>(lhs), std::forward<Rhs>(rhs));
+}
+
+template <typename Lhs, typename Rhs>
+requires (AreComparisonOperands<Lhs, Rhs>)
+auto operator< (Lhs&& lhs, Rhs&& rhs) {
+    return makeComparison<LessOp>(std::forward<Lhs>(lhs), std::forward<Rhs>(rhs));
+}
+
+template <typename Lhs, typename Rhs>
+requires (AreComparisonOperands<Lhs, Rhs>)
+auto operator<= (Lhs&& lhs, Rhs&& rhs) {
+    return makeComparison<LessEqualOp>(std::forward<Lhs>(lhs), std::forward<Rhs>(rhs));
+}
+
+template <typename Lhs, typename Rhs>
+requires (AreComparisonOperands<Lhs, Rhs>)
+auto operator> (Lhs&& lhs, Rhs&& rhs) {
+    return makeComparison<GreaterOp>(std::forward<Lhs>(lhs), std::forward<Rhs>(rhs));
+}
+
+template <typename Lhs, typename Rhs>
+requires (AreComparisonOperands<Lhs, Rhs>)
+auto operator>= (Lhs&& lhs, Rhs&& rhs) {
+    return makeComparison<GreaterEqualOp>(std::forward<Lhs>(lhs), std::forward<Rhs>(rhs));
+}
+
+template <IsExpression Lhs, IsExpression Rhs>
+auto operator&& (Lhs&& lhs, Rhs&& rhs) {
+    return Conjunction<std::remove_cvref_t<Lhs>, std::remove_cvref_t<Rhs>>{std::forward<Lhs>(lhs), std::forward<Rhs>(rhs)};
+}
+
+template <IsExpression Lhs, IsExpression Rhs>
+auto operator|| (Lhs&& lhs, Rhs&& rhs) {
+    return Disjunction<std::remove_cvref_t<Lhs>, std::remove_cvref_t<Rhs>>{std::forward<Lhs>(lhs), std::forward<Rhs>(rhs)};
+}
+
+template <IsExpression Operand>
+auto operator! (Operand&& operand) {
+    return Negation<std::remove_cvref_t<Operand>>{std::forward<Operand>(operand)};
+}
+
+} // namespace internal
+
+/**
+ * Reference to a column by name in a predicate expression, e.g. col<"age"> > 30 && col<"city"> == "Berlin".
+*/
+template <FixedString Name>
+inline constexpr internal::ColumnReference<Name> col{};
+
+namespace internal {
+
+// ############################################################################
+// Util: Expression Evaluation
+// ############################################################################
+/**
+ * One byte per row being 1 if the row satisfies the expression, otherwise 0.
+*/
+using ExpressionMask = std::vector<std::uint8_t>;
+
+template <FixedString Name, typename ColumnStoreData, typename ...Columns>
+const auto& getReferencedColumn (const ColumnStoreData& column_store_data, TypeList<Columns...>) {
+    return std::get<get_column_index_by_name<Name, Columns...>>(column_store_data);
+}
+
+template <typename T>
+struct RemoveOptionalValueImpl {
+    using type = T;
+};
+
+template <typename T>
+struct RemoveOptionalValueImpl<std::optional<T>> {
+    using type = T;
+};
+
+template <typename T>
+using RemoveOptionalValue = typename RemoveOptionalValueImpl<T>::type;
+
+template <typename T>
+constexpr bool is_optional_value = not std::is_same_v<T, RemoveOptionalValue<T>>;
+
+/**
+ * Missing values (e.g. in columns of outer joins) never satisfy a comparison.
+*/
+template <typename Op>
+struct SkipMissingValuesOp {
+    template <typename L, typename R>
+    bool operator() (const L& lhs, const R& rhs) const {
+        if constexpr (is_optional_value<L>) {
+            return lhs.has_value() && (*this)(*lhs, rhs);
+        }
+        else if constexpr (is_optional_value<R>) {
+            return rhs.has_value() && (*this)(lhs, *rhs);
+        }
+        else {
+            return Op{}(lhs, rhs);
+        }
+    }
+};
+
+/**
+ * The literal is converted once into the type of a non-arithmetic column (e.g. std::string),
+ * arithmetic columns are compared with the usual arithmetic conversions. String literals are not
+ * converted for Categorical columns, such that the literal is not added to the dictionary.
+*/
+template <typename ColumnType, typename T>
+decltype(auto) convertLiteralForColumn (const T& value) {
+    if constexpr (
+        std::is_arithmetic_v<ColumnType> || std::is_same_v<ColumnType, T> || not std::is_constructible_v<ColumnType, const T&> ||
+        (std::is_same_v<ColumnType, Categorical> && IsStringLike<T>)
+    ) {
+        return (value);
+    }
+    else {
+        return ColumnType(value);
+    }
+}
+
+/**
+ * Compares a Categorical column with a string literal on integers, without adding the literal to the
+ * dictionary: equality compares the codes, orderings compare the ranks of the distinct codes of the
+ * column with the rank the literal would have among them.
+*/
+template <typename Container, typename T, typename Op>
+void compareCategoricalContainerWithString (const Container& container, const T& value, Op operation, ExpressionMask& mask) {
+    const std::string_view literal {value};
+    auto compare_rows = [&](auto get_key, auto literal_key) {
+        for (std::size_t row_index = 0; row_index < container.size(); ++row_index) {
+            const Categorical* categorical = getCategoricalValue(container[row_index]);
+            mask[row_index] = static_cast<std::uint8_t>(categorical != nullptr && operation(get_key(*categorical), literal_key));
+        }
+    };
+    if constexpr (std::is_same_v<Op, EqualOp> || std::is_same_v<Op, NotEqualOp>) {
+        if (const auto literal_code = getCategoricalDictionary().find(literal); literal_code.has_value()) {
+            compare_rows([](const Categorical& categorical) { return categorical.getCode(); }, *literal_code);
+        }
+        else {
+            // a literal missing in the dictionary differs from all values
+            compare_rows([](const Categorical&) { return 0U; }, 1U);
+        }
+    }
+    else {
+        // the values have odd keys, the literal has the key of an equal value or the even key in between its neighbours
+        const auto ranks = rankCategoricalCodes(container, container.size());
+        std::uint64_t literal_key {0};
+        for (const auto& [code, rank] : ranks) {
+            const auto comparison = getCategoricalDictionary().decode(code) <=> literal;
+            literal_key += comparison < 0 ? 2 : (comparison == 0 ? 1 : 0);
+        }
+        compare_rows([&ranks](const Categorical& categorical) {
+            return 2 * static_cast<std::uint64_t>(ranks.find(categorical.getCode())->second) + 1;
+        }, literal_key);
+    }
+}
+
+template <typename Container, typename T, typename Op>
+void compareContainerWithValue (const Container& container, const T& value, Op operation, ExpressionMask& mask) {
+    using ValueType = typename Container::value_type;
+    const auto& converted_value = convertLiteralForColumn<RemoveOptionalValue<ValueType>>(value);
+    if constexpr (std::is_same_v<RemoveOptionalValue<ValueType>, Categorical> && IsStringLike<T>) {
+        compareCategoricalContainerWithString(container, value, operation, mask);
+    }
+    else if constexpr (std::ranges::contiguous_range<Container> && not is_optional_value<ValueType>) {
+        compareColumnWithValue(container.data(), container.size(), converted_value, operation, mask.data());
+    }
+    else {
+        for (std::size_t row_index = 0; row_index < container.size(); ++row_index) {
+            mask[row_index] = static_cast<std::uint8_t>(SkipMissingValuesOp<Op>{}(container[row_index], converted_value));
+        }
+    }
+}
+
+template <typename ContainerLhs, typename ContainerRhs, typename Op>
+void compareContainers (const ContainerLhs& lhs, const ContainerRhs& rhs, Op, ExpressionMask& mask) {
+    if constexpr (std::ranges::contiguous_range<ContainerLhs> && std::ranges::contiguous_range<ContainerRhs>) {
+        compareColumns(lhs.data(), rhs.data(), lhs.size(), SkipMissingValuesOp<Op>{}, mask.data());
+    }
+    else {
+        for (std::size_t row_index = 0; row_index < lhs.size(); ++row_index) {
+            mask[row_index] = static_cast<std::uint8_t>(SkipMissingValuesOp<Op>{}(lhs[row_index], rhs[row_index]));
+        }
+    }
+}
+
+/**
+ * Evaluates the expression column-at-a-time: each comparison runs a comparison kernel over
+ * a full column and the logical operations combine the resulting masks.
+*/
+template <typename ColumnStoreData, typename ...Columns>
+void evaluateExpressionIntoMask (const Tautology&, const ColumnStoreData&, ExpressionMask& mask, TypeList<Columns...>) {
+    std::fill(mask.begin(), mask.end(), std::uint8_t{1});
+}
+
+template <typename Op, typename Lhs, typename Rhs, typename ColumnStoreData, typename ...Columns>
+void evaluateExpressionIntoMask (const Comparison<Op, Lhs, Rhs>& expression, const ColumnStoreData& column_store_data, ExpressionMask& mask, TypeList<Columns...> columns) {
+    if constexpr (IsColumnReference<Lhs> && IsColumnReference<Rhs>) {
+        compareContainers(
+            getReferencedColumn<Lhs::NAME>(column_store_data, columns),
+            getReferencedColumn<Rhs::NAME>(column_store_data, columns),
+            Op{},
+            mask
+        );
+    }
+    else if constexpr (IsColumnReference<Lhs>) {
+        compareContainerWithValue(getReferencedColumn<Lhs::NAME>(column_store_data, columns), expression.rhs.value, Op{}, mask);
+    }
+    else {
+        compareContainerWithValue(getReferencedColumn<Rhs::NAME>(column_store_data, columns), expression.lhs.value, typename Op::Mirrored{}, mask);
+    }
+}
+
+template <typename Lhs, typename Rhs, typename ColumnStoreData, typename ...Columns>
+void evaluateExpressionIntoMask (const Conjunction<Lhs, Rhs>& expression, const ColumnStoreData& column_store_data, ExpressionMask& mask, TypeList<Columns...> columns) {
+    evaluateExpressionIntoMask(expression.lhs, column_store_data, mask, columns);
+    ExpressionMask rhs_mask(mask.size());
+    evaluateExpressionIntoMask(expression.rhs, column_store_data, rhs_mask, columns);
+    andMasks(mask.data(), rhs_mask.data(), mask.size());
+}
+
+template <typename Lhs, typename Rhs, typename ColumnStoreData, typename ...Columns>
+void evaluateExpressionIntoMask (const Disjunction<Lhs, Rhs>& expression, const ColumnStoreData& column_store_data, ExpressionMask& mask, TypeList<Columns...> columns) {
+    evaluateExpressionIntoMask(expression.lhs, column_store_data, mask, columns);
+    ExpressionMask rhs_mask(mask.size());
+    evaluateExpressionIntoMask(expression.rhs, column_store_data, rhs_mask, columns);
+    orMasks(mask.data(), rhs_mask.data(), mask.size());
+}
+
+template <typename Operand, typename ColumnStoreData, typename ...Columns>
+void evaluateExpressionIntoMask (const Negation<Operand>& expression, const ColumnStoreData& column_store_data, ExpressionMask& mask, TypeList<Columns...> columns) {
+    evaluateExpressionIntoMask(expression.operand, column_store_data, mask, columns);
+    invertMask(mask.data(), mask.size());
+}
+
+template <IsExpression Expr, typename ColumnStoreData, typename ...Columns>
+ExpressionMask evaluateExpression (const Expr& expression, const ColumnStoreData& column_store_data, std::size_t size, TypeList<Columns...> columns) {
+    ExpressionMask mask(size);
+    evaluateExpressionIntoMask(expression, column_store_data, mask, columns);
+    return mask;
+}
+
+// ############################################################################
+// Util: Row-Wise Expression Evaluation
+// ############################################################################
+/**
+ * Evaluates the expression for a single row accessed by get<"name">() (e.g. a RowView), such that
+ * the expression is fused with other row-wise operations.
+*/
+template <typename Row>
+bool evaluateExpressionOnRow (const Tautology&, const Row&) {
+    return true;
+}
+
+template <typename Op, typename Lhs, typename Rhs, typename Row>
+bool evaluateExpressionOnRow (const Comparison<Op, Lhs, Rhs>& expression, const Row& row) {
+    if constexpr (IsColumnReference<Lhs> && IsColumnReference<Rhs>) {
+        return SkipMissingValuesOp<Op>{}(row.template get<Lhs::NAME>(), row.template get<Rhs::NAME>());
+    }
+    else if constexpr (IsColumnReference<Lhs>) {
+        const auto& value = row.template get<Lhs::NAME>();
+        using ValueType = RemoveOptionalValue<std::remove_cvref_t<decltype(value)>>;
+        return SkipMissingValuesOp<Op>{}(value, convertLiteralForColumn<ValueType>(expression.rhs.value));
+    }
+    else {
+        const auto& value = row.template get<Rhs::NAME>();
+        using ValueType = RemoveOptionalValue<std::remove_cvref_t<decltype(value)>>;
+        return SkipMissingValuesOp<typename Op::Mirrored>{}(value, convertLiteralForColumn<ValueType>(expression.lhs.value));
+    }
+}
+
+template <typename Lhs, typename Rhs, typename Row>
+bool evaluateExpressionOnRow (const Conjunction<Lhs, Rhs>& expression, const Row& row) {
+    return evaluateExpressionOnRow(expression.lhs, row) && evaluateExpressionOnRow(expression.rhs, row);
+}
+
+template <typename Lhs, typename Rhs, typename Row>
+bool evaluateExpressionOnRow (const Disjunction<Lhs, Rhs>& expression, const Row& row) {
+    return evaluateExpressionOnRow(expression.lhs, row) || evaluateExpressionOnRow(expression.rhs, row);
+}
+
+template <typename Operand, typename Row>
+bool evaluateExpressionOnRow (const Negation<Operand>& expression, const Row& row) {
+    return not evaluateExpressionOnRow(expression.operand, row);
+}
+
+// ############################################################################
+// Util: Mask To Selection
+// ############################################################################
+/**
+ * Converts the mask into a selection. The row indices are written without branches into a
+ * vector sized by counting the mask first (plus one slot for the trailing unselected rows).
+*/
+inline Selection toSelection (const ExpressionMask& mask) {
+    std::vector<std::size_t> row_indices(countMask(mask.data(), mask.size()) + 1);
+    std::size_t num_selected_rows {0};
+    for (std::size_t row_index = 0; row_index < mask.size(); ++row_index) {
+        row_indices[num_selected_rows] = row_index;
+        num_selected_rows += mask[row_index];
+    }
+    row_indices.pop_back();
+    return Selection{std::move(row_indices), mask.size()};
+}
+
+/**
+ * Returns the subset of the selection whose rows are set in the mask.
+*/
+inline Selection toSelection (const ExpressionMask& mask, const Selection& selection) {
+    std::vector<std::size_t> row_indices{};
+    for (auto row_index : selection.getRowIndices()) {
+        if (mask[row_index]) {
+            row_indices.push_back(row_index);
+        }
+    }
+    return Selection{std::move(row_indices), selection.getNumberOfRows()};
+}
+
+// ############################################################################
+// Util: Conjunction Splitting
+// ############################################################################
+template <typename>
+struct IsConjunctionImpl : std::false_type {};
+
+template <typename Lhs, typename Rhs>
+struct IsConjunctionImpl<Conjunction<Lhs, Rhs>> : std::true_type {};
+
+/**
+ * Splits the top-level conjunctions of the expression into a tuple of expressions, such that
+ * each part may be evaluated (or pushed down) independently.
+*/
+template <IsExpression Expr>
+auto splitConjunctions (const Expr& expression) {
+    if constexpr (std::is_same_v<Expr, Tautology>) {
+        return std::tuple<>{};
+    }
+    else if constexpr (IsConjunctionImpl<Expr>::value) {
+        return std::tuple_cat(splitConjunctions(expression.lhs), splitConjunctions(expression.rhs));
+    }
+    else {
+        return std::tuple<Expr>{expression};
+    }
+}
+
+template <typename ...Exprs>
+auto combineConjunctions (const std::tuple<Exprs...>& conjunctions) {
+    return std::apply([](const auto& ...expressions) {
+        if constexpr (sizeof...(Exprs) == 0) {
+            return Tautology{};
+        }
+        else {
+            return (... && expressions);
+        }
+    }, conjunctions);
+}
+
+template <typename Filter, typename Expr>
+auto filterConjunction (const Expr& expression) {
+    if constexpr (Filter::template value<Expr>) {
+        return std::tuple<Expr>{expression};
+    }
+    else {
+        return std::tuple<>{};
+    }
+}
+
+template <typename Filter, typename ...Exprs, std::size_t ...Indices>
+auto filterConjunctionsImpl (const std::tuple<Exprs...>& conjunctions, std::index_sequence<Indices...>) {
+    return std::tuple_cat(filterConjunction<Filter>(std::get<Indices>(conjunctions))...);
+}
+
+/**
+ * Returns the conjunctions for which Filter::value<Expr> is true.
+*/
+template <typename Filter, typename ...Exprs>
+auto filterConjunctions (const std::tuple<Exprs...>& conjunctions) {
+    return filterConjunctionsImpl<Filter>(conjunctions, std::index_sequence_for<Exprs...>{});
+}
+
+// ############################################################################
+// Trait: Join Pushdown
+// ############################################################################
+/**
+ * Decides for each conjunction of a join filter whether it is evaluated on the left or right
+ * DataFrame before joining, or on the joined DataFrame (residual).
+ *
+ * A conjunction is pushed to a side if it references only columns of this side and the side
+ * is not extended by unmatched rows of the other side. Conjunctions on join columns only are
+ * pushed to both sides, because the join columns are equal in each joined row. Semi and anti
+ * joins keep only the left columns, hence all conjunctions must be pushed to one of the sides:
+ * a conjunction on the right columns restricts the right rows a left row is matched with.
+*/
+template <Join JoinType, typename JoinNames, typename NamesLeft, typename NamesRight>
+struct JoinPushdown {
+    template <typename Expr>
+    static constexpr bool is_pushed_left = are_names_in_name_list<GetExpressionNames<Expr>, NamesLeft> && (
+        are_names_in_name_list<GetExpressionNames<Expr>, JoinNames> || not keeps_unmatched_right_rows<JoinType>
+    );
+
+    template <typename Expr>
+    static constexpr bool is_pushed_right = are_names_in_name_list<GetExpressionNames<Expr>, NamesRight> && (
+        are_names_in_name_list<GetExpressionNames<Expr>, JoinNames> || JoinType == Join::Inner || JoinType == Join::Right ||
+        is_filtering_join<JoinType>
+    );
+
+    template <typename Conjunctions>
+    static constexpr bool is_valid_filter = []<typename ...Exprs>(std::type_identity<std::tuple<Exprs...>>) {
+        return not is_filtering_join<JoinType> || (... && (is_pushed_left<Exprs> || is_pushed_right<Exprs>));
+    }(std::type_identity<Conjunctions>{});
+
+    struct Left {
+        template <typename Expr>
+        static constexpr bool value = is_pushed_left<Expr>;
+    };
+
+    struct Right {
+        template <typename Expr>
+        static constexpr bool value = is_pushed_right<Expr>;
+    };
+
+    struct Residual {
+        template <typename Expr>
+        static constexpr bool value = not is_pushed_left<Expr> && not is_pushed_right<Expr>;
+    };
+};
+
+template <Join JoinType, typename JoinNames, typename NamesLeft, typename NamesRight, IsExpression Expr>
+constexpr bool is_valid_join_filter = JoinPushdown<JoinType, JoinNames, NamesLeft, NamesRight>::template is_valid_filter<
+    decltype(splitConjunctions(std::declval<const Expr&>()))
+>;
+
+/**
+ * Returns the DataFrame itself for a tautology, otherwise the DataFrame queried by the expression.
+*/
+template <typename DataFrameType, IsExpression Expr>
+decltype(auto) queryUnlessTautology (DataFrameType& df, const Expr& expression) {
+    if constexpr (std::is_same_v<Expr, Tautology>) {
+        return (df);
+    }
+    else {
+        return df.query(expression);
+    }
+}
+
+} // namespace internal
+
+} // namespace dacr
+
+#endif // DATA_CRUNCHING_INTERNAL_DATAFRAME_EXPRESSION_HPP
@@ -15,12 +15,15 @@
 #ifndef DATA_CRUNCHING_INTERNAL_DATAFRAME_HPP
 #define DATA_CRUNCHING_INTERNAL_DATAFRAME_HPP
 
+#include <array>
 #include <tuple>
+#include <vector>
 
 #include "data_crunching/namedtuple.hpp"
 #include "data_crunching/internal/column.hpp"
 #include "data_crunching/internal/name_list.hpp"
 #include "data_crunching/internal/fixed_string.hpp"
+#include "data_crunching/internal/shared_column.hpp"
 #include "data_crunching/internal/type_list.hpp"
 #include "data_crunching/internal/utils.hpp"
 
@@ -33,10 +36,6 @@ requires (
 )
 class DataFrame;
 
-enum class Join : int {
-    Inner = 0,
-};
-
 namespace internal {
 
 // ############################################################################
@@ -87,9 +86,10 @@ requires (
     }
 )
 inline void insertRangeIntoContainerImpl (Container& container, std::size_t element_count, Range&& range) {
+    auto& values = getMutableValues(container);
     auto iterator = std::forward<Range>(range).begin();
     for (auto i = 0L; i < element_count; ++i) {
-        container.push_back(*iterator);
+        values.push_back(*iterator);
         ++iterator;
     }
 }
@@ -99,6 +99,18 @@ inline void insertRangesIntoContainers (ColumnStoreData& column_store_data, std:
     ((insertRangeIntoContainerImpl(std::get<Indices>(column_store_data), element_count, std::forward<Ranges>(ranges))), ...);
 }
 
+// ############################################################################
+// Util: Gather Rows Into Container
+// ############################################################################
+template <typename Container, typename SourceContainer>
+inline void gatherIntoContainer (Container& container, const SourceContainer& source, const std::vector<std::size_t>& row_indices) {
+    auto& values = getMutableValues(container);
+    values.reserve(values.size() + row_indices.size());
+    for (auto row_index : row_indices) {
+        values.push_back(source[row_index]);
+    }
+}
+
 // ############################################################################
 // Trait: Prepend DataFrame
 // ############################################################################
@@ -174,6 +186,60 @@ struct ConstructNamedTupleImpl<NameList<Names...>, TypeList<Types...>> {
 template <typename Names, typename Types>
 using ConstructNamedTuple = typename ConstructNamedTupleImpl<Names, Types>::type;
 
+// ############################################################################
+// Class: Row View
+// ############################################################################
+template <FixedString NameToSearch, FixedString ...Names>
+consteval std::size_t getNamePosition () {
+    constexpr std::array<bool, sizeof...(Names)> is_equal {areFixedStringsEqual(NameToSearch, Names)...};
+    std::size_t position {0};
+    while (position < is_equal.size() && not is_equal[position]) {
+        ++position;
+    }
+    return position;
+}
+
+template <typename ColumnStoreData, typename Names, typename Indices>
+class RowView {};
+
+/**
+ * Read-only view of the selected columns of a single row in the column store.
+ *
+ * The view provides the same get<"name">() access as the NamedTuple, but returns const references
+ * into the column store instead of copies. It is converted to the NamedTuple on demand.
+*/
+template <typename ColumnStoreData, FixedString ...Names, std::size_t ...Indices>
+class RowView<ColumnStoreData, NameList<Names...>, std::integer_sequence<std::size_t, Indices...>> {
+public:
+    RowView (const ColumnStoreData& column_store_data, std::size_t row_index) : column_store_data_{&column_store_data}, row_index_{row_index} {}
+
+    template <FixedString FieldName>
+    requires (is_name_in_name_list<FieldName, NameList<Names...>>)
+    decltype(auto) get () const {
+        constexpr std::array<std::size_t, sizeof...(Indices)> column_indices {Indices...};
+        return std::get<column_indices[getNamePosition<FieldName, Names...>()]>(*column_store_data_)[row_index_];
+    }
+
+    template <std::size_t Index>
+    requires (Index < sizeof...(Indices))
+    decltype(auto) get () const {
+        constexpr std::array<std::size_t, sizeof...(Indices)> column_indices {Indices...};
+        return std::get<column_indices[Index]>(*column_store_data_)[row_index_];
+    }
+
+    std::size_t getRowIndex () const {
+        return row_index_;
+    }
+
+    operator NamedTuple<Field<Names, typename std::tuple_element_t<Indices, ColumnStoreData>::value_type>...> () const {
+        return {std::get<Indices>(*column_store_data_)[row_index_]...};
+    }
+
+private:
+    const ColumnStoreData* column_store_data_;
+    std::size_t row_index_;
+};
+
 // ############################################################################
 // Trait: Construct DataFrame For Apply
 // ############################################################################
@@ -0,0 +1,852 @@
+// Copyright 2022 Andi Hellmund
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef DATA_CRUNCHING_INTERNAL_DATAFRAME_JOIN_HPP
+#define DATA_CRUNCHING_INTERNAL_DATAFRAME_JOIN_HPP
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "data_crunching/internal/column.hpp"
+#include "data_crunching/internal/hash.hpp"
+#include "data_crunching/internal/name_list.hpp"
+#include "data_crunching/internal/parallel.hpp"
+#include "data_crunching/internal/shared_column.hpp"
+#include "data_crunching/internal/type_list.hpp"
+
+namespace dacr {
+
+enum class Join : int {
+    Inner = 0,
+    Left,
+    Right,
+    Outer,
+    Semi,
+    Anti,
+};
+
+/**
+ * Join strategy building a hash table on the smaller DataFrame (default).
+*/
+struct HashJoin {};
+
+/**
+ * Join strategy streaming through both DataFrames in one pass.
+ * Both DataFrames must be sorted ascending by the join columns.
+*/
+struct SortMergeJoin {};
+
+/**
+ * Join strategy radix-partitioning both DataFrames by the hash of the join columns
+ * and joining the partitions in parallel.
+ * The rows of the result are grouped by partition, i.e. not ordered by the left DataFrame.
+*/
+struct PartitionedHashJoin {
+    std::size_t num_threads {0}; // zero uses the number of hardware threads
+};
+
+namespace internal {
+
+// ############################################################################
+// Concept: Is Join Strategy
+// ############################################################################
+template <typename T>
+concept IsJoinStrategy = std::is_same_v<T, HashJoin> || std::is_same_v<T, SortMergeJoin> || std::is_same_v<T, PartitionedHashJoin>;
+
+/**
+ * Row index marking a missing row of one side in an outer join.
+*/
+inline constexpr std::size_t NO_ROW_INDEX = std::numeric_limits<std::size_t>::max();
+
+// ############################################################################
+// Trait: Join Type Properties
+// ############################################################################
+template <Join JoinType>
+constexpr bool keeps_unmatched_left_rows = (JoinType == Join::Left || JoinType == Join::Outer);
+
+template <Join JoinType>
+constexpr bool keeps_unmatched_right_rows = (JoinType == Join::Right || JoinType == Join::Outer);
+
+template <Join JoinType>
+constexpr bool is_filtering_join = (JoinType == Join::Semi || JoinType == Join::Anti);
+
+// ############################################################################
+// Trait: Make Column Optional
+// ############################################################################
+template <typename>
+struct MakeColumnOptionalImpl {};
+
+template <FixedString ColName, typename ColType>
+struct MakeColumnOptionalImpl<Column<ColName, ColType>> {
+    using type = Column<ColName, std::optional<ColType>>;
+};
+
+template <FixedString ColName, typename ColType>
+struct MakeColumnOptionalImpl<Column<ColName, std::optional<ColType>>> {
+    using type = Column<ColName, std::optional<ColType>>;
+};
+
+template <typename Col>
+using MakeColumnOptional = typename MakeColumnOptionalImpl<Col>::type;
+
+// ############################################################################
+// Trait: Get Columns For Join
+// ############################################################################
+/**
+ * Wraps all columns not being a join column into std::optional if the side of the join
+ * may contain rows without a matching counterpart.
+*/
+template <bool MakeOptional, typename JoinNames, typename ...>
+struct GetColumnsForJoinImpl {
+    using type = TypeList<>;
+};
+
+template <bool MakeOptional, typename JoinNames, FixedString FirstColName, typename FirstColType, typename ...RestColumns>
+struct GetColumnsForJoinImpl<MakeOptional, JoinNames, Column<FirstColName, FirstColType>, RestColumns...> {
+    using type = TypeListPrepend<
+        std::conditional_t<
+            MakeOptional && !is_name_in_name_list<FirstColName, JoinNames>,
+            MakeColumnOptional<Column<FirstColName, FirstColType>>,
+            Column<FirstColName, FirstColType>
+        >,
+        typename GetColumnsForJoinImpl<MakeOptional, JoinNames, RestColumns...>::type
+    >;
+};
+
+template <bool MakeOptional, typename JoinNames, typename ...Columns>
+using GetColumnsForJoin = typename GetColumnsForJoinImpl<MakeOptional, JoinNames, Columns...>::type;
+
+// ############################################################################
+// Trait: Get Joined Columns
+// ############################################################################
+/**
+ * Columns of the joined DataFrame: the columns of the left DataFrame followed by the
+ * non-join columns of the right DataFrame (ColumnsRight). Semi and anti joins keep the
+ * left columns only.
+*/
+template <Join, typename, typename, typename>
+struct GetJoinedColumnsImpl {};
+
+template <Join JoinType, typename JoinNames, typename ...ColumnsLeft, typename ...ColumnsRight>
+struct GetJoinedColumnsImpl<JoinType, JoinNames, TypeList<ColumnsLeft...>, TypeList<ColumnsRight...>> {
+    using type = std::conditional_t<
+        is_filtering_join<JoinType>,
+        TypeList<ColumnsLeft...>,
+        TypeListMerge<
+            GetColumnsForJoin<keeps_unmatched_right_rows<JoinType>, JoinNames, ColumnsLeft...>,
+            GetColumnsForJoin<keeps_unmatched_left_rows<JoinType>, JoinNames, ColumnsRight...>
+        >
+    >;
+};
+
+template <Join JoinType, typename JoinNames, typename ColumnsLeft, typename ColumnsRight>
+using GetJoinedColumns = typename GetJoinedColumnsImpl<JoinType, JoinNames, ColumnsLeft, ColumnsRight>::type;
+
+// ############################################################################
+// Trait: Is Valid Join
+// ############################################################################
+/**
+ * The join columns must exist with the same types on both sides, all other column names must
+ * be unique across both sides.
+*/
+template <typename, typename, typename>
+constexpr bool is_valid_join = false;
+
+template <FixedString ...JoinNames, typename ...ColumnsLeft, typename ...ColumnsRight>
+constexpr bool is_valid_join<NameList<JoinNames...>, TypeList<ColumnsLeft...>, TypeList<ColumnsRight...>> = (
+    sizeof...(JoinNames) > 0 &&
+    are_names_unique<NameList<JoinNames...>> &&
+    are_names_in_columns<NameList<JoinNames...>, ColumnsLeft...> &&
+    are_names_in_columns<NameList<JoinNames...>, ColumnsRight...> &&
+    are_names_unique<
+        NameListMerge<
+            NameListDifference<GetColumnNames<ColumnsLeft...>, NameList<JoinNames...>>,
+            NameListDifference<GetColumnNames<ColumnsRight...>, NameList<JoinNames...>>
+        >
+    > &&
+    are_columns_the_same_in_two_lists_by_names<NameList<JoinNames...>, TypeList<ColumnsLeft...>, TypeList<ColumnsRight...>>
+);
+
+// ############################################################################
+// Class: Joined Row Indices
+// ############################################################################
+/**
+ * Pairs of row indices of the left and right DataFrame with each pair forming one
+ * row of the joined DataFrame.
+*/
+struct JoinedRowIndices {
+    std::vector<std::size_t> left{};
+    std::vector<std::size_t> right{};
+
+    std::size_t getSize () const {
+        return left.size();
+    }
+};
+
+// ############################################################################
+// Class: Hash Join Table
+// ############################################################################
+/**
+ * Hash table over the join keys of the build-side column store.
+ *
+ * The table stores only row indices (bucket heads and chain links) and the row hashes,
+ * such that the key data itself is never copied.
+*/
+template <typename ColumnStoreData, typename KeyIndices>
+class HashJoinTable {
+public:
+    HashJoinTable (const ColumnStoreData& column_store_data, std::size_t size) : column_store_data_{column_store_data} {
+        const std::size_t num_buckets = std::bit_ceil(std::max(size, std::size_t{1}));
+        bucket_mask_ = num_buckets - 1;
+        buckets_.assign(num_buckets, NO_ROW_INDEX);
+        next_.resize(size);
+        hashes_.resize(size);
+        // rows are inserted in reverse order such that the bucket chains yield ascending row indices
+        for (std::size_t row_index = size; row_index-- > 0;) {
+            const std::size_t hash = hashRow(column_store_data_, row_index, KeyIndices{});
+            auto& bucket = buckets_[hash & bucket_mask_];
+            hashes_[row_index] = hash;
+            next_[row_index] = bucket;
+            bucket = row_index;
+        }
+    }
+
+    template <typename ProbeColumnStoreData, typename ProbeKeyIndices, typename Func>
+    void forEachMatch (const ProbeColumnStoreData& probe_data, std::size_t probe_row_index, ProbeKeyIndices, Func&& function) const {
+        const std::size_t hash = hashRow(probe_data, probe_row_index, ProbeKeyIndices{});
+        for (auto row_index = buckets_[hash & bucket_mask_]; row_index != NO_ROW_INDEX; row_index = next_[row_index]) {
+            if (hashes_[row_index] == hash && areRowsEqual(column_store_data_, row_index, KeyIndices{}, probe_data, probe_row_index, ProbeKeyIndices{})) {
+                function(row_index);
+            }
+        }
+    }
+
+    template <typename ProbeColumnStoreData, typename ProbeKeyIndices>
+    bool containsMatch (const ProbeColumnStoreData& probe_data, std::size_t probe_row_index, ProbeKeyIndices) const {
+        const std::size_t hash = hashRow(probe_data, probe_row_index, ProbeKeyIndices{});
+        for (auto row_index = buckets_[hash & bucket_mask_]; row_index != NO_ROW_INDEX; row_index = next_[row_index]) {
+            if (hashes_[row_index] == hash && areRowsEqual(column_store_data_, row_index, KeyIndices{}, probe_data, probe_row_index, ProbeKeyIndices{})) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    const ColumnStoreData& column_store_data_;
+    std::size_t bucket_mask_{0};
+    std::vector<std::size_t> buckets_{};
+    std::vector<std::size_t> next_{};
+    std::vector<std::size_t> hashes_{};
+};
+
+// ############################################################################
+// Util: Order Joined Rows By Left Row Index
+// ############################################################################
+/**
+ * Reorders the joined rows by the left row index (counting sort, O(n + m)).
+ * The relative order of pairs with the same left row index is kept.
+ * Pairs without a left row must not be part of the joined rows.
+*/
+inline void orderJoinedRowsByLeftIndex (JoinedRowIndices& joined_rows, std::size_t left_size) {
+    std::vector<std::size_t> offsets(left_size + 1, 0);
+    for (auto left_index : joined_rows.left) {
+        ++offsets[left_index + 1];
+    }
+    for (std::size_t i = 1; i < offsets.size(); ++i) {
+        offsets[i] += offsets[i - 1];
+    }
+    JoinedRowIndices ordered{};
+    ordered.left.resize(joined_rows.getSize());
+    ordered.right.resize(joined_rows.getSize());
+    for (std::size_t i = 0; i < joined_rows.getSize(); ++i) {
+        const std::size_t target = offsets[joined_rows.left[i]]++;
+        ordered.left[target] = joined_rows.left[i];
+        ordered.right[target] = joined_rows.right[i];
+    }
+    joined_rows = std::move(ordered);
+}
+
+// ############################################################################
+// Util: Add Unmatched Rows
+// ############################################################################
+inline void addUnmatchedRightRows (JoinedRowIndices& joined_rows, const std::vector<char>& is_matched_right) {
+    for (std::size_t right_index = 0; right_index < is_matched_right.size(); ++right_index) {
+        if (not is_matched_right[right_index]) {
+            joined_rows.left.push_back(NO_ROW_INDEX);
+            joined_rows.right.push_back(right_index);
+        }
+    }
+}
+
+// ############################################################################
+// Util: Hash Join
+// ############################################################################
+/**
+ * Computes the rows of the joined column stores by a build/probe hash join.
+ *
+ * The hash table is built on the smaller of both inputs while the larger one is probed.
+ * The result is ordered by the left row index and, for equal left rows, by the right row index.
+ * Right rows without a match (right and outer join) are appended in their original order.
+ * Semi and anti joins only fill the left row indices and never materialize the join product.
+*/
+template <Join JoinType, typename ColumnStoreDataLeft, typename ColumnStoreDataRight, typename KeyIndicesLeft, typename KeyIndicesRight>
+JoinedRowIndices hashJoin (const ColumnStoreDataLeft& left, std::size_t left_size, const ColumnStoreDataRight& right, std::size_t right_size, KeyIndicesLeft, KeyIndicesRight) {
+    JoinedRowIndices joined_rows{};
+
+    if (right_size <= left_size) {
+        HashJoinTable<ColumnStoreDataRight, KeyIndicesRight> table{right, right_size};
+        if constexpr (is_filtering_join<JoinType>) {
+            for (std::size_t left_index = 0; left_index < left_size; ++left_index) {
+                if (table.containsMatch(left, left_index, KeyIndicesLeft{}) == (JoinType == Join::Semi)) {
+                    joined_rows.left.push_back(left_index);
+                }
+            }
+        }
+        else {
+            std::vector<char> is_matched_right(keeps_unmatched_right_rows<JoinType> ? right_size : 0, false);
+            for (std::size_t left_index = 0; left_index < left_size; ++left_index) {
+                bool is_matched_left {false};
+                table.forEachMatch(left, left_index, KeyIndicesLeft{}, [&](std::size_t right_index) {
+                    joined_rows.left.push_back(left_index);
+                    joined_rows.right.push_back(right_index);
+                    is_matched_left = true;
+                    if constexpr (keeps_unmatched_right_rows<JoinType>) {
+                        is_matched_right[right_index] = true;
+                    }
+                });
+                if (keeps_unmatched_left_rows<JoinType> && not is_matched_left) {
+                    joined_rows.left.push_back(left_index);
+                    joined_rows.right.push_back(NO_ROW_INDEX);
+                }
+            }
+            if constexpr (keeps_unmatched_right_rows<JoinType>) {
+                addUnmatchedRightRows(joined_rows, is_matched_right);
+            }
+        }
+    }
+    else {
+        HashJoinTable<ColumnStoreDataLeft, KeyIndicesLeft> table{left, left_size};
+        std::vector<char> is_matched_left(left_size, false);
+        std::vector<char> is_matched_right(keeps_unmatched_right_rows<JoinType> ? right_size : 0, false);
+        for (std::size_t right_index = 0; right_index < right_size; ++right_index) {
+            table.forEachMatch(right, right_index, KeyIndicesRight{}, [&](std::size_t left_index) {
+                is_matched_left[left_index] = true;
+                if constexpr (not is_filtering_join<JoinType>) {
+                    joined_rows.left.push_back(left_index);
+                    joined_rows.right.push_back(right_index);
+                }
+                if constexpr (keeps_unmatched_right_rows<JoinType>) {
+                    is_matched_right[right_index] = true;
+                }
+            });
+        }
+
+        if constexpr (is_filtering_join<JoinType>) {
+            for (std::size_t left_index = 0; left_index < left_size; ++left_index) {
+                if (static_cast<bool>(is_matched_left[left_index]) == (JoinType == Join::Semi)) {
+                    joined_rows.left.push_back(left_index);
+                }
+            }
+        }
+        else {
+            if constexpr (keeps_unmatched_left_rows<JoinType>) {
+                for (std::size_t left_index = 0; left_index < left_size; ++left_index) {
+                    if (not is_matched_left[left_index]) {
+                        joined_rows.left.push_back(left_index);
+                        joined_rows.right.push_back(NO_ROW_INDEX);
+                    }
+                }
+            }
+            orderJoinedRowsByLeftIndex(joined_rows, left_size);
+            if constexpr (keeps_unmatched_right_rows<JoinType>) {
+                addUnmatchedRightRows(joined_rows, is_matched_right);
+            }
+        }
+    }
+    return joined_rows;
+}
+
+// ############################################################################
+// Util: Compare Rows By Join Keys
+// ############################################################################
+/**
+ * Three-way comparison of the join keys of two rows using operator< only.
+*/
+template <typename ColumnStoreDataLhs, typename ColumnStoreDataRhs, std::size_t FirstIndexLhs, std::size_t ...RestIndicesLhs, std::size_t FirstIndexRhs, std::size_t ...RestIndicesRhs>
+inline int compareRowsByKeys (
+    const ColumnStoreDataLhs& lhs, std::size_t row_index_lhs, std::integer_sequence<std::size_t, FirstIndexLhs, RestIndicesLhs...>,
+    const ColumnStoreDataRhs& rhs, std::size_t row_index_rhs, std::integer_sequence<std::size_t, FirstIndexRhs, RestIndicesRhs...>
+) {
+    const auto& value_lhs = std::get<FirstIndexLhs>(lhs)[row_index_lhs];
+    const auto& value_rhs = std::get<FirstIndexRhs>(rhs)[row_index_rhs];
+    if (value_lhs < value_rhs) {
+        return -1;
+    }
+    if (value_rhs < value_lhs) {
+        return 1;
+    }
+    if constexpr (sizeof...(RestIndicesLhs) > 0) {
+        return compareRowsByKeys(
+            lhs, row_index_lhs, std::integer_sequence<std::size_t, RestIndicesLhs...>{},
+            rhs, row_index_rhs, std::integer_sequence<std::size_t, RestIndicesRhs...>{}
+        );
+    }
+    else {
+        return 0;
+    }
+}
+
+/**
+ * Returns the end of the group of rows with keys equal to the row at row_index and
+ * verifies that the rows are sorted ascending up to the end of the group.
+*/
+template <typename ColumnStoreData, typename KeyIndices>
+inline std::size_t findEndOfKeyGroup (const ColumnStoreData& column_store_data, std::size_t row_index, std::size_t size, KeyIndices) {
+    std::size_t end_index = row_index + 1;
+    while (end_index < size) {
+        const int comparison = compareRowsByKeys(column_store_data, row_index, KeyIndices{}, column_store_data, end_index, KeyIndices{});
+        if (comparison > 0) {
+            throw std::invalid_argument("sort-merge join requires DataFrames sorted ascending by the join columns");
+        }
+        if (comparison < 0) {
+            break;
+        }
+        ++end_index;
+    }
+    return end_index;
+}
+
+// ############################################################################
+// Util: Sort-Merge Join
+// ############################################################################
+/**
+ * Computes the rows of the joined column stores by a single pass through both inputs.
+ *
+ * Both inputs must be sorted ascending by the join keys, otherwise std::invalid_argument
+ * is thrown. Except for the result, only constant extra memory is used.
+ * The order of the result is identical to the one of the hash join: the unmatched right rows
+ * (of right and outer joins) follow all other rows and are found by a second pass over the keys.
+*/
+template <Join JoinType, typename ColumnStoreDataLeft, typename ColumnStoreDataRight, typename KeyIndicesLeft, typename KeyIndicesRight>
+JoinedRowIndices sortMergeJoin (const ColumnStoreDataLeft& left, std::size_t left_size, const ColumnStoreDataRight& right, std::size_t right_size, KeyIndicesLeft, KeyIndicesRight) {
+    JoinedRowIndices joined_rows{};
+
+    auto add_unmatched_left_rows = [&](std::size_t begin, std::size_t end) {
+        for (auto left_index = begin; left_index < end; ++left_index) {
+            if constexpr (JoinType == Join::Anti) {
+                joined_rows.left.push_back(left_index);
+            }
+            else if constexpr (keeps_unmatched_left_rows<JoinType>) {
+                joined_rows.left.push_back(left_index);
+                joined_rows.right.push_back(NO_ROW_INDEX);
+            }
+        }
+    };
+
+    // the end of a key group is only searched once the index moves past the previous group, such that
+    // each row is scanned once even if only one side advances (e.g. for one large group of equal keys)
+    std::size_t left_index {0};
+    std::size_t right_index {0};
+    std::size_t left_group_end {0};
+    std::size_t right_group_end {0};
+    while (left_index < left_size && right_index < right_size) {
+        if (left_group_end <= left_index) {
+            left_group_end = findEndOfKeyGroup(left, left_index, left_size, KeyIndicesLeft{});
+        }
+        if (right_group_end <= right_index) {
+            right_group_end = findEndOfKeyGroup(right, right_index, right_size, KeyIndicesRight{});
+        }
+        const int comparison = compareRowsByKeys(left, left_index, KeyIndicesLeft{}, right, right_index, KeyIndicesRight{});
+        if (comparison < 0) {
+            add_unmatched_left_rows(left_index, left_group_end);
+            left_index = left_group_end;
+        }
+        else if (comparison > 0) {
+            right_index = right_group_end;
+        }
+        else {
+            for (auto left_group_index = left_index; left_group_index < left_group_end; ++left_group_index) {
+                if constexpr (JoinType == Join::Semi) {
+                    joined_rows.left.push_back(left_group_index);
+                }
+                else if constexpr (not is_filtering_join<JoinType>) {
+                    for (auto right_group_index = right_index; right_group_index < right_group_end; ++right_group_index) {
+                        joined_rows.left.push_back(left_group_index);
+                        joined_rows.right.push_back(right_group_index);
+                    }
+                }
+            }
+            left_index = left_group_end;
+            right_index = right_group_end;
+        }
+    }
+    while (left_index < left_size) {
+        if (left_group_end <= left_index) {
+            left_group_end = findEndOfKeyGroup(left, left_index, left_size, KeyIndicesLeft{});
+        }
+        add_unmatched_left_rows(left_index, left_group_end);
+        left_index = left_group_end;
+    }
+    while (right_index < right_size) {
+        if (right_group_end <= right_index) {
+            right_group_end = findEndOfKeyGroup(right, right_index, right_size, KeyIndicesRight{});
+        }
+        right_index = right_group_end;
+    }
+
+    if constexpr (keeps_unmatched_right_rows<JoinType>) {
+        left_index = 0;
+        for (right_index = 0; right_index < right_size; right_index = right_group_end) {
+            right_group_end = findEndOfKeyGroup(right, right_index, right_size, KeyIndicesRight{});
+            while (left_index < left_size && compareRowsByKeys(left, left_index, KeyIndicesLeft{}, right, right_index, KeyIndicesRight{}) < 0) {
+                ++left_index;
+            }
+            if (left_index == left_size || compareRowsByKeys(left, left_index, KeyIndicesLeft{}, right, right_index, KeyIndicesRight{}) > 0) {
+                for (auto right_group_index = right_index; right_group_index < right_group_end; ++right_group_index) {
+                    joined_rows.left.push_back(NO_ROW_INDEX);
+                    joined_rows.right.push_back(right_group_index);
+                }
+            }
+        }
+    }
+    return joined_rows;
+}
+
+// ############################################################################
+// Class: Radix Partitioning
+// ############################################################################
+/**
+ * Row indices and row hashes of a column store grouped by the upper bits of the row hash.
+ *
+ * The rows of partition p are located in [offsets[p], offsets[p + 1]) in ascending order.
+*/
+struct RadixPartitioning {
+    std::vector<std::size_t> offsets{};
+    std::vector<std::size_t> rows{};
+    std::vector<std::size_t> hashes{};
+
+    std::span<const std::size_t> getRows (std::size_t partition) const {
+        return {rows.data() + offsets[partition], offsets[partition + 1] - offsets[partition]};
+    }
+
+    std::span<const std::size_t> getHashes (std::size_t partition) const {
+        return {hashes.data() + offsets[partition], offsets[partition + 1] - offsets[partition]};
+    }
+};
+
+/**
+ * Returns the partition of a hash value using its upper radix_bits bits.
+ * The lower bits stay available for the bucket selection in the hash tables.
+*/
+inline std::size_t getRadixPartition (std::size_t hash, std::size_t radix_bits) {
+    return radix_bits == 0 ? 0 : hash >> (std::numeric_limits<std::size_t>::digits - radix_bits);
+}
+
+/**
+ * Partitions the rows of a column store in two parallel passes: the first pass hashes
+ * the rows and counts the partition sizes per chunk, the second pass scatters the rows.
+*/
+template <typename ColumnStoreData, typename KeyIndices>
+RadixPartitioning radixPartitionRows (const ColumnStoreData& column_store_data, std::size_t size, KeyIndices, std::size_t radix_bits, std::size_t num_threads) {
+    const std::size_t num_partitions = std::size_t{1} << radix_bits;
+    const std::size_t num_chunks = std::max(std::min(num_threads, size), std::size_t{1});
+
+    std::vector<std::size_t> row_hashes(size);
+    std::vector<std::vector<std::size_t>> chunk_offsets(num_chunks, std::vector<std::size_t>(num_partitions, 0));
+    parallelFor(num_chunks, num_threads, [&](std::size_t chunk_index) {
+        const auto [begin, end] = getChunkRange(size, num_chunks, chunk_index);
+        auto& histogram = chunk_offsets[chunk_index];
+        for (auto row_index = begin; row_index < end; ++row_index) {
+            row_hashes[row_index] = hashRow(column_store_data, row_index, KeyIndices{});
+            ++histogram[getRadixPartition(row_hashes[row_index], radix_bits)];
+        }
+    });
+
+    RadixPartitioning partitioning{};
+    partitioning.offsets.resize(num_partitions + 1);
+    std::size_t offset {0};
+    for (std::size_t partition = 0; partition < num_partitions; ++partition) {
+        partitioning.offsets[partition] = offset;
+        for (auto& histogram : chunk_offsets) {
+            offset += std::exchange(histogram[partition], offset);
+        }
+    }
+    partitioning.offsets[num_partitions] = offset;
+
+    partitioning.rows.resize(size);
+    partitioning.hashes.resize(size);
+    parallelFor(num_chunks, num_threads, [&](std::size_t chunk_index) {
+        const auto [begin, end] = getChunkRange(size, num_chunks, chunk_index);
+        auto& write_offsets = chunk_offsets[chunk_index];
+        for (auto row_index = begin; row_index < end; ++row_index) {
+            const std::size_t target = write_offsets[getRadixPartition(row_hashes[row_index], radix_bits)]++;
+            partitioning.rows[target] = row_index;
+            partitioning.hashes[target] = row_hashes[row_index];
+        }
+    });
+    return partitioning;
+}
+
+// ############################################################################
+// Class: Partition Hash Join Table
+// ############################################################################
+/**
+ * Hash table over the rows of a single partition using the precomputed row hashes.
+ * Matches are reported by their slot in the partition.
+*/
+template <typename ColumnStoreData, typename KeyIndices>
+class PartitionHashJoinTable {
+public:
+    PartitionHashJoinTable (const ColumnStoreData& column_store_data, std::span<const std::size_t> rows, std::span<const std::size_t> hashes)
+        : column_store_data_{column_store_data}, rows_{rows}, hashes_{hashes} {
+        const std::size_t num_buckets = std::bit_ceil(std::max(rows.size(), std::size_t{1}));
+        bucket_mask_ = num_buckets - 1;
+        buckets_.assign(num_buckets, NO_ROW_INDEX);
+        next_.resize(rows.size());
+        for (std::size_t slot = rows.size(); slot-- > 0;) {
+            auto& bucket = buckets_[hashes_[slot] & bucket_mask_];
+            next_[slot] = bucket;
+            bucket = slot;
+        }
+    }
+
+    template <typename ProbeColumnStoreData, typename ProbeKeyIndices, typename Func>
+    void forEachMatch (const ProbeColumnStoreData& probe_data, std::size_t probe_row_index, std::size_t probe_hash, ProbeKeyIndices, Func&& function) const {
+        for (auto slot = buckets_[probe_hash & bucket_mask_]; slot != NO_ROW_INDEX; slot = next_[slot]) {
+            if (hashes_[slot] == probe_hash && areRowsEqual(column_store_data_, rows_[slot], KeyIndices{}, probe_data, probe_row_index, ProbeKeyIndices{})) {
+                function(slot);
+            }
+        }
+    }
+
+    template <typename ProbeColumnStoreData, typename ProbeKeyIndices>
+    bool containsMatch (const ProbeColumnStoreData& probe_data, std::size_t probe_row_index, std::size_t probe_hash, ProbeKeyIndices) const {
+        for (auto slot = buckets_[probe_hash & bucket_mask_]; slot != NO_ROW_INDEX; slot = next_[slot]) {
+            if (hashes_[slot] == probe_hash && areRowsEqual(column_store_data_, rows_[slot], KeyIndices{}, probe_data, probe_row_index, ProbeKeyIndices{})) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    const ColumnStoreData& column_store_data_;
+    std::span<const std::size_t> rows_;
+    std::span<const std::size_t> hashes_;
+    std::size_t bucket_mask_{0};
+    std::vector<std::size_t> buckets_{};
+    std::vector<std::size_t> next_{};
+};
+
+// ############################################################################
+// Util: Partitioned Hash Join
+// ############################################################################
+inline constexpr std::size_t ROWS_PER_JOIN_PARTITION = 1UL << 14;
+inline constexpr std::size_t MAX_JOIN_RADIX_BITS = 14;
+
+/**
+ * Returns the number of radix bits such that the build side partitions fit into the
+ * cache and there are enough partitions to keep all threads busy.
+*/
+inline std::size_t getJoinRadixBits (std::size_t build_size, std::size_t num_threads) {
+    const std::size_t num_partitions = std::max(build_size / ROWS_PER_JOIN_PARTITION, num_threads > 1 ? 4 * num_threads : 1);
+    return std::min(static_cast<std::size_t>(std::bit_width(std::bit_ceil(num_partitions)) - 1), MAX_JOIN_RADIX_BITS);
+}
+
+/**
+ * Joins a single pair of partitions by a build/probe hash join on the smaller partition.
+*/
+template <Join JoinType, typename ColumnStoreDataLeft, typename ColumnStoreDataRight, typename KeyIndicesLeft, typename KeyIndicesRight>
+void joinPartition (
+    JoinedRowIndices& joined_rows,
+    const ColumnStoreDataLeft& left, std::span<const std::size_t> left_rows, std::span<const std::size_t> left_hashes,
+    const ColumnStoreDataRight& right, std::span<const std::size_t> right_rows, std::span<const std::size_t> right_hashes
+) {
+    std::vector<char> is_matched_right(keeps_unmatched_right_rows<JoinType> ? right_rows.size() : 0, false);
+    if (right_rows.size() <= left_rows.size()) {
+        PartitionHashJoinTable<ColumnStoreDataRight, KeyIndicesRight> table{right, right_rows, right_hashes};
+        for (std::size_t left_slot = 0; left_slot < left_rows.size(); ++left_slot) {
+            const std::size_t left_index = left_rows[left_slot];
+            if constexpr (is_filtering_join<JoinType>) {
+                if (table.containsMatch(left, left_index, left_hashes[left_slot], KeyIndicesLeft{}) == (JoinType == Join::Semi)) {
+                    joined_rows.left.push_back(left_index);
+                }
+            }
+            else {
+                bool is_matched_left {false};
+                table.forEachMatch(left, left_index, left_hashes[left_slot], KeyIndicesLeft{}, [&](std::size_t right_slot) {
+                    joined_rows.left.push_back(left_index);
+                    joined_rows.right.push_back(right_rows[right_slot]);
+                    is_matched_left = true;
+                    if constexpr (keeps_unmatched_right_rows<JoinType>) {
+                        is_matched_right[right_slot] = true;
+                    }
+                });
+                if (keeps_unmatched_left_rows<JoinType> && not is_matched_left) {
+                    joined_rows.left.push_back(left_index);
+                    joined_rows.right.push_back(NO_ROW_INDEX);
+                }
+            }
+        }
+    }
+    else {
+        PartitionHashJoinTable<ColumnStoreDataLeft, KeyIndicesLeft> table{left, left_rows, left_hashes};
+        std::vector<char> is_matched_left(left_rows.size(), false);
+        for (std::size_t right_slot = 0; right_slot < right_rows.size(); ++right_slot) {
+            const std::size_t right_index = right_rows[right_slot];
+            table.forEachMatch(right, right_index, right_hashes[right_slot], KeyIndicesRight{}, [&](std::size_t left_slot) {
+                is_matched_left[left_slot] = true;
+                if constexpr (not is_filtering_join<JoinType>) {
+                    joined_rows.left.push_back(left_rows[left_slot]);
+                    joined_rows.right.push_back(right_index);
+                }
+                if constexpr (keeps_unmatched_right_rows<JoinType>) {
+                    is_matched_right[right_slot] = true;
+                }
+            });
+        }
+        for (std::size_t left_slot = 0; left_slot < left_rows.size(); ++left_slot) {
+            if constexpr (is_filtering_join<JoinType>) {
+                if (static_cast<bool>(is_matched_left[left_slot]) == (JoinType == Join::Semi)) {
+                    joined_rows.left.push_back(left_rows[left_slot]);
+                }
+            }
+            else if constexpr (keeps_unmatched_left_rows<JoinType>) {
+                if (not is_matched_left[left_slot]) {
+                    joined_rows.left.push_back(left_rows[left_slot]);
+                    joined_rows.right.push_back(NO_ROW_INDEX);
+                }
+            }
+        }
+    }
+    if constexpr (keeps_unmatched_right_rows<JoinType>) {
+        for (std::size_t right_slot = 0; right_slot < right_rows.size(); ++right_slot) {
+            if (not is_matched_right[right_slot]) {
+                joined_rows.left.push_back(NO_ROW_INDEX);
+                joined_rows.right.push_back(right_rows[right_slot]);
+            }
+        }
+    }
+}
+
+/**
+ * Computes the rows of the joined column stores by a parallel radix-partitioned hash join.
+ *
+ * Both inputs are partitioned by the upper bits of the row hashes such that the hash table
+ * of each partition fits into the cache. The partitions are joined in parallel into
+ * per-partition results which are concatenated in the order of the partitions.
+ * The result is deterministic, but only ordered by the left row index within a partition.
+*/
+template <Join JoinType, typename ColumnStoreDataLeft, typename ColumnStoreDataRight, typename KeyIndicesLeft, typename KeyIndicesRight>
+JoinedRowIndices partitionedHashJoin (const ColumnStoreDataLeft& left, std::size_t left_size, const ColumnStoreDataRight& right, std::size_t right_size, KeyIndicesLeft, KeyIndicesRight, std::size_t num_threads) {
+    num_threads = getNumberOfThreads(num_threads);
+    const std::size_t radix_bits = getJoinRadixBits(std::min(left_size, right_size), num_threads);
+    const std::size_t num_partitions = std::size_t{1} << radix_bits;
+
+    const auto left_partitioning = radixPartitionRows(left, left_size, KeyIndicesLeft{}, radix_bits, num_threads);
+    const auto right_partitioning = radixPartitionRows(right, right_size, KeyIndicesRight{}, radix_bits, num_threads);
+
+    std::vector<JoinedRowIndices> partition_results(num_partitions);
+    parallelFor(num_partitions, num_threads, [&](std::size_t partition) {
+        joinPartition<JoinType, ColumnStoreDataLeft, ColumnStoreDataRight, KeyIndicesLeft, KeyIndicesRight>(
+            partition_results[partition],
+            left, left_partitioning.getRows(partition), left_partitioning.getHashes(partition),
+            right, right_partitioning.getRows(partition), right_partitioning.getHashes(partition)
+        );
+    });
+
+    std::vector<std::size_t> result_offsets(num_partitions + 1, 0);
+    for (std::size_t partition = 0; partition < num_partitions; ++partition) {
+        result_offsets[partition + 1] = result_offsets[partition] + partition_results[partition].left.size();
+    }
+    JoinedRowIndices joined_rows{};
+    joined_rows.left.resize(result_offsets[num_partitions]);
+    if constexpr (not is_filtering_join<JoinType>) {
+        joined_rows.right.resize(result_offsets[num_partitions]);
+    }
+    parallelFor(num_partitions, num_threads, [&](std::size_t partition) {
+        auto& partition_result = partition_results[partition];
+        std::copy(partition_result.left.begin(), partition_result.left.end(), joined_rows.left.begin() + result_offsets[partition]);
+        if constexpr (not is_filtering_join<JoinType>) {
+            std::copy(partition_result.right.begin(), partition_result.right.end(), joined_rows.right.begin() + result_offsets[partition]);
+        }
+        partition_result = JoinedRowIndices{};
+    });
+    return joined_rows;
+}
+
+// ############################################################################
+// Util: Compute Joined Rows By Strategy
+// ############################################################################
+template <Join JoinType, typename ColumnStoreDataLeft, typename ColumnStoreDataRight, typename KeyIndicesLeft, typename KeyIndicesRight>
+JoinedRowIndices computeJoinedRows (HashJoin, const ColumnStoreDataLeft& left, std::size_t left_size, const ColumnStoreDataRight& right, std::size_t right_size, KeyIndicesLeft, KeyIndicesRight) {
+    return hashJoin<JoinType>(left, left_size, right, right_size, KeyIndicesLeft{}, KeyIndicesRight{});
+}
+
+template <Join JoinType, typename ColumnStoreDataLeft, typename ColumnStoreDataRight, typename KeyIndicesLeft, typename KeyIndicesRight>
+JoinedRowIndices computeJoinedRows (SortMergeJoin, const ColumnStoreDataLeft& left, std::size_t left_size, const ColumnStoreDataRight& right, std::size_t right_size, KeyIndicesLeft, KeyIndicesRight) {
+    return sortMergeJoin<JoinType>(left, left_size, right, right_size, KeyIndicesLeft{}, KeyIndicesRight{});
+}
+
+template <Join JoinType, typename ColumnStoreDataLeft, typename ColumnStoreDataRight, typename KeyIndicesLeft, typename KeyIndicesRight>
+JoinedRowIndices computeJoinedRows (PartitionedHashJoin strategy, const ColumnStoreDataLeft& left, std::size_t left_size, const ColumnStoreDataRight& right, std::size_t right_size, KeyIndicesLeft, KeyIndicesRight) {
+    return partitionedHashJoin<JoinType>(left, left_size, right, right_size, KeyIndicesLeft{}, KeyIndicesRight{}, strategy.num_threads);
+}
+
+// ############################################################################
+// Util: Gather Joined Rows Into Container
+// ############################################################################
+/**
+ * Gathers the rows of one side of the join. Missing rows (NO_ROW_INDEX) are filled
+ * with a default value, i.e. std::nullopt for the optional columns of outer joins.
+*/
+template <typename Container, typename SourceContainer>
+inline void gatherJoinedRowsIntoContainer (Container& container, const SourceContainer& source, const std::vector<std::size_t>& row_indices) {
+    auto& values = getMutableValues(container);
+    values.reserve(values.size() + row_indices.size());
+    for (auto row_index : row_indices) {
+        if (row_index == NO_ROW_INDEX) {
+            values.push_back(typename Container::value_type{});
+        }
+        else {
+            values.push_back(source[row_index]);
+        }
+    }
+}
+
+/**
+ * Fills the join columns of rows without left row by the values of the right row.
+*/
+template <typename Container, typename SourceContainer>
+inline void fillJoinColumnForUnmatchedRightRows (Container& container, const SourceContainer& source_right, const JoinedRowIndices& joined_rows) {
+    auto& values = getMutableValues(container);
+    for (std::size_t i = 0; i < joined_rows.getSize(); ++i) {
+        if (joined_rows.left[i] == NO_ROW_INDEX) {
+            values[i] = source_right[joined_rows.right[i]];
+        }
+    }
+}
+
+} // namespace internal
+
+} // namespace dacr
+
+#endif // DATA_CRUNCHING_INTERNAL_DATAFRAME_JOIN_HPP
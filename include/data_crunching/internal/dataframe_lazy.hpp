@@ -0,0 +1,698 @@
+// Copyright 2022 Andi Hellmund
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef DATA_CRUNCHING_INTERNAL_DATAFRAME_LAZY_HPP
+#define DATA_CRUNCHING_INTERNAL_DATAFRAME_LAZY_HPP
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "data_crunching/internal/column.hpp"
+#include "data_crunching/internal/dataframe_expression.hpp"
+#include "data_crunching/internal/dataframe_general.hpp"
+#include "data_crunching/internal/dataframe_sort.hpp"
+#include "data_crunching/internal/fixed_string.hpp"
+#include "data_crunching/internal/name_list.hpp"
+#include "data_crunching/internal/type_list.hpp"
+
+namespace dacr {
+
+namespace internal {
+
+// ############################################################################
+// Class: Lazy Stages
+// ############################################################################
+/**
+ * Operations recorded by a LazyFrame. Select, query and apply are row-wise stages which are fused
+ * into a single pass over the rows, sort is a pipeline breaker.
+*/
+template <typename Names>
+struct LazySelect {};
+
+template <typename SelectNames, typename Func>
+struct LazyQuery {
+    using SelectNamesType = SelectNames;
+    Func function;
+};
+
+template <typename Expr>
+struct LazyQueryExpression {
+    Expr expression;
+};
+
+template <FixedString NewColumnName, typename SelectNames, typename Func>
+struct LazyApply {
+    static constexpr FixedString NAME = NewColumnName;
+    using SelectNamesType = SelectNames;
+    Func function;
+};
+
+template <typename SortKeySpecs>
+struct LazySort {
+    using SortKeySpecsType = SortKeySpecs;
+};
+
+template <typename>
+constexpr bool is_lazy_select = false;
+
+template <typename Names>
+constexpr bool is_lazy_select<LazySelect<Names>> = true;
+
+template <typename>
+constexpr bool is_lazy_query = false;
+
+template <typename SelectNames, typename Func>
+constexpr bool is_lazy_query<LazyQuery<SelectNames, Func>> = true;
+
+template <typename>
+constexpr bool is_lazy_query_expression = false;
+
+template <typename Expr>
+constexpr bool is_lazy_query_expression<LazyQueryExpression<Expr>> = true;
+
+template <typename>
+constexpr bool is_lazy_apply = false;
+
+template <FixedString NewColumnName, typename SelectNames, typename Func>
+constexpr bool is_lazy_apply<LazyApply<NewColumnName, SelectNames, Func>> = true;
+
+template <typename>
+constexpr bool is_lazy_sort = false;
+
+template <typename SortKeySpecs>
+constexpr bool is_lazy_sort<LazySort<SortKeySpecs>> = true;
+
+// ############################################################################
+// Trait: Lazy Schema
+// ############################################################################
+/**
+ * Column of a LazyFrame: either the column with the given index in the source DataFrame or
+ * the column computed by the apply stage with the given index.
+*/
+template <FixedString Name, typename Type, bool IsComputed, std::size_t Index>
+struct LazyColumn {
+    static constexpr FixedString NAME = Name;
+    static constexpr bool is_computed = IsComputed;
+    static constexpr std::size_t index = Index;
+    using type = Type;
+};
+
+template <typename, typename>
+struct GetLazySourceSchemaImpl {};
+
+template <FixedString ...Names, typename ...Types, std::size_t ...Indices>
+struct GetLazySourceSchemaImpl<TypeList<Column<Names, Types>...>, std::index_sequence<Indices...>> {
+    using type = TypeList<LazyColumn<Names, Types, false, Indices>...>;
+};
+
+template <typename ColumnSpecs>
+using GetLazySourceSchema = typename GetLazySourceSchemaImpl<ColumnSpecs, std::make_index_sequence<ColumnSpecs::getSize()>>::type;
+
+template <typename>
+struct GetLazySchemaNamesImpl {};
+
+template <typename ...LazyColumns>
+struct GetLazySchemaNamesImpl<TypeList<LazyColumns...>> {
+    using type = NameList<LazyColumns::NAME...>;
+};
+
+template <typename Schema>
+using GetLazySchemaNames = typename GetLazySchemaNamesImpl<Schema>::type;
+
+template <FixedString, typename>
+struct GetLazyColumnByNameImpl {};
+
+template <FixedString Name, typename FirstLazyColumn, typename ...RestLazyColumns>
+struct GetLazyColumnByNameImpl<Name, TypeList<FirstLazyColumn, RestLazyColumns...>> {
+    using type = std::conditional_t<
+        areFixedStringsEqual(Name, FirstLazyColumn::NAME),
+        FirstLazyColumn,
+        typename GetLazyColumnByNameImpl<Name, TypeList<RestLazyColumns...>>::type
+    >;
+};
+
+template <FixedString Name>
+struct GetLazyColumnByNameImpl<Name, TypeList<>> {
+    using type = void;
+};
+
+template <FixedString Name, typename Schema>
+using GetLazyColumnByName = typename GetLazyColumnByNameImpl<Name, Schema>::type;
+
+template <typename, typename>
+struct GetLazyColumnsByNamesImpl {};
+
+template <FixedString ...Names, typename Schema>
+struct GetLazyColumnsByNamesImpl<NameList<Names...>, Schema> {
+    using type = TypeList<GetLazyColumnByName<Names, Schema>...>;
+};
+
+template <typename Names, typename Schema>
+using GetLazyColumnsByNames = typename GetLazyColumnsByNamesImpl<Names, Schema>::type;
+
+template <typename, typename>
+struct GetLazySelectNamesImpl {};
+
+template <typename Schema>
+struct GetLazySelectNamesImpl<SelectAll, Schema> {
+    using type = GetLazySchemaNames<Schema>;
+};
+
+template <FixedString ...Names, typename Schema>
+struct GetLazySelectNamesImpl<Select<Names...>, Schema> {
+    using type = NameList<Names...>;
+};
+
+template <typename SelectNames, typename Schema>
+using GetLazySelectNames = typename GetLazySelectNamesImpl<SelectNames, Schema>::type;
+
+template <typename, typename>
+constexpr bool is_valid_lazy_select = false;
+
+template <typename Schema>
+constexpr bool is_valid_lazy_select<SelectAll, Schema> = true;
+
+template <FixedString ...Names, typename Schema>
+constexpr bool is_valid_lazy_select<Select<Names...>, Schema> = (
+    sizeof...(Names) > 0 &&
+    are_names_unique<NameList<Names...>> &&
+    are_names_in_name_list<NameList<Names...>, GetLazySchemaNames<Schema>>
+);
+
+template <typename>
+struct ConstructDataFrameForLazySchemaImpl {};
+
+template <typename ...LazyColumns>
+struct ConstructDataFrameForLazySchemaImpl<TypeList<LazyColumns...>> {
+    using type = DataFrame<Column<LazyColumns::NAME, typename LazyColumns::type>...>;
+};
+
+template <typename Schema>
+using ConstructDataFrameForLazySchema = typename ConstructDataFrameForLazySchemaImpl<Schema>::type;
+
+// ############################################################################
+// Class: Lazy Row View
+// ############################################################################
+template <typename>
+struct ConstructLazyComputedStoreImpl {};
+
+template <typename ...Types>
+struct ConstructLazyComputedStoreImpl<TypeList<Types...>> {
+    using type = std::tuple<std::vector<Types>...>;
+    using pointers = std::tuple<const std::vector<Types>*...>;
+};
+
+/**
+ * Columns computed by the apply stages, one column per apply stage.
+*/
+template <typename ComputedTypes>
+using ConstructLazyComputedStore = typename ConstructLazyComputedStoreImpl<ComputedTypes>::type;
+
+template <typename ComputedTypes>
+using ConstructLazyComputedPointers = typename ConstructLazyComputedStoreImpl<ComputedTypes>::pointers;
+
+/**
+ * Read-only view of a single row within a fused pass of a LazyFrame.
+ *
+ * Source columns are accessed by the row index into the source DataFrame. Computed columns of
+ * previous passes are accessed at the input position of the row, computed columns of the current
+ * pass at the output position (the value has just been appended for this row).
+*/
+template <typename Schema, typename SourceStore, typename ComputedPointers>
+class LazyRowView {
+public:
+    LazyRowView (const SourceStore& source, ComputedPointers computed, std::size_t row_index, std::size_t input_position, std::size_t output_position, std::size_t first_output_computed_index)
+        : source_{&source}, computed_{computed}, row_index_{row_index}, input_position_{input_position}, output_position_{output_position}, first_output_computed_index_{first_output_computed_index} {}
+
+    template <FixedString FieldName>
+    requires (is_name_in_name_list<FieldName, GetLazySchemaNames<Schema>>)
+    decltype(auto) get () const {
+        using FieldColumn = GetLazyColumnByName<FieldName, Schema>;
+        if constexpr (FieldColumn::is_computed) {
+            const auto& column = *std::get<FieldColumn::index>(computed_);
+            return column[FieldColumn::index < first_output_computed_index_ ? input_position_ : output_position_];
+        }
+        else {
+            return std::get<FieldColumn::index>(*source_)[row_index_];
+        }
+    }
+
+    std::size_t getRowIndex () const {
+        return row_index_;
+    }
+
+private:
+    const SourceStore* source_;
+    ComputedPointers computed_;
+    std::size_t row_index_;
+    std::size_t input_position_;
+    std::size_t output_position_;
+    std::size_t first_output_computed_index_;
+};
+
+template <typename SelectNames, typename Schema, typename SourceStore, typename ComputedTypes>
+using ConstructLazyRowView = LazyRowView<
+    GetLazyColumnsByNames<GetLazySelectNames<SelectNames, Schema>, Schema>,
+    SourceStore,
+    ConstructLazyComputedPointers<ComputedTypes>
+>;
+
+// ############################################################################
+// Trait: Lazy Plan
+// ############################################################################
+/**
+ * Schema and types of the computed columns after a single stage.
+*/
+template <typename Schema, typename ComputedTypes, typename SourceStore, typename Stage>
+struct LazyStageTransition {
+    using schema = Schema;
+    using computed_types = ComputedTypes;
+};
+
+template <typename Schema, typename ComputedTypes, typename SourceStore, typename Names>
+struct LazyStageTransition<Schema, ComputedTypes, SourceStore, LazySelect<Names>> {
+    using schema = GetLazyColumnsByNames<Names, Schema>;
+    using computed_types = ComputedTypes;
+};
+
+template <typename Schema, typename ComputedTypes, typename SourceStore, FixedString NewColumnName, typename SelectNames, typename Func>
+struct LazyStageTransition<Schema, ComputedTypes, SourceStore, LazyApply<NewColumnName, SelectNames, Func>> {
+    using value_type = std::remove_cvref_t<std::invoke_result_t<const Func&, ConstructLazyRowView<SelectNames, Schema, SourceStore, ComputedTypes>>>;
+    using schema = TypeListMerge<
+        GetLazyColumnsByNames<GetLazySelectNames<SelectNames, Schema>, Schema>,
+        TypeList<LazyColumn<NewColumnName, value_type, true, ComputedTypes::getSize()>>
+    >;
+    using computed_types = TypeListMerge<ComputedTypes, TypeList<value_type>>;
+};
+
+/**
+ * Schema and types of the computed columns before the stage with index StageIndex.
+*/
+template <std::size_t StageIndex, typename SourceSchema, typename SourceStore, typename Stages>
+struct LazyPlanAt {
+    using previous = LazyPlanAt<StageIndex - 1, SourceSchema, SourceStore, Stages>;
+    using transition = LazyStageTransition<typename previous::schema, typename previous::computed_types, SourceStore, std::tuple_element_t<StageIndex - 1, Stages>>;
+    using schema = typename transition::schema;
+    using computed_types = typename transition::computed_types;
+};
+
+template <typename SourceSchema, typename SourceStore, typename Stages>
+struct LazyPlanAt<0, SourceSchema, SourceStore, Stages> {
+    using schema = SourceSchema;
+    using computed_types = TypeList<>;
+};
+
+/**
+ * Names of the columns read by a stage, used to skip apply stages whose column is never read.
+*/
+template <typename Stage, typename Schema>
+struct GetLazyStageReadNamesImpl {
+    using type = NameList<>;
+};
+
+template <typename SelectNames, typename Func, typename Schema>
+struct GetLazyStageReadNamesImpl<LazyQuery<SelectNames, Func>, Schema> {
+    using type = GetLazySelectNames<SelectNames, Schema>;
+};
+
+template <typename Expr, typename Schema>
+struct GetLazyStageReadNamesImpl<LazyQueryExpression<Expr>, Schema> {
+    using type = GetExpressionNames<Expr>;
+};
+
+template <FixedString NewColumnName, typename SelectNames, typename Func, typename Schema>
+struct GetLazyStageReadNamesImpl<LazyApply<NewColumnName, SelectNames, Func>, Schema> {
+    using type = GetLazySelectNames<SelectNames, Schema>;
+};
+
+template <typename ...SortKeySpecs, typename Schema>
+struct GetLazyStageReadNamesImpl<LazySort<TypeList<SortKeySpecs...>>, Schema> {
+    using type = GetSortKeySpecNames<SortKeySpecs...>;
+};
+
+template <typename Stage, typename Schema>
+using GetLazyStageReadNames = typename GetLazyStageReadNamesImpl<Stage, Schema>::type;
+
+// ############################################################################
+// Util: Lazy Sort
+// ############################################################################
+template <typename>
+struct GetLazySortKeyNameImpl {};
+
+template <FixedString Name>
+struct GetLazySortKeyNameImpl<NameList<Name>> {
+    static constexpr FixedString NAME = Name;
+};
+
+template <typename Row>
+bool isLazyRowBefore (const Row&, const Row&, TypeList<>) {
+    return false;
+}
+
+template <typename Row, typename FirstSortKeySpec, typename ...RestSortKeySpecs>
+bool isLazyRowBefore (const Row& lhs, const Row& rhs, TypeList<FirstSortKeySpec, RestSortKeySpecs...>) {
+    constexpr FixedString Name = GetLazySortKeyNameImpl<typename FirstSortKeySpec::Names>::NAME;
+    const auto& lhs_value = lhs.template get<Name>();
+    const auto& rhs_value = rhs.template get<Name>();
+    if (lhs_value < rhs_value) {
+        return FirstSortKeySpec::Order == SortOrder::Ascending;
+    }
+    if (rhs_value < lhs_value) {
+        return FirstSortKeySpec::Order == SortOrder::Descending;
+    }
+    return isLazyRowBefore(lhs, rhs, TypeList<RestSortKeySpecs...>{});
+}
+
+} // namespace internal
+
+// ############################################################################
+// Class: LazyFrame
+// ############################################################################
+/**
+ * Lazy pipeline of operations on a DataFrame (created by DataFrame::lazy()).
+ *
+ * The operations are recorded as a compile-time plan and executed by collect(): consecutive row-wise
+ * stages (select, query, apply) are fused into a single pass which only tracks the row indices of the
+ * source DataFrame and the computed columns. Source columns are only copied into the result, apply stages
+ * whose column is never read are skipped. The source DataFrame must outlive the LazyFrame.
+*/
+template <typename DataFrameType, typename ...Stages>
+class LazyFrame {
+public:
+    template <typename, typename ...>
+    friend class LazyFrame;
+
+    explicit LazyFrame (const DataFrameType& df, std::tuple<Stages...> stages = {}) : df_{&df}, stages_{std::move(stages)} {}
+
+    // ############################################################################
+    // API: Column Details
+    // ############################################################################
+    using SourceStore = typename DataFrameType::ColumnStoreDataType;
+    using SourceSchema = internal::GetLazySourceSchema<typename DataFrameType::ColumnSpecs>;
+    using Plan = internal::LazyPlanAt<sizeof...(Stages), SourceSchema, SourceStore, std::tuple<Stages...>>;
+    using Schema = typename Plan::schema;
+    using ResultDataFrame = internal::ConstructDataFrameForLazySchema<Schema>;
+
+    // ############################################################################
+    // API: Select
+    // ############################################################################
+    template <FixedString ...ColumnNames>
+    requires (
+        sizeof...(ColumnNames) > 0 &&
+        internal::are_names_unique<internal::NameList<ColumnNames...>> &&
+        internal::are_names_in_name_list<internal::NameList<ColumnNames...>, internal::GetLazySchemaNames<Schema>>
+    )
+    auto select () const {
+        return appendStage(internal::LazySelect<internal::NameList<ColumnNames...>>{});
+    }
+
+    // ############################################################################
+    // API: Query
+    // ############################################################################
+    template <typename SelectNames = SelectAll, typename Func>
+    requires (internal::is_valid_lazy_select<SelectNames, Schema> && not internal::IsExpression<Func>)
+    auto query (Func&& function) const {
+        return appendStage(internal::LazyQuery<SelectNames, std::decay_t<Func>>{std::forward<Func>(function)});
+    }
+
+    template <internal::IsExpression Expr>
+    requires (internal::are_names_in_name_list<internal::GetExpressionNames<Expr>, internal::GetLazySchemaNames<Schema>>)
+    auto query (const Expr& expression) const {
+        return appendStage(internal::LazyQueryExpression<Expr>{expression});
+    }
+
+    // ############################################################################
+    // API: Apply
+    // ############################################################################
+    template <FixedString NewColumnName, typename SelectNames = SelectAll, typename Func>
+    requires (
+        NewColumnName.getLength() > 0 &&
+        not internal::is_name_in_name_list<NewColumnName, internal::GetLazySchemaNames<Schema>> &&
+        internal::is_valid_lazy_select<SelectNames, Schema>
+    )
+    auto apply (Func&& function) const {
+        return appendStage(internal::LazyApply<NewColumnName, SelectNames, std::decay_t<Func>>{std::forward<Func>(function)});
+    }
+
+    // ############################################################################
+    // API: Sort
+    // ############################################################################
+    template <SortOrder Order, FixedString ...ColumnNames>
+    requires (
+        sizeof...(ColumnNames) > 0 &&
+        internal::are_names_unique<internal::NameList<ColumnNames...>> &&
+        internal::are_names_in_name_list<internal::NameList<ColumnNames...>, internal::GetLazySchemaNames<Schema>>
+    )
+    auto sort () const {
+        using SortKeySpecs = TypeList<std::conditional_t<Order == SortOrder::Ascending, Asc<ColumnNames>, Desc<ColumnNames>>...>;
+        return appendStage(internal::LazySort<SortKeySpecs>{});
+    }
+
+    template <internal::IsSortKeySpec ...SortKeySpecs>
+    requires (
+        sizeof...(SortKeySpecs) > 0 &&
+        internal::are_names_unique<internal::GetSortKeySpecNames<SortKeySpecs...>> &&
+        internal::are_names_in_name_list<internal::GetSortKeySpecNames<SortKeySpecs...>, internal::GetLazySchemaNames<Schema>>
+    )
+    auto sort () const {
+        return appendStage(internal::LazySort<TypeList<SortKeySpecs...>>{});
+    }
+
+    // ############################################################################
+    // API: Collect
+    // ############################################################################
+    /**
+     * Executes the plan and materializes the result into a new DataFrame.
+    */
+    ResultDataFrame collect () const {
+        ExecutionState state{};
+        state.row_indices.resize(df_->getSize());
+        std::iota(state.row_indices.begin(), state.row_indices.end(), std::size_t{0});
+        executeStages<0>(state);
+
+        ResultDataFrame result{df_->getMemoryResource()};
+        materializeResult(result, state, std::make_index_sequence<Schema::getSize()>{});
+        return result;
+    }
+
+    /**
+     * Returns true if the column of the apply stage with the given index is read by a later stage
+     * or is part of the result.
+    */
+    template <std::size_t StageIndex>
+    requires (internal::is_lazy_apply<std::tuple_element_t<StageIndex, std::tuple<Stages...>>>)
+    static constexpr bool isApplyStageLive () {
+        constexpr FixedString NewColumnName = std::tuple_element_t<StageIndex, std::tuple<Stages...>>::NAME;
+        return internal::is_name_in_name_list<NewColumnName, internal::GetLazySchemaNames<Schema>> || []<std::size_t ...Indices>(std::index_sequence<Indices...>) {
+            return ((Indices > StageIndex && internal::is_name_in_name_list<StageAt<StageIndex>::NAME, internal::GetLazyStageReadNames<StageAt<Indices>, typename PlanAt<Indices>::schema>>) || ...);
+        }(std::index_sequence_for<Stages...>{});
+    }
+
+private:
+    template <std::size_t StageIndex>
+    using PlanAt = internal::LazyPlanAt<StageIndex, SourceSchema, SourceStore, std::tuple<Stages...>>;
+
+    template <std::size_t StageIndex>
+    using StageAt = std::tuple_element_t<StageIndex, std::tuple<Stages...>>;
+
+    struct ExecutionState {
+        std::vector<std::size_t> row_indices{};
+        internal::ConstructLazyComputedStore<typename Plan::computed_types> computed{};
+    };
+
+    template <typename Stage>
+    auto appendStage (Stage stage) const {
+        return LazyFrame<DataFrameType, Stages..., Stage>{*df_, std::tuple_cat(stages_, std::tuple<Stage>{std::move(stage)})};
+    }
+
+    /**
+     * Returns the index of the first sort stage at or after StageIndex (or the number of stages).
+    */
+    template <std::size_t StageIndex>
+    static constexpr std::size_t getFusedStagesEnd () {
+        constexpr std::array<bool, sizeof...(Stages)> is_sort_stage {internal::is_lazy_sort<Stages>...};
+        std::size_t stage_index = StageIndex;
+        while (stage_index < sizeof...(Stages) && not is_sort_stage[stage_index]) {
+            ++stage_index;
+        }
+        return stage_index;
+    }
+
+    template <std::size_t StageIndex>
+    void executeStages (ExecutionState& state) const {
+        if constexpr (StageIndex < sizeof...(Stages)) {
+            if constexpr (internal::is_lazy_sort<StageAt<StageIndex>>) {
+                executeSort<StageIndex>(state);
+                executeStages<StageIndex + 1>(state);
+            }
+            else {
+                constexpr std::size_t FusedStagesEnd = getFusedStagesEnd<StageIndex>();
+                executeFusedStages<StageIndex, FusedStagesEnd>(state);
+                executeStages<FusedStagesEnd>(state);
+            }
+        }
+    }
+
+    template <std::size_t StageIndex, typename SelectNames>
+    auto createRowView (const ExecutionState& state, std::size_t input_position, std::size_t output_position, std::size_t first_output_computed_index) const {
+        using ComputedTypes = typename PlanAt<StageIndex>::computed_types;
+        using RowViewType = internal::ConstructLazyRowView<SelectNames, typename PlanAt<StageIndex>::schema, SourceStore, ComputedTypes>;
+        auto computed = [&state]<std::size_t ...Indices>(std::index_sequence<Indices...>) {
+            return internal::ConstructLazyComputedPointers<ComputedTypes>{&std::get<Indices>(state.computed)...};
+        }(std::make_index_sequence<ComputedTypes::getSize()>{});
+        return RowViewType{df_->column_store_data_, computed, state.row_indices[input_position], input_position, output_position, first_output_computed_index};
+    }
+
+    /**
+     * Executes the row-wise stages [Begin, End) in a single pass. The kept rows (and the computed columns of
+     * previous passes) are compacted in place, the apply stages append their values to their (new) columns.
+    */
+    template <std::size_t Begin, std::size_t End>
+    void executeFusedStages (ExecutionState& state) const {
+        constexpr std::size_t FirstOutputComputedIndex = PlanAt<Begin>::computed_types::getSize();
+        const std::size_t num_rows = state.row_indices.size();
+        std::size_t num_kept_rows {0};
+        for (std::size_t position = 0; position < num_rows; ++position) {
+            if (processRow<Begin, End, FirstOutputComputedIndex>(state, position, num_kept_rows)) {
+                if (position != num_kept_rows) {
+                    state.row_indices[num_kept_rows] = state.row_indices[position];
+                    moveComputedValues(state, position, num_kept_rows, std::make_index_sequence<FirstOutputComputedIndex>{});
+                }
+                ++num_kept_rows;
+            }
+        }
+        state.row_indices.resize(num_kept_rows);
+        truncateComputedColumns(state, num_kept_rows, std::make_index_sequence<FirstOutputComputedIndex>{});
+    }
+
+    template <std::size_t StageIndex, std::size_t End, std::size_t FirstOutputComputedIndex>
+    bool processRow (ExecutionState& state, std::size_t position, std::size_t num_kept_rows) const {
+        if constexpr (StageIndex == End) {
+            return true;
+        }
+        else {
+            using Stage = StageAt<StageIndex>;
+            const auto& stage = std::get<StageIndex>(stages_);
+            if constexpr (internal::is_lazy_query<Stage>) {
+                const auto row = createRowView<StageIndex, typename Stage::SelectNamesType>(state, position, num_kept_rows, FirstOutputComputedIndex);
+                if (not static_cast<bool>(stage.function(row))) {
+                    dropComputedValues<FirstOutputComputedIndex, PlanAt<StageIndex>::computed_types::getSize()>(state);
+                    return false;
+                }
+            }
+            else if constexpr (internal::is_lazy_query_expression<Stage>) {
+                const auto row = createRowView<StageIndex, SelectAll>(state, position, num_kept_rows, FirstOutputComputedIndex);
+                if (not internal::evaluateExpressionOnRow(stage.expression, row)) {
+                    dropComputedValues<FirstOutputComputedIndex, PlanAt<StageIndex>::computed_types::getSize()>(state);
+                    return false;
+                }
+            }
+            else if constexpr (internal::is_lazy_apply<Stage>) {
+                if constexpr (isApplyStageLive<StageIndex>()) {
+                    const auto row = createRowView<StageIndex, typename Stage::SelectNamesType>(state, position, num_kept_rows, FirstOutputComputedIndex);
+                    std::get<PlanAt<StageIndex>::computed_types::getSize()>(state.computed).push_back(stage.function(row));
+                }
+            }
+            return processRow<StageIndex + 1, End, FirstOutputComputedIndex>(state, position, num_kept_rows);
+        }
+    }
+
+    /**
+     * Removes the values appended for the current row by the apply stages [Begin, End) of the current pass.
+    */
+    template <std::size_t Begin, std::size_t End>
+    static void dropComputedValues (ExecutionState& state) {
+        [&state]<std::size_t ...Indices>(std::index_sequence<Indices...>) {
+            (dropLastComputedValue(std::get<Begin + Indices>(state.computed)), ...);
+        }(std::make_index_sequence<End - Begin>{});
+    }
+
+    template <typename Container>
+    static void dropLastComputedValue (Container& column) {
+        // skipped apply stages leave their column empty
+        if (not column.empty()) {
+            column.pop_back();
+        }
+    }
+
+    template <std::size_t ...Indices>
+    static void moveComputedValues ([[maybe_unused]] ExecutionState& state, [[maybe_unused]] std::size_t from, [[maybe_unused]] std::size_t to, std::index_sequence<Indices...>) {
+        ((std::get<Indices>(state.computed).empty() ? void() : void(std::get<Indices>(state.computed)[to] = std::move(std::get<Indices>(state.computed)[from]))), ...);
+    }
+
+    template <std::size_t ...Indices>
+    static void truncateComputedColumns ([[maybe_unused]] ExecutionState& state, [[maybe_unused]] std::size_t size, std::index_sequence<Indices...>) {
+        ((std::get<Indices>(state.computed).erase(std::get<Indices>(state.computed).begin() + std::min(size, std::get<Indices>(state.computed).size()), std::get<Indices>(state.computed).end())), ...);
+    }
+
+    template <std::size_t StageIndex>
+    void executeSort (ExecutionState& state) const {
+        constexpr std::size_t NumComputed = PlanAt<StageIndex>::computed_types::getSize();
+        std::vector<std::size_t> order(state.row_indices.size());
+        std::iota(order.begin(), order.end(), std::size_t{0});
+        std::stable_sort(order.begin(), order.end(), [&](std::size_t lhs, std::size_t rhs) {
+            return internal::isLazyRowBefore(
+                createRowView<StageIndex, SelectAll>(state, lhs, lhs, NumComputed),
+                createRowView<StageIndex, SelectAll>(state, rhs, rhs, NumComputed),
+                typename StageAt<StageIndex>::SortKeySpecsType{}
+            );
+        });
+
+        state.row_indices = permute(state.row_indices, order);
+        [&]<std::size_t ...Indices>(std::index_sequence<Indices...>) {
+            ((std::get<Indices>(state.computed) = permute(std::get<Indices>(state.computed), order)), ...);
+        }(std::make_index_sequence<NumComputed>{});
+    }
+
+    template <typename Container>
+    static Container permute (Container& values, const std::vector<std::size_t>& order) {
+        Container result{};
+        if (values.empty()) {
+            return result;
+        }
+        result.reserve(order.size());
+        for (auto position : order) {
+            result.push_back(std::move(values[position]));
+        }
+        return result;
+    }
+
+    template <std::size_t ...ResultIndices>
+    void materializeResult (ResultDataFrame& result, ExecutionState& state, std::index_sequence<ResultIndices...>) const {
+        (materializeResultColumn<ResultIndices>(result, state), ...);
+    }
+
+    template <std::size_t ResultIndex>
+    void materializeResultColumn (ResultDataFrame& result, ExecutionState& state) const {
+        using ResultColumn = std::tuple_element_t<ResultIndex, typename Schema::template To<std::tuple>>;
+        if constexpr (ResultColumn::is_computed) {
+            std::get<ResultIndex>(result.column_store_data_) = std::move(std::get<ResultColumn::index>(state.computed));
+        }
+        else {
+            internal::gatherIntoContainer(std::get<ResultIndex>(result.column_store_data_), std::get<ResultColumn::index>(df_->column_store_data_), state.row_indices);
+        }
+    }
+
+    const DataFrameType* df_;
+    std::tuple<Stages...> stages_;
+};
+
+} // namespace dacr
+
+#endif // DATA_CRUNCHING_INTERNAL_DATAFRAME_LAZY_HPP
@@ -18,9 +18,11 @@
 #include <concepts>
 #include <iomanip>
 #include <limits>
+#include <optional>
 #include <sstream>
 #include <string>
 
+#include "data_crunching/internal/categorical.hpp"
 #include "data_crunching/internal/fixed_string.hpp"
 #include "data_crunching/internal/utils.hpp"
 
@@ -178,6 +180,40 @@ struct DataFormatter<std::string> {
     }    
 };
 
+template <>
+struct DataFormatter<Categorical> {
+    static auto getAlignment() {
+        return std::left;
+    }
+    
+    static int getWidth (const PrintOptions& print_options) {
+        return print_options.string_width;
+    }
+    
+    static void format(std::ostream& stream, const Categorical& value, const PrintOptions& print_options) {
+        formatStringWithWidthAndAlignment(stream, value.view(), getWidth(print_options), getAlignment());
+    }    
+};
+
+template <typename T>
+struct DataFormatter<std::optional<T>> {
+    static auto getAlignment() {
+        return DataFormatter<T>::getAlignment();
+    }
+
+    static int getWidth (const PrintOptions& print_options) {
+        return DataFormatter<T>::getWidth(print_options);
+    }
+
+    static void format(std::ostream& stream, const std::optional<T>& value, const PrintOptions& print_options) {
+        if (value.has_value()) {
+            DataFormatter<T>::format(stream, value.value(), print_options);
+        }
+        else {
+            formatStringWithWidthAndAlignment(stream, "null", getWidth(print_options), getAlignment());
+        }
+    }
+};
 
 // ############################################################################
 // Trait: Printer
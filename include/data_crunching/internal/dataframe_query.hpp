@@ -0,0 +1,175 @@
+// Copyright 2022 Andi Hellmund
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef DATA_CRUNCHING_INTERNAL_DATAFRAME_QUERY_HPP
+#define DATA_CRUNCHING_INTERNAL_DATAFRAME_QUERY_HPP
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "data_crunching/internal/parallel.hpp"
+
+namespace dacr {
+
+// ############################################################################
+// Class: Selection
+// ############################################################################
+/**
+ * Selection of rows of a DataFrame as ascending vector of row indices.
+ *
+ * Selections of the same DataFrame are combined with & (rows in both selections), | (rows in any
+ * selection) and ~ (rows not in the selection) before the selected rows are materialized.
+*/
+class Selection {
+public:
+    Selection () = default;
+
+    /**
+     * Creates the selection from ascending and unique row indices, all smaller than num_rows.
+    */
+    Selection (std::vector<std::size_t> row_indices, std::size_t num_rows) : row_indices_{std::move(row_indices)}, num_rows_{num_rows} {}
+
+    static Selection all (std::size_t num_rows) {
+        std::vector<std::size_t> row_indices(num_rows);
+        std::iota(row_indices.begin(), row_indices.end(), std::size_t{0});
+        return Selection{std::move(row_indices), num_rows};
+    }
+
+    const std::vector<std::size_t>& getRowIndices () const {
+        return row_indices_;
+    }
+
+    std::size_t getSize () const {
+        return row_indices_.size();
+    }
+
+    std::size_t getNumberOfRows () const {
+        return num_rows_;
+    }
+
+    friend Selection operator& (const Selection& lhs, const Selection& rhs) {
+        assureSameNumberOfRows(lhs, rhs);
+        std::vector<std::size_t> row_indices{};
+        row_indices.reserve(std::min(lhs.getSize(), rhs.getSize()));
+        std::set_intersection(lhs.row_indices_.begin(), lhs.row_indices_.end(), rhs.row_indices_.begin(), rhs.row_indices_.end(), std::back_inserter(row_indices));
+        return Selection{std::move(row_indices), lhs.num_rows_};
+    }
+
+    friend Selection operator| (const Selection& lhs, const Selection& rhs) {
+        assureSameNumberOfRows(lhs, rhs);
+        std::vector<std::size_t> row_indices{};
+        row_indices.reserve(std::min(lhs.getSize() + rhs.getSize(), lhs.num_rows_));
+        std::set_union(lhs.row_indices_.begin(), lhs.row_indices_.end(), rhs.row_indices_.begin(), rhs.row_indices_.end(), std::back_inserter(row_indices));
+        return Selection{std::move(row_indices), lhs.num_rows_};
+    }
+
+    Selection operator~ () const {
+        std::vector<std::size_t> row_indices{};
+        row_indices.reserve(num_rows_ - getSize());
+        auto selected_iterator = row_indices_.begin();
+        for (std::size_t row_index = 0; row_index < num_rows_; ++row_index) {
+            if (selected_iterator != row_indices_.end() && *selected_iterator == row_index) {
+                ++selected_iterator;
+            }
+            else {
+                row_indices.push_back(row_index);
+            }
+        }
+        return Selection{std::move(row_indices), num_rows_};
+    }
+
+    friend bool operator== (const Selection& lhs, const Selection& rhs) = default;
+
+private:
+    static void assureSameNumberOfRows (const Selection& lhs, const Selection& rhs) {
+        if (lhs.num_rows_ != rhs.num_rows_) {
+            throw std::invalid_argument("selections must refer to DataFrames with the same number of rows");
+        }
+    }
+
+    std::vector<std::size_t> row_indices_{};
+    std::size_t num_rows_ {0};
+};
+
+namespace internal {
+
+// ############################################################################
+// Util: Select Rows
+// ############################################################################
+/**
+ * Returns the selection of rows in [0, num_rows) for which the predicate returns true.
+*/
+template <typename Predicate>
+Selection selectRows (std::size_t num_rows, Predicate&& predicate) {
+    std::vector<std::size_t> row_indices{};
+    for (std::size_t row_index = 0; row_index < num_rows; ++row_index) {
+        if (predicate(row_index)) {
+            row_indices.push_back(row_index);
+        }
+    }
+    return Selection{std::move(row_indices), num_rows};
+}
+
+/**
+ * Returns the subset of the selection for which the predicate returns true.
+*/
+template <typename Predicate>
+Selection selectRows (const Selection& selection, Predicate&& predicate) {
+    std::vector<std::size_t> row_indices{};
+    for (auto row_index : selection.getRowIndices()) {
+        if (predicate(row_index)) {
+            row_indices.push_back(row_index);
+        }
+    }
+    return Selection{std::move(row_indices), selection.getNumberOfRows()};
+}
+
+/**
+ * Returns the selection of rows in [0, num_rows) for which the predicate returns true, evaluating
+ * the predicate for morsels of rows on up to num_threads threads. The row indices of the morsels
+ * are concatenated in the order of the morsels.
+*/
+template <typename Predicate>
+Selection selectRowsParallel (std::size_t num_rows, std::size_t num_threads, Predicate&& predicate) {
+    std::vector<std::vector<std::size_t>> morsel_row_indices(getNumberOfMorsels(num_rows));
+    parallelForMorsels(num_rows, num_threads, [&](std::size_t morsel_index, std::size_t begin, std::size_t end) {
+        auto& row_indices = morsel_row_indices[morsel_index];
+        for (std::size_t row_index = begin; row_index < end; ++row_index) {
+            if (predicate(row_index)) {
+                row_indices.push_back(row_index);
+            }
+        }
+    });
+
+    std::size_t num_selected_rows {0};
+    for (const auto& row_indices : morsel_row_indices) {
+        num_selected_rows += row_indices.size();
+    }
+    std::vector<std::size_t> row_indices{};
+    row_indices.reserve(num_selected_rows);
+    for (const auto& morsel : morsel_row_indices) {
+        row_indices.insert(row_indices.end(), morsel.begin(), morsel.end());
+    }
+    return Selection{std::move(row_indices), num_rows};
+}
+
+} // namespace internal
+
+} // namespace dacr
+
+#endif // DATA_CRUNCHING_INTERNAL_DATAFRAME_QUERY_HPP
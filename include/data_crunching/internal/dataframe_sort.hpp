@@ -15,7 +15,24 @@
 #ifndef DATA_CRUNCHING_INTERNAL_DATAFRAME_SORT_HPP
 #define DATA_CRUNCHING_INTERNAL_DATAFRAME_SORT_HPP
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <string>
+#include <tuple>
 #include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "data_crunching/internal/categorical.hpp"
+#include "data_crunching/internal/column.hpp"
+#include "data_crunching/internal/fixed_string.hpp"
+#include "data_crunching/internal/name_list.hpp"
+#include "data_crunching/internal/parallel.hpp"
+#include "data_crunching/internal/type_list.hpp"
 
 namespace dacr {
 
@@ -24,8 +41,127 @@ enum class SortOrder {
     Descending,
 };
 
+template <FixedString ColumnName>
+struct Asc {
+    static constexpr SortOrder Order = SortOrder::Ascending;
+    using Names = internal::NameList<ColumnName>;
+};
+
+template <FixedString ColumnName>
+struct Desc {
+    static constexpr SortOrder Order = SortOrder::Descending;
+    using Names = internal::NameList<ColumnName>;
+};
+
 namespace internal {
 
+// ############################################################################
+// Concept: Is Sort Key Spec
+// ############################################################################
+template <typename>
+struct IsSortKeySpecImpl : std::false_type {};
+
+template <FixedString ColumnName>
+struct IsSortKeySpecImpl<Asc<ColumnName>> : std::true_type {};
+
+template <FixedString ColumnName>
+struct IsSortKeySpecImpl<Desc<ColumnName>> : std::true_type {};
+
+template <typename T>
+concept IsSortKeySpec = IsSortKeySpecImpl<T>::value;
+
+// ############################################################################
+// Trait: Sort Keys
+// ############################################################################
+/**
+ * A sort key is the column index and the sort order of one column to sort by.
+*/
+template <SortOrder Order, std::size_t ColumnIndex>
+struct SortKey {};
+
+template <SortOrder, typename>
+struct ConstructSortKeysImpl {};
+
+template <SortOrder Order, std::size_t ...Indices>
+struct ConstructSortKeysImpl<Order, std::integer_sequence<std::size_t, Indices...>> {
+    using type = TypeList<SortKey<Order, Indices>...>;
+};
+
+/**
+ * Constructs the sort keys for the same sort order applied to all column indices.
+*/
+template <SortOrder Order, typename Indices>
+using ConstructSortKeys = typename ConstructSortKeysImpl<Order, Indices>::type;
+
+template <typename, typename ...>
+struct GetSortKeyBySpecImpl {};
+
+template <FixedString ColumnName, typename ...Columns>
+struct GetSortKeyBySpecImpl<Asc<ColumnName>, Columns...> {
+    using type = SortKey<SortOrder::Ascending, get_column_index_by_name<ColumnName, Columns...>>;
+};
+
+template <FixedString ColumnName, typename ...Columns>
+struct GetSortKeyBySpecImpl<Desc<ColumnName>, Columns...> {
+    using type = SortKey<SortOrder::Descending, get_column_index_by_name<ColumnName, Columns...>>;
+};
+
+/**
+ * Constructs the sort keys for the sort key specs, e.g. Asc<"a">, Desc<"b">.
+*/
+template <typename SortKeySpecs, typename ...Columns>
+struct ConstructSortKeysBySpecsImpl {};
+
+template <typename ...SortKeySpecs, typename ...Columns>
+struct ConstructSortKeysBySpecsImpl<TypeList<SortKeySpecs...>, Columns...> {
+    using type = TypeList<typename GetSortKeyBySpecImpl<SortKeySpecs, Columns...>::type...>;
+};
+
+template <typename SortKeySpecs, typename ...Columns>
+using ConstructSortKeysBySpecs = typename ConstructSortKeysBySpecsImpl<SortKeySpecs, Columns...>::type;
+
+template <typename>
+struct GetSortKeyIndicesImpl {};
+
+template <SortOrder ...Orders, std::size_t ...Indices>
+struct GetSortKeyIndicesImpl<TypeList<SortKey<Orders, Indices>...>> {
+    using type = std::integer_sequence<std::size_t, Indices...>;
+};
+
+template <typename SortKeys>
+using GetSortKeyIndices = typename GetSortKeyIndicesImpl<SortKeys>::type;
+
+// ############################################################################
+// Trait: Is Valid Sort Key Spec List
+// ############################################################################
+template <typename ...>
+struct GetSortKeySpecNamesImpl {
+    using type = NameList<>;
+};
+
+template <typename FirstSortKeySpec, typename ...RestSortKeySpecs>
+struct GetSortKeySpecNamesImpl<FirstSortKeySpec, RestSortKeySpecs...> {
+    using type = NameListMerge<typename FirstSortKeySpec::Names, typename GetSortKeySpecNamesImpl<RestSortKeySpecs...>::type>;
+};
+
+template <typename ...SortKeySpecs>
+using GetSortKeySpecNames = typename GetSortKeySpecNamesImpl<SortKeySpecs...>::type;
+
+template <typename, typename ...>
+struct IsValidSortKeySpecListImpl : std::false_type {};
+
+template <IsSortKeySpec ...SortKeySpecs, typename ...Columns>
+struct IsValidSortKeySpecListImpl<TypeList<SortKeySpecs...>, Columns...> {
+    static constexpr bool value = (
+        sizeof...(SortKeySpecs) > 0 &&
+        are_names_unique<GetSortKeySpecNames<SortKeySpecs...>> &&
+        are_names_in_columns<GetSortKeySpecNames<SortKeySpecs...>, Columns...>
+    );
+};
+
+template <typename SortKeySpecs, typename ...Columns>
+constexpr bool is_valid_sort_key_spec_list = IsValidSortKeySpecListImpl<SortKeySpecs, Columns...>::value;
+
 // ############################################################################
 // Trait: Element Comparison
 // ############################################################################
@@ -59,21 +195,27 @@ struct CompareElementsForSort {
 // ############################################################################
 // Trait: Construct Element Comparison
 // ############################################################################
-template <SortOrder, typename>
-struct ConstructElementComparisonImpl {};
+template <typename>
+struct ConstructElementComparisonBySortKeysImpl {};
 
-template <SortOrder Order, std::size_t LastIndex>
-struct ConstructElementComparisonImpl<Order, std::integer_sequence<std::size_t, LastIndex>> {
-    using type = CompareElementsForSort<Order, LastIndex, void>;
+template <SortOrder LastOrder, std::size_t LastIndex>
+struct ConstructElementComparisonBySortKeysImpl<TypeList<SortKey<LastOrder, LastIndex>>> {
+    using type = CompareElementsForSort<LastOrder, LastIndex, void>;
 };
 
-template <SortOrder Order, std::size_t FirstIndex, std::size_t ...RestIndices>
-struct ConstructElementComparisonImpl<Order, std::integer_sequence<std::size_t, FirstIndex, RestIndices...>> {
-    using type = CompareElementsForSort<Order, FirstIndex, typename ConstructElementComparisonImpl<Order, std::integer_sequence<std::size_t, RestIndices...>>::type>;
+template <SortOrder FirstOrder, std::size_t FirstIndex, typename SecondSortKey, typename ...RestSortKeys>
+struct ConstructElementComparisonBySortKeysImpl<TypeList<SortKey<FirstOrder, FirstIndex>, SecondSortKey, RestSortKeys...>> {
+    using type = CompareElementsForSort<FirstOrder, FirstIndex, typename ConstructElementComparisonBySortKeysImpl<TypeList<SecondSortKey, RestSortKeys...>>::type>;
 };
 
+/**
+ * Constructs the element comparison with an individual sort order per column.
+*/
+template <typename SortKeys>
+using ConstructElementComparisonBySortKeys = typename ConstructElementComparisonBySortKeysImpl<SortKeys>::type;
+
 template <SortOrder Order, typename Indices>
-using ConstructElementComparison = typename ConstructElementComparisonImpl<Order, Indices>::type;
+using ConstructElementComparison = ConstructElementComparisonBySortKeys<ConstructSortKeys<Order, Indices>>;
 
 
 // ############################################################################
@@ -103,6 +245,510 @@ private:
     std::size_t index_;
 };
 
+// ############################################################################
+// Util: Compare Rows Across Column Stores
+// ############################################################################
+/**
+ * Checks if the row of the lhs column store is sorted before the row of the rhs column store.
+*/
+template <typename ColumnStoreData, SortOrder FirstOrder, std::size_t FirstIndex, typename ...RestSortKeys>
+inline bool isRowBeforeBySortKeys (
+    const ColumnStoreData& lhs, std::size_t row_index_lhs,
+    const ColumnStoreData& rhs, std::size_t row_index_rhs,
+    TypeList<SortKey<FirstOrder, FirstIndex>, RestSortKeys...>
+) {
+    const auto& value_lhs = std::get<FirstIndex>(lhs)[row_index_lhs];
+    const auto& value_rhs = std::get<FirstIndex>(rhs)[row_index_rhs];
+    if constexpr (FirstOrder == SortOrder::Ascending) {
+        if (value_lhs < value_rhs) {
+            return true;
+        }
+        if (value_rhs < value_lhs) {
+            return false;
+        }
+    }
+    else {
+        if (value_lhs > value_rhs) {
+            return true;
+        }
+        if (value_rhs > value_lhs) {
+            return false;
+        }
+    }
+    if constexpr (sizeof...(RestSortKeys) > 0) {
+        return isRowBeforeBySortKeys(lhs, row_index_lhs, rhs, row_index_rhs, TypeList<RestSortKeys...>{});
+    }
+    else {
+        return false;
+    }
+}
+
+// ############################################################################
+// Util: Argsort
+// ############################################################################
+/**
+ * Returns the permutation of row indices which sorts the column store by the element comparison.
+*/
+template <typename ElementComparison, typename ColumnStoreData>
+std::vector<std::size_t> argsortRows (const ColumnStoreData& column_store_data, std::size_t size) {
+    std::vector<std::size_t> row_indices(size);
+    std::iota(row_indices.begin(), row_indices.end(), std::size_t{0});
+    std::sort(row_indices.begin(), row_indices.end(), [&](std::size_t lhs, std::size_t rhs) {
+        return ElementComparison::compare(column_store_data, lhs, rhs);
+    });
+    return row_indices;
+}
+
+/**
+ * Returns the permutation of row indices which sorts the column store by the element comparison,
+ * keeping the original order of rows comparing equal.
+*/
+template <typename ElementComparison, typename ColumnStoreData>
+std::vector<std::size_t> argsortRowsStable (const ColumnStoreData& column_store_data, std::size_t size) {
+    std::vector<std::size_t> row_indices(size);
+    std::iota(row_indices.begin(), row_indices.end(), std::size_t{0});
+    std::stable_sort(row_indices.begin(), row_indices.end(), [&](std::size_t lhs, std::size_t rhs) {
+        return ElementComparison::compare(column_store_data, lhs, rhs);
+    });
+    return row_indices;
+}
+
+// ############################################################################
+// Util: String Prefix Argsort
+// ############################################################################
+template <typename, typename>
+struct HasStringPrefixKeyImpl : std::false_type {};
+
+template <SortOrder FirstOrder, std::size_t FirstIndex, typename ...RestSortKeys, typename ColumnStoreData>
+struct HasStringPrefixKeyImpl<TypeList<SortKey<FirstOrder, FirstIndex>, RestSortKeys...>, ColumnStoreData> {
+    static constexpr bool value = std::is_same_v<typename std::tuple_element_t<FirstIndex, ColumnStoreData>::value_type, std::string>;
+};
+
+/**
+ * Checks if the first sort key is a string column which is sorted by its normalized prefix.
+*/
+template <typename SortKeys, typename ColumnStoreData>
+constexpr bool has_string_prefix_key = HasStringPrefixKeyImpl<SortKeys, ColumnStoreData>::value;
+
+/**
+ * Returns the first 8 bytes of the string packed big-endian into an integer (padded with zero bytes),
+ * such that the order of the prefixes matches the lexicographical order of the strings up to ties.
+*/
+template <SortOrder Order>
+inline std::uint64_t toStringPrefixKey (const std::string& value) {
+    std::uint64_t key {0};
+    const std::size_t prefix_size = std::min(value.size(), sizeof(std::uint64_t));
+    for (std::size_t i = 0; i < prefix_size; ++i) {
+        key |= static_cast<std::uint64_t>(static_cast<unsigned char>(value[i])) << (8 * (sizeof(std::uint64_t) - 1 - i));
+    }
+    if constexpr (Order == SortOrder::Descending) {
+        key = ~key;
+    }
+    return key;
+}
+
+struct PrefixKeyedRow {
+    std::uint64_t prefix;
+    std::size_t row_index;
+};
+
+/**
+ * Returns the sorting permutation for sort keys starting with a string column.
+ *
+ * The rows are sorted by their normalized string prefix (see toStringPrefixKey) stored next to the row index,
+ * i.e. most comparisons do not access the strings. Only rows with equal prefixes are compared by the element
+ * comparison on all sort keys.
+*/
+template <typename SortKeys, bool Stable, typename ColumnStoreData>
+std::vector<std::size_t> argsortRowsByStringPrefix (const ColumnStoreData& column_store_data, std::size_t size) {
+    using ElementComparison = ConstructElementComparisonBySortKeys<SortKeys>;
+    constexpr auto first_sort_key = []<SortOrder FirstOrder, std::size_t FirstIndex, typename ...RestSortKeys>(TypeList<SortKey<FirstOrder, FirstIndex>, RestSortKeys...>) {
+        return std::make_pair(FirstOrder, FirstIndex);
+    }(SortKeys{});
+
+    const auto& prefix_column = std::get<first_sort_key.second>(column_store_data);
+    std::vector<PrefixKeyedRow> rows(size);
+    for (std::size_t row_index = 0; row_index < size; ++row_index) {
+        rows[row_index] = PrefixKeyedRow{toStringPrefixKey<first_sort_key.first>(prefix_column[row_index]), row_index};
+    }
+    auto is_before = [&](const PrefixKeyedRow& lhs, const PrefixKeyedRow& rhs) {
+        if (lhs.prefix != rhs.prefix) {
+            return lhs.prefix < rhs.prefix;
+        }
+        return ElementComparison::compare(column_store_data, lhs.row_index, rhs.row_index);
+    };
+    if constexpr (Stable) {
+        std::stable_sort(rows.begin(), rows.end(), is_before);
+    }
+    else {
+        std::sort(rows.begin(), rows.end(), is_before);
+    }
+
+    std::vector<std::size_t> row_indices(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        row_indices[i] = rows[i].row_index;
+    }
+    return row_indices;
+}
+
+// ############################################################################
+// Util: Categorical Rank Argsort
+// ############################################################################
+template <typename, typename>
+struct HasCategoricalKeyImpl : std::false_type {};
+
+template <SortOrder FirstOrder, std::size_t FirstIndex, typename ...RestSortKeys, typename ColumnStoreData>
+struct HasCategoricalKeyImpl<TypeList<SortKey<FirstOrder, FirstIndex>, RestSortKeys...>, ColumnStoreData> {
+    static constexpr bool value = std::is_same_v<typename std::tuple_element_t<FirstIndex, ColumnStoreData>::value_type, Categorical>;
+};
+
+/**
+ * Checks if the first sort key is a categorical column which is sorted by the ranks of its codes.
+*/
+template <typename SortKeys, typename ColumnStoreData>
+constexpr bool has_categorical_key = HasCategoricalKeyImpl<SortKeys, ColumnStoreData>::value;
+
+struct RankKeyedRow {
+    std::uint32_t rank;
+    std::size_t row_index;
+};
+
+/**
+ * Returns the sorting permutation for sort keys starting with a categorical column.
+ *
+ * The lexicographical rank of each distinct code is computed once, such that the rows are sorted by
+ * comparing integers. Only rows with equal codes are compared by the element comparison on
+ * the remaining sort keys.
+*/
+template <typename SortKeys, bool Stable, typename ColumnStoreData>
+std::vector<std::size_t> argsortRowsByCategoricalRank (const ColumnStoreData& column_store_data, std::size_t size) {
+    using ElementComparison = ConstructElementComparisonBySortKeys<SortKeys>;
+    constexpr auto first_sort_key = []<SortOrder FirstOrder, std::size_t FirstIndex, typename ...RestSortKeys>(TypeList<SortKey<FirstOrder, FirstIndex>, RestSortKeys...>) {
+        return std::make_pair(FirstOrder, FirstIndex);
+    }(SortKeys{});
+
+    const auto& categorical_column = std::get<first_sort_key.second>(column_store_data);
+    const auto ranks = rankCategoricalCodes(categorical_column, size);
+    std::vector<RankKeyedRow> rows(size);
+    for (std::size_t row_index = 0; row_index < size; ++row_index) {
+        const std::uint32_t rank = ranks.find(categorical_column[row_index].getCode())->second;
+        rows[row_index] = RankKeyedRow{first_sort_key.first == SortOrder::Ascending ? rank : ~rank, row_index};
+    }
+    auto is_before = [&](const RankKeyedRow& lhs, const RankKeyedRow& rhs) {
+        if (lhs.rank != rhs.rank) {
+            return lhs.rank < rhs.rank;
+        }
+        return ElementComparison::compare(column_store_data, lhs.row_index, rhs.row_index);
+    };
+    if constexpr (Stable) {
+        std::stable_sort(rows.begin(), rows.end(), is_before);
+    }
+    else {
+        std::sort(rows.begin(), rows.end(), is_before);
+    }
+
+    std::vector<std::size_t> row_indices(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        row_indices[i] = rows[i].row_index;
+    }
+    return row_indices;
+}
+
+// ############################################################################
+// Util: Parallel Argsort
+// ############################################################################
+inline constexpr std::size_t MIN_ROWS_PER_SORT_RUN = 1UL << 14;
+
+/**
+ * Strict total order of rows: the element comparison with the row index as tie-breaker.
+*/
+template <typename ElementComparison, typename ColumnStoreData>
+inline bool isRowBefore (const ColumnStoreData& column_store_data, std::size_t lhs, std::size_t rhs) {
+    if (ElementComparison::compare(column_store_data, lhs, rhs)) {
+        return true;
+    }
+    return not ElementComparison::compare(column_store_data, rhs, lhs) && lhs < rhs;
+}
+
+/**
+ * Merges the sorted ranges [run_ranges[i].first, run_ranges[i].second) of row indices into output
+ * by repeatedly taking the first row of the run at the top of a heap.
+*/
+template <typename IsBefore>
+void mergeSortedRuns (const std::vector<std::size_t>& row_indices, std::vector<std::pair<std::size_t, std::size_t>> run_ranges, std::size_t* output, IsBefore is_before) {
+    std::erase_if(run_ranges, [](const auto& run_range) { return run_range.first == run_range.second; });
+    auto is_after_in_heap = [&](const auto& lhs, const auto& rhs) {
+        return is_before(row_indices[rhs.first], row_indices[lhs.first]);
+    };
+    std::make_heap(run_ranges.begin(), run_ranges.end(), is_after_in_heap);
+    while (not run_ranges.empty()) {
+        std::pop_heap(run_ranges.begin(), run_ranges.end(), is_after_in_heap);
+        auto& run_range = run_ranges.back();
+        *output++ = row_indices[run_range.first++];
+        if (run_range.first == run_range.second) {
+            run_ranges.pop_back();
+        }
+        else {
+            std::push_heap(run_ranges.begin(), run_ranges.end(), is_after_in_heap);
+        }
+    }
+}
+
+/**
+ * Returns the sorting permutation computed by a parallel multi-way merge sort.
+ *
+ * The row indices are split into one run per thread which are sorted independently. Splitter rows
+ * are then chosen from a regular sample of the sorted runs, such that the output is partitioned into
+ * ranges that are merged from all runs independently (parallel sorting by regular sampling).
+ * Rows comparing equal are ordered by their row index, i.e. the sort is stable.
+*/
+template <typename ElementComparison, typename ColumnStoreData>
+std::vector<std::size_t> argsortRowsParallel (const ColumnStoreData& column_store_data, std::size_t size, std::size_t num_threads) {
+    const std::size_t num_runs = std::clamp(size / MIN_ROWS_PER_SORT_RUN, std::size_t{1}, num_threads);
+    auto is_before = [&](std::size_t lhs, std::size_t rhs) {
+        return isRowBefore<ElementComparison>(column_store_data, lhs, rhs);
+    };
+
+    std::vector<std::size_t> row_indices(size);
+    std::iota(row_indices.begin(), row_indices.end(), std::size_t{0});
+    if (num_runs == 1) {
+        std::sort(row_indices.begin(), row_indices.end(), is_before);
+        return row_indices;
+    }
+
+    // sort the runs
+    parallelFor(num_runs, num_threads, [&](std::size_t run_index) {
+        const auto [begin, end] = getChunkRange(size, num_runs, run_index);
+        std::sort(row_indices.begin() + begin, row_indices.begin() + end, is_before);
+    });
+
+    // select the splitters from a regular sample of the runs
+    std::vector<std::size_t> samples{};
+    samples.reserve(num_runs * num_runs);
+    for (std::size_t run_index = 0; run_index < num_runs; ++run_index) {
+        const auto [begin, end] = getChunkRange(size, num_runs, run_index);
+        for (std::size_t sample_index = 0; sample_index < num_runs; ++sample_index) {
+            samples.push_back(row_indices[begin + (end - begin) * sample_index / num_runs]);
+        }
+    }
+    std::sort(samples.begin(), samples.end(), is_before);
+
+    // split each run at the splitters: part p of run r is [bounds[r][p], bounds[r][p + 1])
+    const std::size_t num_parts = num_runs;
+    std::vector<std::vector<std::size_t>> bounds(num_runs, std::vector<std::size_t>(num_parts + 1));
+    parallelFor(num_runs, num_threads, [&](std::size_t run_index) {
+        const auto [begin, end] = getChunkRange(size, num_runs, run_index);
+        bounds[run_index][0] = begin;
+        for (std::size_t part_index = 1; part_index < num_parts; ++part_index) {
+            const std::size_t splitter = samples[part_index * num_runs];
+            bounds[run_index][part_index] = static_cast<std::size_t>(
+                std::lower_bound(row_indices.begin() + bounds[run_index][part_index - 1], row_indices.begin() + end, splitter, is_before) - row_indices.begin()
+            );
+        }
+        bounds[run_index][num_parts] = end;
+    });
+
+    // merge the parts of all runs
+    std::vector<std::size_t> part_offsets(num_parts + 1, 0);
+    for (std::size_t part_index = 0; part_index < num_parts; ++part_index) {
+        part_offsets[part_index + 1] = part_offsets[part_index];
+        for (std::size_t run_index = 0; run_index < num_runs; ++run_index) {
+            part_offsets[part_index + 1] += bounds[run_index][part_index + 1] - bounds[run_index][part_index];
+        }
+    }
+    std::vector<std::size_t> sorted_row_indices(size);
+    parallelFor(num_parts, num_threads, [&](std::size_t part_index) {
+        std::vector<std::pair<std::size_t, std::size_t>> run_ranges{};
+        run_ranges.reserve(num_runs);
+        for (std::size_t run_index = 0; run_index < num_runs; ++run_index) {
+            run_ranges.emplace_back(bounds[run_index][part_index], bounds[run_index][part_index + 1]);
+        }
+        mergeSortedRuns(row_indices, std::move(run_ranges), sorted_row_indices.data() + part_offsets[part_index], is_before);
+    });
+    return sorted_row_indices;
+}
+
+// ############################################################################
+// Util: Top Rows
+// ############################################################################
+/**
+ * Returns the indices of the first k rows in the order of the element comparison (or all rows if k >= size).
+ *
+ * The rows are selected with a bounded heap of size k whose top is the last of the currently
+ * selected rows, i.e. the cost is O(n log k) and only k row indices are kept. Rows comparing
+ * equal are ordered by their row index.
+*/
+template <typename ElementComparison, typename ColumnStoreData>
+std::vector<std::size_t> argsortTopRows (const ColumnStoreData& column_store_data, std::size_t size, std::size_t k) {
+    auto is_before = [&](std::size_t lhs, std::size_t rhs) {
+        return isRowBefore<ElementComparison>(column_store_data, lhs, rhs);
+    };
+    std::vector<std::size_t> top_row_indices{};
+    top_row_indices.reserve(std::min(k, size));
+    for (std::size_t row_index = 0; row_index < size && k > 0; ++row_index) {
+        if (top_row_indices.size() < k) {
+            top_row_indices.push_back(row_index);
+            std::push_heap(top_row_indices.begin(), top_row_indices.end(), is_before);
+        }
+        else if (is_before(row_index, top_row_indices.front())) {
+            std::pop_heap(top_row_indices.begin(), top_row_indices.end(), is_before);
+            top_row_indices.back() = row_index;
+            std::push_heap(top_row_indices.begin(), top_row_indices.end(), is_before);
+        }
+    }
+    std::sort_heap(top_row_indices.begin(), top_row_indices.end(), is_before);
+    return top_row_indices;
+}
+
+// ############################################################################
+// Trait: Column Store Value Types
+// ############################################################################
+template <typename, typename>
+struct GetColumnStoreValueTypes {};
+
+template <typename ColumnStoreData, std::size_t ...Indices>
+struct GetColumnStoreValueTypes<ColumnStoreData, std::integer_sequence<std::size_t, Indices...>> {
+    using type = TypeList<typename std::tuple_element_t<Indices, ColumnStoreData>::value_type...>;
+    static constexpr std::size_t bits = (sizeof(typename std::tuple_element_t<Indices, ColumnStoreData>::value_type) + ... + 0) * 8;
+};
+
+// ############################################################################
+// Trait: Radix Sort Keys
+// ############################################################################
+template <typename T>
+concept IsRadixSortKey = (std::is_integral_v<T> || std::is_floating_point_v<T>) && sizeof(T) <= 8;
+
+#if defined(__SIZEOF_INT128__)
+inline constexpr std::size_t max_radix_key_bits = 128;
+#else
+inline constexpr std::size_t max_radix_key_bits = 64;
+#endif
+
+template <typename>
+struct IsRadixSortableImpl : std::false_type {};
+
+template <typename ...Types>
+struct IsRadixSortableImpl<TypeList<Types...>> {
+    static constexpr bool value = (IsRadixSortKey<Types> && ...) && (sizeof(Types) + ... + 0) * 8 <= max_radix_key_bits;
+};
+
+/**
+ * Checks if the sort keys of the given types can be packed into a single radix key of at most 128 bits.
+*/
+template <typename Types>
+constexpr bool is_radix_sortable = IsRadixSortableImpl<Types>::value;
+
+template <std::size_t Bits>
+using GetRadixKeyType = std::conditional_t<(Bits <= 32), std::uint32_t,
+#if defined(__SIZEOF_INT128__)
+    std::conditional_t<(Bits <= 64), std::uint64_t, unsigned __int128>
+#else
+    std::uint64_t
+#endif
+>;
+
+// ############################################################################
+// Util: Radix Sort Key
+// ############################################################################
+/**
+ * Transforms a value into an unsigned key with the same order as the value.
+ *
+ * Signed integers get the sign bit flipped. For IEEE floating-point numbers, all bits are flipped
+ * for negative numbers and only the sign bit for positive numbers (-0.0 is mapped to +0.0 as both
+ * compare equal). Descending order inverts the key.
+*/
+template <SortOrder Order, IsRadixSortKey T>
+inline std::uint64_t toRadixKey (T value) {
+    constexpr std::size_t bits = sizeof(T) * 8;
+    constexpr std::uint64_t mask = bits == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << bits) - 1;
+    constexpr std::uint64_t sign_bit = std::uint64_t{1} << (bits - 1);
+
+    std::uint64_t key {0};
+    if constexpr (std::is_floating_point_v<T>) {
+        using Bits = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+        if (value == T{0}) {
+            value = T{0};
+        }
+        key = std::bit_cast<Bits>(value);
+        key = (key & sign_bit) ? (~key & mask) : (key | sign_bit);
+    }
+    else if constexpr (std::is_signed_v<T>) {
+        key = (static_cast<std::uint64_t>(static_cast<std::make_unsigned_t<T>>(value)) ^ sign_bit) & mask;
+    }
+    else {
+        key = static_cast<std::uint64_t>(value);
+    }
+
+    if constexpr (Order == SortOrder::Descending) {
+        key = ~key & mask;
+    }
+    return key;
+}
+
+template <typename RadixKey, typename ColumnStoreData, SortOrder ...Orders, std::size_t ...Indices>
+inline RadixKey packRadixKey (const ColumnStoreData& column_store_data, std::size_t row_index, TypeList<SortKey<Orders, Indices>...>) {
+    RadixKey key {0};
+    auto append = [&key]<SortOrder Order, typename T>(T value) {
+        if constexpr (sizeof(T) * 8 < sizeof(RadixKey) * 8) {
+            key = static_cast<RadixKey>((key << (sizeof(T) * 8)) | toRadixKey<Order>(value));
+        }
+        else {
+            key = static_cast<RadixKey>(toRadixKey<Order>(value));
+        }
+    };
+    (append.template operator()<Orders>(static_cast<typename std::tuple_element_t<Indices, ColumnStoreData>::value_type>(std::get<Indices>(column_store_data)[row_index])), ...);
+    return key;
+}
+
+// ############################################################################
+// Util: Radix Argsort
+// ############################################################################
+inline constexpr std::size_t MIN_ROWS_FOR_RADIX_SORT = 256;
+
+/**
+ * Returns the sorting permutation by a LSD radix sort (8 bits per pass) over keys packing all sort columns.
+ *
+ * Passes in which all keys share the same byte are skipped. Rows with equal keys keep their original order.
+*/
+template <typename SortKeys, typename ColumnStoreData>
+std::vector<std::size_t> argsortRowsByRadix (const ColumnStoreData& column_store_data, std::size_t size) {
+    using ColumnIndices = GetSortKeyIndices<SortKeys>;
+    using ColumnTypes = typename GetColumnStoreValueTypes<ColumnStoreData, ColumnIndices>::type;
+    static_assert(is_radix_sortable<ColumnTypes>);
+    constexpr std::size_t key_bits = GetColumnStoreValueTypes<ColumnStoreData, ColumnIndices>::bits;
+    using RadixKey = GetRadixKeyType<key_bits>;
+
+    std::vector<RadixKey> keys(size);
+    std::vector<std::size_t> row_indices(size);
+    for (std::size_t row_index = 0; row_index < size; ++row_index) {
+        keys[row_index] = packRadixKey<RadixKey>(column_store_data, row_index, SortKeys{});
+        row_indices[row_index] = row_index;
+    }
+
+    std::vector<RadixKey> keys_buffer(size);
+    std::vector<std::size_t> row_indices_buffer(size);
+    for (std::size_t shift = 0; shift < key_bits; shift += 8) {
+        std::array<std::size_t, 256> offsets{};
+        for (const auto& key : keys) {
+            ++offsets[static_cast<std::size_t>(key >> shift) & 0xFF];
+        }
+        if (size == 0 || offsets[static_cast<std::size_t>(keys[0] >> shift) & 0xFF] == size) {
+            continue;
+        }
+        std::size_t offset {0};
+        for (auto& bucket_offset : offsets) {
+            offset += std::exchange(bucket_offset, offset);
+        }
+        for (std::size_t i = 0; i < size; ++i) {
+            const std::size_t target = offsets[static_cast<std::size_t>(keys[i] >> shift) & 0xFF]++;
+            keys_buffer[target] = keys[i];
+            row_indices_buffer[target] = row_indices[i];
+        }
+        keys.swap(keys_buffer);
+        row_indices.swap(row_indices_buffer);
+    }
+    return row_indices;
+}
 
 } // namespace internal
 
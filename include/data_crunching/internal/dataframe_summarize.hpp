@@ -12,10 +12,18 @@
 //  See the License for the specific language governing permissions and
 //  limitations under the License.
 
-#ifndef DATA_CRUNCHING_INTERNAL_DATAFRDATA_CRUNCHING_INTERNAL_DATAFRAME_SUMMARIZE_HPPAME_SUMMARIZE_HPP
+#ifndef DATA_CRUNCHING_INTERNAL_DATAFRAME_SUMMARIZE_HPP
 #define DATA_CRUNCHING_INTERNAL_DATAFRAME_SUMMARIZE_HPP
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <tuple>
+#include <vector>
+
+#include "data_crunching/internal/column_kernels.hpp"
 #include "data_crunching/internal/fixed_string.hpp"
+#include "data_crunching/internal/hash.hpp"
 #include "data_crunching/internal/utils.hpp"
 #include "data_crunching/internal/name_list.hpp"
 #include "data_crunching/internal/type_list.hpp"
@@ -46,6 +54,15 @@ struct Avg {};
 template <FixedString ColumnName, FixedString NewColumnName>
 struct StdDev {};
 
+template <FixedString ColumnName, FixedString NewColumnName>
+struct StdDevSample {};
+
+template <FixedString ColumnName, FixedString NewColumnName>
+struct Variance {};
+
+template <FixedString ColumnName, FixedString NewColumnName>
+struct VarianceSample {};
+
 template <FixedString ColumnName, FixedString NewColumnName>
 struct CountIf {};
 
@@ -91,6 +108,15 @@ struct IsSummarizeOpImpl<Avg<ColumnName, NewColumnName>> : std::true_type {};
 template <FixedString ColumnName, FixedString NewColumnName>
 struct IsSummarizeOpImpl<StdDev<ColumnName, NewColumnName>> : std::true_type {};
 
+template <FixedString ColumnName, FixedString NewColumnName>
+struct IsSummarizeOpImpl<StdDevSample<ColumnName, NewColumnName>> : std::true_type {};
+
+template <FixedString ColumnName, FixedString NewColumnName>
+struct IsSummarizeOpImpl<Variance<ColumnName, NewColumnName>> : std::true_type {};
+
+template <FixedString ColumnName, FixedString NewColumnName>
+struct IsSummarizeOpImpl<VarianceSample<ColumnName, NewColumnName>> : std::true_type {};
+
 template <FixedString ColumnName, FixedString NewColumnName>
 struct IsSummarizeOpImpl<CountIf<ColumnName, NewColumnName>> : std::true_type {};
 
@@ -113,6 +139,15 @@ public:
         sum_ += std::get<InIndex>(in)[index];
     }
 
+    template <typename DataIn>
+    void summarizeRange (const DataIn& in, std::size_t begin, std::size_t end) {
+        sum_ += sumColumn(std::get<InIndex>(in).data() + begin, end - begin);
+    }
+
+    void merge (const SummarizerSum& other) {
+        sum_ += other.sum_;
+    }
+
     T getState () const {
         return sum_;
     }
@@ -132,44 +167,117 @@ public:
         current_average_ = current_average_ + (static_cast<double>(std::get<InIndex>(in)[index]) - current_average_) / current_count_;
     }
 
+    template <typename DataIn>
+    void summarizeRange (const DataIn& in, std::size_t begin, std::size_t end) {
+        if (begin < end) {
+            const std::size_t count = end - begin;
+            mergeState(count, sumColumnAsDouble(std::get<InIndex>(in).data() + begin, count) / count);
+        }
+    }
+
+    void merge (const SummarizerAvg& other) {
+        mergeState(other.current_count_, other.current_average_);
+    }
+
     double getState () const {
         return current_average_;
     }
 
 private:
+    void mergeState (std::size_t count, double average) {
+        if (count > 0) {
+            current_count_ += count;
+            current_average_ = current_average_ + (average - current_average_) * count / current_count_;
+        }
+    }
+
     double current_average_ {0};
-    int current_count_{0};
+    std::size_t current_count_{0};
 };
 
-template <std::size_t InIndex, IsArithmetic T>
-class SummarizerStdDev {
+enum class VarianceType {
+    Population,
+    Sample,
+};
+
+/**
+ * Single-pass variance (or standard deviation) with constant memory.
+ *
+ * The values are accumulated by Welford's algorithm, partial states are merged by
+ * the parallel algorithm of Chan et al. The population variance divides by n, the
+ * sample variance by n - 1. Without sufficient values, the result is NaN.
+*/
+template <std::size_t InIndex, IsArithmetic T, VarianceType Type, bool TakeSquareRoot>
+class SummarizerVarianceImpl {
 public:
     using TargetType = double;
 
     template <typename DataIn>
     void summarize (const DataIn& in, std::size_t index) {
-        current_count_ += 1;
-        current_average_ = current_average_ + (static_cast<double>(std::get<InIndex>(in)[index]) - current_average_) / current_count_;
-        values_.push_back(std::get<InIndex>(in)[index]);
+        const double value = static_cast<double>(std::get<InIndex>(in)[index]);
+        count_ += 1;
+        const double delta = value - mean_;
+        mean_ += delta / count_;
+        sum_squared_deviations_ += delta * (value - mean_);
+    }
+
+    template <typename DataIn>
+    void summarizeRange (const DataIn& in, std::size_t begin, std::size_t end) {
+        if (begin < end) {
+            const auto* values = std::get<InIndex>(in).data() + begin;
+            const std::size_t count = end - begin;
+            const double mean = sumColumnAsDouble(values, count) / count;
+            mergeState(count, mean, sumSquaredDeviationsColumn(values, count, mean));
+        }
+    }
+
+    void merge (const SummarizerVarianceImpl& other) {
+        mergeState(other.count_, other.mean_, other.sum_squared_deviations_);
     }
 
     double getState () const {
-        if (values_.size() > 0) {
-            double stddev {0};
-            for (auto value : values_) {
-                stddev += (value - current_average_)*(value - current_average_);
-            }
-            return std::sqrt(stddev / (values_.size()));
+        const std::size_t degrees_of_freedom = Type == VarianceType::Sample ? 1 : 0;
+        if (count_ <= degrees_of_freedom) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        const double variance = sum_squared_deviations_ / (count_ - degrees_of_freedom);
+        if constexpr (TakeSquareRoot) {
+            return std::sqrt(variance);
+        }
+        else {
+            return variance;
         }
-        return std::numeric_limits<double>::quiet_NaN();
     }
 
 private:
-    double current_average_ {0};
-    int current_count_ {0};
-    std::vector<T> values_{};
+    void mergeState (std::size_t count, double mean, double sum_squared_deviations) {
+        if (count == 0) {
+            return;
+        }
+        const std::size_t total_count = count_ + count;
+        const double delta = mean - mean_;
+        mean_ += delta * count / total_count;
+        sum_squared_deviations_ += sum_squared_deviations + delta * delta * count_ * count / total_count;
+        count_ = total_count;
+    }
+
+    std::size_t count_ {0};
+    double mean_ {0};
+    double sum_squared_deviations_ {0};
 };
 
+template <std::size_t InIndex, IsArithmetic T>
+using SummarizerStdDev = SummarizerVarianceImpl<InIndex, T, VarianceType::Population, true>;
+
+template <std::size_t InIndex, IsArithmetic T>
+using SummarizerStdDevSample = SummarizerVarianceImpl<InIndex, T, VarianceType::Sample, true>;
+
+template <std::size_t InIndex, IsArithmetic T>
+using SummarizerVariance = SummarizerVarianceImpl<InIndex, T, VarianceType::Population, false>;
+
+template <std::size_t InIndex, IsArithmetic T>
+using SummarizerVarianceSample = SummarizerVarianceImpl<InIndex, T, VarianceType::Sample, false>;
+
 template <std::size_t InIndex, IsArithmetic T>
 class SummarizerMin {
 public:
@@ -182,6 +290,17 @@ public:
         }
     }
 
+    template <typename DataIn>
+    void summarizeRange (const DataIn& in, std::size_t begin, std::size_t end) {
+        min_value_ = minColumn(std::get<InIndex>(in).data() + begin, end - begin, min_value_);
+    }
+
+    void merge (const SummarizerMin& other) {
+        if (other.min_value_ < min_value_) {
+            min_value_ = other.min_value_;
+        }
+    }
+
     T getState() const {
         return min_value_;
     }
@@ -202,6 +321,17 @@ public:
         }
     }
 
+    template <typename DataIn>
+    void summarizeRange (const DataIn& in, std::size_t begin, std::size_t end) {
+        max_value_ = maxColumn(std::get<InIndex>(in).data() + begin, end - begin, max_value_);
+    }
+
+    void merge (const SummarizerMax& other) {
+        if (other.max_value_ > max_value_) {
+            max_value_ = other.max_value_;
+        }
+    }
+
     T getState() const {
         return max_value_;
     }
@@ -223,6 +353,16 @@ public:
         }
     }
 
+    template <typename DataIn>
+    void summarizeRange (const DataIn& in, std::size_t begin, std::size_t end) {
+        const auto& column = std::get<InIndex>(in);
+        count_ += static_cast<int>(std::count(column.begin() + begin, column.begin() + end, true));
+    }
+
+    void merge (const SummarizerCountIf& other) {
+        count_ += other.count_;
+    }
+
     int getState() const {
         return count_;
     }
@@ -244,6 +384,16 @@ public:
         }
     }
 
+    template <typename DataIn>
+    void summarizeRange (const DataIn& in, std::size_t begin, std::size_t end) {
+        const auto& column = std::get<InIndex>(in);
+        count_ += static_cast<int>(std::count(column.begin() + begin, column.begin() + end, false));
+    }
+
+    void merge (const SummarizerCountIfNot& other) {
+        count_ += other.count_;
+    }
+
     int getState() const {
         return count_;
     }
@@ -288,6 +438,32 @@ struct CompoundSummarizer {
     static void summarizeImpl(SummarizerData& summarizer_data, const ColumnStoreData& column_store_data, std::size_t row_index, std::integer_sequence<std::size_t, SummarizerIndices...>) {
         ((std::get<SummarizerIndices>(summarizer_data).summarize(column_store_data, row_index)), ...);
     }
+
+    /**
+     * Summarizes the rows [begin, end) column at a time by the range kernels of the summarizers.
+    */
+    template <typename SummarizerData, typename ColumnStoreData>
+    static void summarizeRange(SummarizerData& summarizer_data, const ColumnStoreData& column_store_data, std::size_t begin, std::size_t end) {
+        summarizeRangeImpl(summarizer_data, column_store_data, begin, end, std::index_sequence_for<Summarizers...>{});
+    }
+
+    template <typename SummarizerData, typename ColumnStoreData, std::size_t ...SummarizerIndices>
+    static void summarizeRangeImpl(SummarizerData& summarizer_data, const ColumnStoreData& column_store_data, std::size_t begin, std::size_t end, std::integer_sequence<std::size_t, SummarizerIndices...>) {
+        ((std::get<SummarizerIndices>(summarizer_data).summarizeRange(column_store_data, begin, end)), ...);
+    }
+
+    /**
+     * Merges the partial aggregates of other_data (e.g. of another part of the rows) into summarizer_data.
+    */
+    template <typename SummarizerData>
+    static void merge(SummarizerData& summarizer_data, const SummarizerData& other_data) {
+        mergeImpl(summarizer_data, other_data, std::index_sequence_for<Summarizers...>{});
+    }
+
+    template <typename SummarizerData, std::size_t ...SummarizerIndices>
+    static void mergeImpl(SummarizerData& summarizer_data, const SummarizerData& other_data, std::integer_sequence<std::size_t, SummarizerIndices...>) {
+        ((std::get<SummarizerIndices>(summarizer_data).merge(std::get<SummarizerIndices>(other_data))), ...);
+    }
 };
 
 // ############################################################################
@@ -332,6 +508,21 @@ struct GetSummarizerForOpImpl<StdDev<ColumnName, NewColumnName>, Columns...> {
     using type = SummarizerStdDev<get_column_index_by_name<ColumnName, Columns...>, GetColumnTypeByName<ColumnName, Columns...>>;
 };
 
+template <FixedString ColumnName, FixedString NewColumnName, typename ...Columns>
+struct GetSummarizerForOpImpl<StdDevSample<ColumnName, NewColumnName>, Columns...> {
+    using type = SummarizerStdDevSample<get_column_index_by_name<ColumnName, Columns...>, GetColumnTypeByName<ColumnName, Columns...>>;
+};
+
+template <FixedString ColumnName, FixedString NewColumnName, typename ...Columns>
+struct GetSummarizerForOpImpl<Variance<ColumnName, NewColumnName>, Columns...> {
+    using type = SummarizerVariance<get_column_index_by_name<ColumnName, Columns...>, GetColumnTypeByName<ColumnName, Columns...>>;
+};
+
+template <FixedString ColumnName, FixedString NewColumnName, typename ...Columns>
+struct GetSummarizerForOpImpl<VarianceSample<ColumnName, NewColumnName>, Columns...> {
+    using type = SummarizerVarianceSample<get_column_index_by_name<ColumnName, Columns...>, GetColumnTypeByName<ColumnName, Columns...>>;
+};
+
 template <FixedString ColumnName, FixedString NewColumnName, typename ...Columns>
 struct GetSummarizerForOpImpl<CountIf<ColumnName, NewColumnName>, Columns...> {
     using type = SummarizerCountIf<get_column_index_by_name<ColumnName, Columns...>, GetColumnTypeByName<ColumnName, Columns...>>;
@@ -416,6 +607,15 @@ public:
         CompoundSummarizer::summarize(summarizer_data_[0], column_store_data, row_index);
     }
 
+    template <typename ColumnStoreData>
+    void summarizeRange (const ColumnStoreData& column_store_data, std::size_t begin, std::size_t end) {
+        CompoundSummarizer::summarizeRange(summarizer_data_[0], column_store_data, begin, end);
+    }
+
+    void merge (const SummarizationExecuterNoGroupBy& other) {
+        CompoundSummarizer::merge(summarizer_data_[0], other.summarizer_data_[0]);
+    }
+
     auto constructResult () {
         using SummarizerIndices = std::make_index_sequence<CompoundSummarizer::NumSummarizers>;
         return constructResultImpl(SummarizerIndices{});
@@ -436,36 +636,74 @@ private:
     std::vector<typename CompoundSummarizer::Data> summarizer_data_{};
 };
 
+/**
+ * Summarization executer for group-by aggregations.
+ *
+ * The groups are looked up in an open-addressing hash table (linear probing) storing
+ * group indices, such that the aggregation runs in linear time. The groups are kept
+ * in the order in which they are first seen in the input.
+*/
 template <typename NewDataFrame, typename GroupByColumnIndices, typename GroupByTypes, typename CompoundSummarizer>
 class SummarizationExecuterGroupBy {
 public:
     template <typename ColumnStoreData>
-        void summarize(const ColumnStoreData& column_store_data, std::size_t row_index) {
-            auto index = getGroupByIndex(column_store_data, row_index, GroupByDataIndices{}, GroupByColumnIndices{});
-            if (index == -1) {
-                createNewGroupByEntry(column_store_data, row_index, GroupByColumnIndices{});;
-                index = group_by_data_.size() - 1;
-            }
-            CompoundSummarizer::summarize(summarizer_data_[index], column_store_data, row_index);
-        }
+    void summarize(const ColumnStoreData& column_store_data, std::size_t row_index) {
+        const std::size_t group_index = findOrCreateGroup(column_store_data, row_index);
+        CompoundSummarizer::summarize(summarizer_data_[group_index], column_store_data, row_index);
+    }
 
-        template <typename ColumnStoreData, std::size_t ... GroupByColumnIndicesInColumnStore>
-        void createNewGroupByEntry (const ColumnStoreData& column_store_data, std::size_t row_index, std::integer_sequence<std::size_t, GroupByColumnIndicesInColumnStore...>) {
-            group_by_data_.push_back(
-                std::make_tuple(std::get<GroupByColumnIndicesInColumnStore>(column_store_data)[row_index]...)
-            );
-            summarizer_data_.push_back(CompoundSummarizer::create());
+    template <typename ColumnStoreData>
+    void summarizeRange (const ColumnStoreData& column_store_data, std::size_t begin, std::size_t end) {
+        for (auto row_index = begin; row_index < end; ++row_index) {
+            summarize(column_store_data, row_index);
         }
+    }
 
-        template <typename ColumnStoreData, std::size_t ...GroupByDataIndices, std::size_t ...GroupByColumnIndicesInColumnStore>
-        int getGroupByIndex(const ColumnStoreData& column_store_data, std::size_t row_index, std::integer_sequence<std::size_t, GroupByDataIndices...>, std::integer_sequence<std::size_t, GroupByColumnIndicesInColumnStore...>) {
-            for (std::size_t loop_index = 0; loop_index < group_by_data_.size(); ++loop_index) {
-                if (((std::get<GroupByDataIndices>(group_by_data_[loop_index]) == std::get<GroupByColumnIndicesInColumnStore>(column_store_data)[row_index]) && ...)) {
-                    return loop_index;
+    std::size_t getNumberOfGroups () const {
+        return group_by_data_.size();
+    }
+
+    /**
+     * Merges the groups of other into this executer.
+     * New groups of other are appended in their order, which keeps the first-seen group order
+     * if other summarized the rows following the ones of this executer.
+    */
+    void merge (const SummarizationExecuterGroupBy& other) {
+        for (std::size_t other_group_index = 0; other_group_index < other.group_by_data_.size(); ++other_group_index) {
+            const auto& other_group = other.group_by_data_[other_group_index];
+            const std::size_t group_index = findOrCreateGroupImpl(
+                other.group_hashes_[other_group_index],
+                [&](std::size_t candidate_index) { return group_by_data_[candidate_index] == other_group; },
+                [&]() {
+                    group_by_data_.push_back(other_group);
+                    summarizer_data_.push_back(CompoundSummarizer::create());
                 }
-            }
-            return -1;
+            );
+            CompoundSummarizer::merge(summarizer_data_[group_index], other.summarizer_data_[other_group_index]);
         }
+    }
+
+    template <typename ColumnStoreData>
+    std::size_t findOrCreateGroup (const ColumnStoreData& column_store_data, std::size_t row_index) {
+        return findOrCreateGroupImpl(
+            hashRow(column_store_data, row_index, GroupByColumnIndices{}),
+            [&](std::size_t group_index) { return isGroupEqualToRow(group_index, column_store_data, row_index, GroupByDataIndices{}, GroupByColumnIndices{}); },
+            [&]() { createNewGroupByEntry(column_store_data, row_index, GroupByColumnIndices{}); }
+        );
+    }
+
+    template <typename ColumnStoreData, std::size_t ... GroupByColumnIndicesInColumnStore>
+    void createNewGroupByEntry (const ColumnStoreData& column_store_data, std::size_t row_index, std::integer_sequence<std::size_t, GroupByColumnIndicesInColumnStore...>) {
+        group_by_data_.push_back(
+            std::make_tuple(std::get<GroupByColumnIndicesInColumnStore>(column_store_data)[row_index]...)
+        );
+        summarizer_data_.push_back(CompoundSummarizer::create());
+    }
+
+    template <typename ColumnStoreData, std::size_t ...GroupByDataIndices, std::size_t ...GroupByColumnIndicesInColumnStore>
+    bool isGroupEqualToRow (std::size_t group_index, const ColumnStoreData& column_store_data, std::size_t row_index, std::integer_sequence<std::size_t, GroupByDataIndices...>, std::integer_sequence<std::size_t, GroupByColumnIndicesInColumnStore...>) const {
+        return ((std::get<GroupByDataIndices>(group_by_data_[group_index]) == std::get<GroupByColumnIndicesInColumnStore>(column_store_data)[row_index]) && ...);
+    }
 
     auto constructResult () {
         using SummarizerIndices = std::make_index_sequence<CompoundSummarizer::NumSummarizers>;
@@ -487,12 +725,57 @@ public:
 private:
     using GroupByDataIndices = std::make_index_sequence<get_integer_sequence_size<GroupByColumnIndices>>;
 
-    std::vector<GroupByTypes> group_by_data_{};;
+    static constexpr std::size_t EMPTY_SLOT = std::numeric_limits<std::size_t>::max();
+    static constexpr std::size_t INITIAL_NUMBER_OF_SLOTS = 16;
+
+    /**
+     * Returns the index of the group with the given hash for which is_equal holds.
+     * If no such group exists, create_group is called to append a new group.
+    */
+    template <typename IsEqualFunc, typename CreateGroupFunc>
+    std::size_t findOrCreateGroupImpl (std::size_t hash, IsEqualFunc&& is_equal, CreateGroupFunc&& create_group) {
+        std::size_t slot = hash & slot_mask_;
+        for (auto group_index = slots_[slot]; group_index != EMPTY_SLOT; group_index = slots_[slot]) {
+            if (group_hashes_[group_index] == hash && is_equal(group_index)) {
+                return group_index;
+            }
+            slot = (slot + 1) & slot_mask_;
+        }
+
+        const std::size_t group_index = group_by_data_.size();
+        create_group();
+        group_hashes_.push_back(hash);
+        slots_[slot] = group_index;
+        if (2 * group_by_data_.size() > slots_.size()) {
+            growSlots();
+        }
+        return group_index;
+    }
+
+    /**
+     * Doubles the number of slots and re-inserts all groups using their stored hashes.
+    */
+    void growSlots () {
+        slots_.assign(2 * slots_.size(), EMPTY_SLOT);
+        slot_mask_ = slots_.size() - 1;
+        for (std::size_t group_index = 0; group_index < group_hashes_.size(); ++group_index) {
+            std::size_t slot = group_hashes_[group_index] & slot_mask_;
+            while (slots_[slot] != EMPTY_SLOT) {
+                slot = (slot + 1) & slot_mask_;
+            }
+            slots_[slot] = group_index;
+        }
+    }
+
+    std::vector<GroupByTypes> group_by_data_{};
     std::vector<typename CompoundSummarizer::Data> summarizer_data_{};
+    std::vector<std::size_t> group_hashes_{};
+    std::vector<std::size_t> slots_ = std::vector<std::size_t>(INITIAL_NUMBER_OF_SLOTS, EMPTY_SLOT);
+    std::size_t slot_mask_ {INITIAL_NUMBER_OF_SLOTS - 1};
 };
 
 } // namespace internal
 
 } // namespace dacr
 
-#endif // DATA_CRUNCHING_INTERNAL_DATAFRAME_PRINT_HPP
\ No newline at end of file
+#endif // DATA_CRUNCHING_INTERNAL_DATAFRAME_SUMMARIZE_HPP
\ No newline at end of file
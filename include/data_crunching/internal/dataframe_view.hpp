@@ -0,0 +1,324 @@
+// Copyright 2022 Andi Hellmund
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef DATA_CRUNCHING_INTERNAL_DATAFRAME_VIEW_HPP
+#define DATA_CRUNCHING_INTERNAL_DATAFRAME_VIEW_HPP
+
+#include <iostream>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "data_crunching/internal/column.hpp"
+#include "data_crunching/internal/dataframe_expression.hpp"
+#include "data_crunching/internal/dataframe_general.hpp"
+#include "data_crunching/internal/dataframe_join.hpp"
+#include "data_crunching/internal/dataframe_print.hpp"
+#include "data_crunching/internal/dataframe_query.hpp"
+#include "data_crunching/internal/dataframe_sort.hpp"
+#include "data_crunching/internal/dataframe_summarize.hpp"
+#include "data_crunching/internal/fixed_string.hpp"
+#include "data_crunching/internal/memory_resource.hpp"
+#include "data_crunching/internal/name_list.hpp"
+#include "data_crunching/internal/type_list.hpp"
+
+namespace dacr {
+
+namespace internal {
+
+// ############################################################################
+// Class: Column Span
+// ############################################################################
+/**
+ * Non-owning read-only reference to a ColumnVector<bool> column which (in contrast to the
+ * other column types) cannot be referenced by a std::span as its elements are packed bits.
+*/
+class BoolColumnSpan {
+public:
+    using value_type = bool;
+
+    BoolColumnSpan (const ColumnVector<bool>& column) : column_{&column} {}
+
+    std::size_t size () const {
+        return column_->size();
+    }
+
+    bool operator[] (std::size_t index) const {
+        return (*column_)[index];
+    }
+
+    auto begin () const {
+        return column_->begin();
+    }
+
+    auto end () const {
+        return column_->end();
+    }
+
+private:
+    const ColumnVector<bool>* column_;
+};
+
+template <typename T>
+using ColumnSpan = std::conditional_t<std::is_same_v<T, bool>, BoolColumnSpan, std::span<const T>>;
+
+template <typename ...>
+struct ConstructColumnSpanStoreDataTypeImpl {};
+
+template <FixedString ...Names, typename ...Types>
+struct ConstructColumnSpanStoreDataTypeImpl<Column<Names, Types>...> {
+    using type = std::tuple<ColumnSpan<Types>...>;
+};
+
+template <typename ...Columns>
+using ConstructColumnSpanStoreDataType = typename ConstructColumnSpanStoreDataTypeImpl<Columns...>::type;
+
+} // namespace internal
+
+// ############################################################################
+// Class: DataFrameView
+// ############################################################################
+/**
+ * Non-owning projection of the columns of a DataFrame (created by DataFrame::view<"a", "b">()).
+ *
+ * The view references the columns of the DataFrame by spans, i.e. creating the view copies no data.
+ * Operations on the view (query, summarize, sort, join) read the referenced columns directly and
+ * return new DataFrames with the columns of the view. Modifying the DataFrame invalidates the view.
+*/
+template <internal::IsColumn ...Columns>
+class DataFrameView {
+public:
+    template <internal::IsColumn ...OtherColumns>
+    requires (
+        internal::are_names_unique<internal::GetColumnNames<OtherColumns...>> and
+        internal::are_names_valid_identifiers<internal::GetColumnNames<OtherColumns...>>
+    )
+    friend class DataFrame;
+
+    template <internal::IsColumn ...OtherColumns>
+    friend class DataFrameView;
+
+    using ColumnStoreDataType = internal::ConstructColumnSpanStoreDataType<Columns...>;
+    using DataFrameType = DataFrame<Columns...>;
+
+    DataFrameView (ColumnStoreDataType column_store_data, std::size_t size) : column_store_data_{column_store_data}, size_{size} {}
+
+    // ############################################################################
+    // API: Column Details
+    // ############################################################################
+    using ColumnTypes = internal::GetColumnTypes<Columns...>;
+    using ColumnSpecs = TypeList<Columns...>;
+    static constexpr std::size_t NUM_COLUMNS = sizeof...(Columns);
+
+    // ############################################################################
+    // API: Get Size
+    // ############################################################################
+    std::size_t getSize () const {
+        return size_;
+    }
+
+    // ############################################################################
+    // API: Column (Read) Access
+    // ############################################################################
+    template <FixedString ColumnName>
+    requires (internal::is_name_in_name_list<ColumnName, internal::GetColumnNames<Columns...>>)
+    auto getColumn () const {
+        constexpr auto index = internal::get_column_index_by_name<ColumnName, Columns...>;
+        return std::get<index>(column_store_data_);
+    }
+
+    // ############################################################################
+    // API: View
+    // ############################################################################
+    template <FixedString ...ColumnNames>
+    requires (
+        sizeof...(ColumnNames) > 0 &&
+        internal::are_names_unique<internal::NameList<ColumnNames...>> &&
+        internal::are_names_in_columns<internal::NameList<ColumnNames...>, Columns...>
+    )
+    auto view () const {
+        using NewDataFrameView = typename internal::GetDataFrameWithColumnsByName<internal::NameList<ColumnNames...>, Columns...>::ColumnSpecs::template To<dacr::DataFrameView>;
+        using SelectedColumnIndices = internal::GetColumnIndicesByNames<internal::NameList<ColumnNames...>, Columns...>;
+        return viewImpl<NewDataFrameView>(SelectedColumnIndices{});
+    }
+
+    /**
+     * Copies the referenced columns into a new DataFrame.
+    */
+    DataFrameType materialize () const {
+        DataFrameType result{};
+        materializeImpl(result, IndicesForColumnStore{});
+        return result;
+    }
+
+    // ############################################################################
+    // API: Query
+    // ############################################################################
+    template <typename SelectNames = SelectAll, typename Func>
+    requires (internal::is_valid_select<SelectNames, Columns...> && not internal::IsExpression<Func>)
+    DataFrameType query (Func&& function) const {
+        return gather(querySelection<SelectNames>(std::forward<Func>(function)));
+    }
+
+    template <typename SelectNames = SelectAll, typename Func>
+    requires (internal::is_valid_select<SelectNames, Columns...> && not internal::IsExpression<Func>)
+    Selection querySelection (Func&& function) const {
+        using SelectedNamesForQuery = internal::GetSelectNameList<SelectNames, Columns...>;
+        using SelectedColumnIndices = internal::GetColumnIndicesByNames<SelectedNamesForQuery, Columns...>;
+        using RowViewForFunc = internal::RowView<ColumnStoreDataType, SelectedNamesForQuery, SelectedColumnIndices>;
+        static_assert(std::is_same_v<std::invoke_result_t<Func, RowViewForFunc>, bool>, "Callback return type for query() must be bool");
+
+        return internal::selectRows(getSize(), [this, &function](std::size_t row_index) {
+            return static_cast<bool>(function(RowViewForFunc{column_store_data_, row_index}));
+        });
+    }
+
+    template <internal::IsExpression Expr>
+    requires (internal::is_valid_expression<Expr, Columns...>)
+    DataFrameType query (const Expr& expression) const {
+        return gather(querySelection(expression));
+    }
+
+    template <internal::IsExpression Expr>
+    requires (internal::is_valid_expression<Expr, Columns...>)
+    Selection querySelection (const Expr& expression) const {
+        return internal::toSelection(internal::evaluateExpression(expression, column_store_data_, getSize(), TypeList<Columns...>{}));
+    }
+
+    // ############################################################################
+    // API: Join
+    // ############################################################################
+    template <Join JoinType, FixedString ...JoinNames, typename ...OtherColumns, internal::IsJoinStrategy Strategy = HashJoin>
+    requires (internal::is_valid_join<internal::NameList<JoinNames...>, TypeList<Columns...>, TypeList<OtherColumns...>>)
+    auto join (const DataFrame<OtherColumns...>& df, Strategy strategy = {}) const {
+        return DataFrameType::template joinColumnStores<JoinType, JoinNames...>(column_store_data_, getSize(), df.column_store_data_, df.getSize(), TypeList<OtherColumns...>{}, strategy);
+    }
+
+    template <Join JoinType, FixedString ...JoinNames, typename ...OtherColumns, internal::IsJoinStrategy Strategy = HashJoin>
+    requires (internal::is_valid_join<internal::NameList<JoinNames...>, TypeList<Columns...>, TypeList<OtherColumns...>>)
+    auto join (const DataFrameView<OtherColumns...>& df, Strategy strategy = {}) const {
+        return DataFrameType::template joinColumnStores<JoinType, JoinNames...>(column_store_data_, getSize(), df.column_store_data_, df.getSize(), TypeList<OtherColumns...>{}, strategy);
+    }
+
+    // ############################################################################
+    // API: Summarize
+    // ############################################################################
+    template <internal::IsGroupBySpec GroupBy, internal::IsSummarizeOp ...Ops>
+    requires (internal::are_valid_summarize_ops<TypeList<Ops...>, Columns...>)
+    auto summarize () const {
+        auto executer = DataFrameType::template createSummarizationExecuter<GroupBy, Ops...>();
+        executer.summarizeRange(column_store_data_, 0, getSize());
+        return executer.constructResult();
+    }
+
+    // ############################################################################
+    // API: Sort
+    // ############################################################################
+    template <SortOrder Order, FixedString ...SortByNames>
+    requires (
+        sizeof...(SortByNames) > 0 &&
+        internal::are_names_unique<internal::NameList<SortByNames...>> &&
+        internal::are_names_in_columns<internal::NameList<SortByNames...>, Columns...>
+    )
+    DataFrameType sort () const {
+        return gather(argsort<Order, SortByNames...>());
+    }
+
+    template <typename ...SortKeySpecs>
+    requires (internal::is_valid_sort_key_spec_list<TypeList<SortKeySpecs...>, Columns...>)
+    DataFrameType sort () const {
+        return gather(argsort<SortKeySpecs...>());
+    }
+
+    template <SortOrder Order, FixedString ...SortByNames>
+    requires (
+        sizeof...(SortByNames) > 0 &&
+        internal::are_names_unique<internal::NameList<SortByNames...>> &&
+        internal::are_names_in_columns<internal::NameList<SortByNames...>, Columns...>
+    )
+    std::vector<std::size_t> argsort () const {
+        using SortKeys = typename DataFrameType::template SortKeysForNames<Order, SortByNames...>;
+        return DataFrameType::template argsortColumnStore<SortKeys, false>(column_store_data_, getSize());
+    }
+
+    template <typename ...SortKeySpecs>
+    requires (internal::is_valid_sort_key_spec_list<TypeList<SortKeySpecs...>, Columns...>)
+    std::vector<std::size_t> argsort () const {
+        using SortKeys = typename DataFrameType::template SortKeysForSpecs<SortKeySpecs...>;
+        return DataFrameType::template argsortColumnStore<SortKeys, false>(column_store_data_, getSize());
+    }
+
+    // ############################################################################
+    // API: Gather
+    // ############################################################################
+    /**
+     * Returns a new DataFrame with the rows at the given row indices (in the given order).
+    */
+    DataFrameType gather (const std::vector<std::size_t>& row_indices) const {
+        DataFrameType result{};
+        gatherImpl(result, row_indices, IndicesForColumnStore{});
+        return result;
+    }
+
+    DataFrameType gather (const Selection& selection) const {
+        if (selection.getNumberOfRows() != getSize()) {
+            throw std::invalid_argument("selection does not match the number of rows of the DataFrameView");
+        }
+        return gather(selection.getRowIndices());
+    }
+
+    // ############################################################################
+    // API: Print
+    // ############################################################################
+    template <typename SelectNames = SelectAll>
+    requires (internal::is_valid_select<SelectNames, Columns...>)
+    void print (const PrintOptions& print_options = PrintOptions{}, std::ostream& stream = std::cout) const {
+        using SelectedNamesForPrint = internal::GetSelectNameList<SelectNames, Columns...>;
+        using SelectedColumnTypes = internal::GetColumnTypesByNames<SelectedNamesForPrint, Columns...>;
+        using SelectedColumnIndices = internal::GetColumnIndicesByNames<SelectedNamesForPrint, Columns...>;
+
+        using PrintExecuter = internal::ConstructPrintExecuter<SelectedNamesForPrint, SelectedColumnTypes, SelectedColumnIndices>;
+
+        PrintExecuter printer{stream, print_options};
+        printer.print(column_store_data_);
+    }
+
+private:
+    using IndicesForColumnStore = std::index_sequence_for<Columns...>;
+
+    template <typename NewDataFrameView, std::size_t ...Indices>
+    NewDataFrameView viewImpl (std::integer_sequence<std::size_t, Indices...>) const {
+        return NewDataFrameView{typename NewDataFrameView::ColumnStoreDataType{std::get<Indices>(column_store_data_)...}, getSize()};
+    }
+
+    template <std::size_t ...Indices>
+    void materializeImpl (DataFrameType& result, std::integer_sequence<std::size_t, Indices...>) const {
+        ((std::get<Indices>(result.column_store_data_).assign(std::get<Indices>(column_store_data_).begin(), std::get<Indices>(column_store_data_).end())), ...);
+    }
+
+    template <std::size_t ...Indices>
+    void gatherImpl (DataFrameType& result, const std::vector<std::size_t>& row_indices, std::integer_sequence<std::size_t, Indices...>) const {
+        ((internal::gatherIntoContainer(std::get<Indices>(result.column_store_data_), std::get<Indices>(column_store_data_), row_indices)), ...);
+    }
+
+    ColumnStoreDataType column_store_data_;
+    std::size_t size_;
+};
+
+} // namespace dacr
+
+#endif // DATA_CRUNCHING_INTERNAL_DATAFRAME_VIEW_HPP
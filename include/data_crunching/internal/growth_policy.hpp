@@ -0,0 +1,48 @@
+// Copyright 2022 Andi Hellmund
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef DATA_CRUNCHING_INTERNAL_GROWTH_POLICY_HPP
+#define DATA_CRUNCHING_INTERNAL_GROWTH_POLICY_HPP
+
+#include <algorithm>
+#include <cstddef>
+
+namespace dacr {
+
+// ############################################################################
+// API: Growth Policy
+// ############################################################################
+/**
+ * Controls how the column capacity of a DataFrame grows when inserting rows.
+ *
+ * If an insertion exceeds the capacity, the capacity grows geometrically by the factor (at least
+ * to min_capacity). A factor larger than one guarantees amortized constant time per inserted row.
+*/
+struct GrowthPolicy {
+    double factor {1.5};
+    std::size_t min_capacity {16};
+
+    /**
+     * Returns the new capacity for a column with the given capacity that must hold at least
+     * required_capacity elements.
+    */
+    std::size_t getCapacity (std::size_t capacity, std::size_t required_capacity) const {
+        const auto grown_capacity = static_cast<std::size_t>(static_cast<double>(capacity) * factor);
+        return std::max({required_capacity, grown_capacity, min_capacity});
+    }
+};
+
+} // namespace dacr
+
+#endif // DATA_CRUNCHING_INTERNAL_GROWTH_POLICY_HPP
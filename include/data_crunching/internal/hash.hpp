@@ -0,0 +1,79 @@
+// Copyright 2022 Andi Hellmund
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef DATA_CRUNCHING_INTERNAL_HASH_HPP
+#define DATA_CRUNCHING_INTERNAL_HASH_HPP
+
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <tuple>
+#include <utility>
+
+namespace dacr::internal {
+
+// ############################################################################
+// Concept: Is Hashable
+// ############################################################################
+template <typename T>
+concept IsHashable = requires (const T& value) {
+    { std::hash<T>{}(value) } -> std::convertible_to<std::size_t>;
+};
+
+// ############################################################################
+// Util: Hash Combination
+// ############################################################################
+/**
+ * Mixes the bits of a hash value (finalizer of SplitMix64).
+ *
+ * The standard library implements std::hash for integral types as identity which
+ * leads to many collisions in power-of-two sized hash tables without mixing.
+*/
+inline std::size_t mixHash (std::size_t hash) {
+    std::uint64_t value = hash;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    value = value ^ (value >> 31);
+    return static_cast<std::size_t>(value);
+}
+
+inline std::size_t combineHash (std::size_t seed, std::size_t hash) {
+    return seed ^ (mixHash(hash) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+}
+
+// ############################################################################
+// Util: Hash Row In Column Store
+// ############################################################################
+template <typename ColumnStoreData, std::size_t ...Indices>
+inline std::size_t hashRow (const ColumnStoreData& column_store_data, std::size_t row_index, std::integer_sequence<std::size_t, Indices...>) {
+    std::size_t seed {0};
+    ((seed = combineHash(seed, std::hash<std::remove_cvref_t<decltype(std::get<Indices>(column_store_data)[row_index])>>{}(std::get<Indices>(column_store_data)[row_index]))), ...);
+    return mixHash(seed);
+}
+
+// ############################################################################
+// Util: Compare Rows In Column Stores
+// ############################################################################
+template <typename ColumnStoreDataLhs, typename ColumnStoreDataRhs, std::size_t ...IndicesLhs, std::size_t ...IndicesRhs>
+requires (sizeof...(IndicesLhs) == sizeof...(IndicesRhs))
+inline bool areRowsEqual (
+    const ColumnStoreDataLhs& lhs, std::size_t row_index_lhs, std::integer_sequence<std::size_t, IndicesLhs...>,
+    const ColumnStoreDataRhs& rhs, std::size_t row_index_rhs, std::integer_sequence<std::size_t, IndicesRhs...>
+) {
+    return ((std::get<IndicesLhs>(lhs)[row_index_lhs] == std::get<IndicesRhs>(rhs)[row_index_rhs]) && ...);
+}
+
+} // namespace dacr::internal
+
+#endif // DATA_CRUNCHING_INTERNAL_HASH_HPP
@@ -0,0 +1,271 @@
+// Copyright 2022 Andi Hellmund
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef DATA_CRUNCHING_INTERNAL_MEMORY_RESOURCE_HPP
+#define DATA_CRUNCHING_INTERNAL_MEMORY_RESOURCE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace dacr {
+
+// ############################################################################
+// API: Memory Resource
+// ############################################################################
+/**
+ * Source of the memory for the columns of a DataFrame.
+ *
+ * Mirrors std::pmr::memory_resource (which is not available in all supported standard libraries).
+ * A memory resource must outlive all DataFrames (and copies of their columns) allocated from it.
+ * Memory resources must be thread-safe as parallel operations (e.g. sort or query with a ParallelPolicy)
+ * allocate the result columns concurrently.
+*/
+class MemoryResource {
+public:
+    virtual ~MemoryResource () = default;
+
+    virtual void* allocate (std::size_t bytes, std::size_t alignment) = 0;
+    virtual void deallocate (void* pointer, std::size_t bytes, std::size_t alignment) = 0;
+};
+
+// ############################################################################
+// API: New-Delete Memory Resource
+// ############################################################################
+/**
+ * Allocates the memory with the global operator new (the default memory resource).
+*/
+class NewDeleteMemoryResource : public MemoryResource {
+public:
+    void* allocate (std::size_t bytes, std::size_t alignment) override {
+        return ::operator new(bytes, std::align_val_t{alignment});
+    }
+
+    void deallocate (void* pointer, std::size_t bytes, std::size_t alignment) override {
+        ::operator delete(pointer, bytes, std::align_val_t{alignment});
+    }
+};
+
+inline MemoryResource* getDefaultMemoryResource () {
+    static NewDeleteMemoryResource default_memory_resource{};
+    return &default_memory_resource;
+}
+
+// ############################################################################
+// API: Monotonic Memory Resource
+// ############################################################################
+/**
+ * Arena allocating from a list of blocks by bumping a pointer.
+ *
+ * Deallocation is a no-op: the memory is released in one shot by release() or the destructor. This suits
+ * intermediate DataFrames of a pipeline which are discarded together. The block size doubles for each new block.
+ * Allocations are serialized by a mutex.
+*/
+class MonotonicMemoryResource : public MemoryResource {
+public:
+    explicit MonotonicMemoryResource (std::size_t initial_block_size = 64 * 1024, MemoryResource* upstream = getDefaultMemoryResource())
+        : next_block_size_{std::max(initial_block_size, std::size_t{64})}, upstream_{upstream} {}
+
+    MonotonicMemoryResource (const MonotonicMemoryResource&) = delete;
+    MonotonicMemoryResource& operator= (const MonotonicMemoryResource&) = delete;
+
+    ~MonotonicMemoryResource () override {
+        release();
+    }
+
+    void* allocate (std::size_t bytes, std::size_t alignment) override {
+        std::lock_guard lock{mutex_};
+        void* pointer = current_;
+        if (std::align(alignment, bytes, pointer, remaining_bytes_) == nullptr) {
+            allocateBlock(bytes + alignment);
+            pointer = current_;
+            std::align(alignment, bytes, pointer, remaining_bytes_);
+        }
+        current_ = static_cast<std::byte*>(pointer) + bytes;
+        remaining_bytes_ -= bytes;
+        allocated_bytes_ += bytes;
+        return pointer;
+    }
+
+    void deallocate (void*, std::size_t, std::size_t) override {}
+
+    /**
+     * Releases all blocks to the upstream resource (invalidating all allocations).
+    */
+    void release () {
+        std::lock_guard lock{mutex_};
+        for (const auto& block : blocks_) {
+            upstream_->deallocate(block.data, block.size, alignof(std::max_align_t));
+        }
+        blocks_.clear();
+        current_ = nullptr;
+        remaining_bytes_ = 0;
+        allocated_bytes_ = 0;
+    }
+
+    /**
+     * Returns the number of bytes allocated since construction or the last release.
+    */
+    std::size_t getAllocatedBytes () const {
+        std::lock_guard lock{mutex_};
+        return allocated_bytes_;
+    }
+
+private:
+    struct Block {
+        void* data;
+        std::size_t size;
+    };
+
+    void allocateBlock (std::size_t min_size) {
+        const std::size_t block_size = std::max(next_block_size_, min_size);
+        blocks_.reserve(blocks_.size() + 1);
+        void* data = upstream_->allocate(block_size, alignof(std::max_align_t));
+        blocks_.push_back(Block{data, block_size});
+        current_ = data;
+        remaining_bytes_ = block_size;
+        next_block_size_ = block_size * 2;
+    }
+
+    mutable std::mutex mutex_{};
+    std::vector<Block> blocks_{};
+    void* current_ {nullptr};
+    std::size_t remaining_bytes_ {0};
+    std::size_t allocated_bytes_ {0};
+    std::size_t next_block_size_;
+    MemoryResource* upstream_;
+};
+
+// ############################################################################
+// API: Aligned Memory Resource
+// ############################################################################
+/**
+ * Aligns all allocations to at least the given alignment (default: 64 bytes, i.e. one cache line, suitable
+ * for aligned SIMD loads of numeric columns).
+*/
+class AlignedMemoryResource : public MemoryResource {
+public:
+    explicit AlignedMemoryResource (std::size_t alignment = 64, MemoryResource* upstream = getDefaultMemoryResource())
+        : alignment_{alignment}, upstream_{upstream} {}
+
+    void* allocate (std::size_t bytes, std::size_t alignment) override {
+        return upstream_->allocate(bytes, std::max(alignment, alignment_));
+    }
+
+    void deallocate (void* pointer, std::size_t bytes, std::size_t alignment) override {
+        upstream_->deallocate(pointer, bytes, std::max(alignment, alignment_));
+    }
+
+private:
+    std::size_t alignment_;
+    MemoryResource* upstream_;
+};
+
+// ############################################################################
+// API: Huge Page Memory Resource
+// ############################################################################
+/**
+ * Backs large allocations (at least one huge page) by transparent huge pages to reduce TLB misses when
+ * scanning large columns: the allocations are aligned to the huge page size and advised for huge pages
+ * (Linux only, elsewhere the allocations are only aligned). Smaller allocations are aligned to 64 bytes.
+*/
+class HugePageMemoryResource : public MemoryResource {
+public:
+    static constexpr std::size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    explicit HugePageMemoryResource (MemoryResource* upstream = getDefaultMemoryResource())
+        : upstream_{upstream} {}
+
+    void* allocate (std::size_t bytes, std::size_t alignment) override {
+        void* pointer = upstream_->allocate(bytes, getAlignment(bytes, alignment));
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        if (bytes >= HUGE_PAGE_SIZE) {
+            // the advice is a hint only: failure leaves the memory backed by regular pages
+            ::madvise(pointer, bytes, MADV_HUGEPAGE);
+        }
+#endif
+        return pointer;
+    }
+
+    void deallocate (void* pointer, std::size_t bytes, std::size_t alignment) override {
+        upstream_->deallocate(pointer, bytes, getAlignment(bytes, alignment));
+    }
+
+private:
+    static std::size_t getAlignment (std::size_t bytes, std::size_t alignment) {
+        return std::max(alignment, bytes >= HUGE_PAGE_SIZE ? HUGE_PAGE_SIZE : std::size_t{64});
+    }
+
+    MemoryResource* upstream_;
+};
+
+// ############################################################################
+// API: Column Allocator
+// ############################################################################
+/**
+ * Allocator of the column values using a memory resource.
+ *
+ * In contrast to std::pmr::polymorphic_allocator, the memory resource is propagated on copy, move and
+ * swap, i.e. the values stay in the memory resource of the column they originate from.
+*/
+template <typename T>
+class ColumnAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    ColumnAllocator () noexcept = default;
+
+    ColumnAllocator (MemoryResource* memory_resource) noexcept : memory_resource_{memory_resource} {}
+
+    template <typename U>
+    ColumnAllocator (const ColumnAllocator<U>& other) noexcept : memory_resource_{other.getMemoryResource()} {}
+
+    T* allocate (std::size_t n) {
+        return static_cast<T*>(memory_resource_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate (T* pointer, std::size_t n) noexcept {
+        memory_resource_->deallocate(pointer, n * sizeof(T), alignof(T));
+    }
+
+    MemoryResource* getMemoryResource () const noexcept {
+        return memory_resource_;
+    }
+
+    template <typename U>
+    friend bool operator== (const ColumnAllocator& lhs, const ColumnAllocator<U>& rhs) noexcept {
+        return lhs.getMemoryResource() == rhs.getMemoryResource();
+    }
+
+private:
+    MemoryResource* memory_resource_ {getDefaultMemoryResource()};
+};
+
+template <typename T>
+using ColumnVector = std::vector<T, ColumnAllocator<T>>;
+
+} // namespace dacr
+
+#endif // DATA_CRUNCHING_INTERNAL_MEMORY_RESOURCE_HPP
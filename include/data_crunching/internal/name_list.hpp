@@ -133,6 +133,20 @@ struct IsNameInNameListImpl<NameToSearch, NameList<FirstNameInList, RestNamesInL
 template <FixedString NameToSearch, typename NameListToSearch>
 constexpr bool is_name_in_name_list = IsNameInNameListImpl<NameToSearch, NameListToSearch>::value;
 
+// ############################################################################
+// Trait: Are Names In Name List
+// ############################################################################
+template <typename, typename>
+struct AreNamesInNameListImpl {};
+
+template <FixedString ...NamesToSearch, typename NameListToSearch>
+struct AreNamesInNameListImpl<NameList<NamesToSearch...>, NameListToSearch> {
+    static constexpr bool value = (is_name_in_name_list<NamesToSearch, NameListToSearch> && ...);
+};
+
+template <typename NamesToSearch, typename NameListToSearch>
+constexpr bool are_names_in_name_list = AreNamesInNameListImpl<NamesToSearch, NameListToSearch>::value;
+
 // ############################################################################
 // Trait: Name List Difference
 // ############################################################################
@@ -153,6 +167,15 @@ struct NameListDifferenceImpl<NameList<FirstNameToRemoveFrom, RestNamesToRemoveF
 template <typename NameListToRemoveFrom, typename NamesToRemove>
 using NameListDifference = typename NameListDifferenceImpl<NameListToRemoveFrom, NamesToRemove>::type;
 
+// ############################################################################
+// Trait: Name List Union
+// ############################################################################
+/**
+ * Merges two name lists, skipping the names of the second list which are already in the first list.
+*/
+template <typename NameList1, typename NameList2>
+using NameListUnion = NameListMerge<NameList1, NameListDifference<NameList2, NameList1>>;
+
 } // namespace dacr::internal
 
 #endif // DATA_CRUNCHING_INTERNAL_NAME_LIST_HPP
\ No newline at end of file
@@ -0,0 +1,157 @@
+// Copyright 2022 Andi Hellmund
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef DATA_CRUNCHING_INTERNAL_PARALLEL_HPP
+#define DATA_CRUNCHING_INTERNAL_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace dacr {
+
+/**
+ * Execution policy for parallel DataFrame operations.
+*/
+struct ParallelPolicy {
+    std::size_t num_threads {0}; // zero uses the number of hardware threads
+};
+
+inline constexpr ParallelPolicy par{};
+
+namespace internal {
+
+// ############################################################################
+// Util: Number Of Threads
+// ############################################################################
+/**
+ * Returns the requested number of threads or, if zero is requested, the number of hardware threads.
+*/
+inline std::size_t getNumberOfThreads (std::size_t requested_num_threads) {
+    if (requested_num_threads > 0) {
+        return requested_num_threads;
+    }
+    return std::max(static_cast<std::size_t>(std::thread::hardware_concurrency()), std::size_t{1});
+}
+
+// ############################################################################
+// Util: Chunk Range
+// ############################################################################
+/**
+ * Returns the half-open range [begin, end) of the chunk with the given index
+ * when splitting [0, size) into num_chunks contiguous chunks of (almost) equal size.
+*/
+inline std::pair<std::size_t, std::size_t> getChunkRange (std::size_t size, std::size_t num_chunks, std::size_t chunk_index) {
+    const std::size_t chunk_size = size / num_chunks;
+    const std::size_t remainder = size % num_chunks;
+    const std::size_t begin = chunk_index * chunk_size + std::min(chunk_index, remainder);
+    const std::size_t end = begin + chunk_size + (chunk_index < remainder ? 1 : 0);
+    return {begin, end};
+}
+
+// ############################################################################
+// Util: Parallel For
+// ############################################################################
+/**
+ * Executes function(task_index) for all tasks in [0, num_tasks) on up to num_threads threads.
+ *
+ * The tasks are handed out dynamically to the threads, the calling thread takes part in
+ * the execution. The first exception thrown by a task is rethrown after all threads finished.
+ * If a thread cannot be started, the remaining tasks are skipped and the exception is rethrown
+ * after the started threads finished.
+*/
+template <typename Func>
+void parallelFor (std::size_t num_tasks, std::size_t num_threads, Func&& function) {
+    num_threads = std::min(num_threads, num_tasks);
+    if (num_threads <= 1) {
+        for (std::size_t task_index = 0; task_index < num_tasks; ++task_index) {
+            function(task_index);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next_task_index {0};
+    std::exception_ptr exception {};
+    std::mutex exception_mutex {};
+    auto worker = [&]() {
+        for (auto task_index = next_task_index.fetch_add(1); task_index < num_tasks; task_index = next_task_index.fetch_add(1)) {
+            try {
+                function(task_index);
+            }
+            catch (...) {
+                std::lock_guard lock{exception_mutex};
+                if (not exception) {
+                    exception = std::current_exception();
+                }
+                next_task_index = num_tasks;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads{};
+    threads.reserve(num_threads - 1);
+    auto join_threads = [&threads]() {
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    };
+    try {
+        for (std::size_t i = 1; i < num_threads; ++i) {
+            threads.emplace_back(worker);
+        }
+    }
+    catch (...) {
+        // a thread could not be started (std::system_error): the started threads must be joined before rethrowing
+        next_task_index = num_tasks;
+        join_threads();
+        throw;
+    }
+    worker();
+    join_threads();
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+// ############################################################################
+// Util: Parallel For Morsels
+// ############################################################################
+inline constexpr std::size_t ROWS_PER_MORSEL = std::size_t{1} << 14;
+
+inline std::size_t getNumberOfMorsels (std::size_t size) {
+    return (size + ROWS_PER_MORSEL - 1) / ROWS_PER_MORSEL;
+}
+
+/**
+ * Splits [0, size) into morsels of ROWS_PER_MORSEL rows and executes function(morsel_index, begin, end)
+ * for each morsel on up to num_threads threads. Small morsels are handed out dynamically, such that
+ * threads finishing early take over the remaining work.
+*/
+template <typename Func>
+void parallelForMorsels (std::size_t size, std::size_t num_threads, Func&& function) {
+    parallelFor(getNumberOfMorsels(size), num_threads, [&](std::size_t morsel_index) {
+        const std::size_t begin = morsel_index * ROWS_PER_MORSEL;
+        function(morsel_index, begin, std::min(begin + ROWS_PER_MORSEL, size));
+    });
+}
+
+} // namespace internal
+
+} // namespace dacr
+
+#endif // DATA_CRUNCHING_INTERNAL_PARALLEL_HPP
@@ -0,0 +1,260 @@
+// Copyright 2022 Andi Hellmund
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef DATA_CRUNCHING_INTERNAL_SHARED_COLUMN_HPP
+#define DATA_CRUNCHING_INTERNAL_SHARED_COLUMN_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "data_crunching/internal/memory_resource.hpp"
+
+namespace dacr::internal {
+
+// ############################################################################
+// Class: Shared Column
+// ############################################################################
+/**
+ * Column storage with copy-on-write semantics.
+ *
+ * The values are held in a reference-counted buffer: copying the column (e.g. when copying the
+ * DataFrame or selecting columns into a new DataFrame) shares the buffer. The buffer is treated
+ * as immutable while being shared, i.e. each modifying operation first copies the values into
+ * a buffer owned exclusively by this column. Read-only operations never copy. An empty column
+ * (default-constructed or moved-from) holds no buffer.
+ *
+ * All buffers (including the reference count) are allocated from the memory resource of the column.
+ * A reference to the column (in contrast to a reference to its buffer) stays valid across writes.
+*/
+template <typename T>
+class SharedColumn {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = typename ColumnVector<T>::reference;
+    using const_reference = typename ColumnVector<T>::const_reference;
+    using const_iterator = typename ColumnVector<T>::const_iterator;
+
+    SharedColumn () = default;
+
+    explicit SharedColumn (MemoryResource* memory_resource) : memory_resource_{memory_resource} {}
+
+    SharedColumn (ColumnVector<T> values)
+        : memory_resource_{values.get_allocator().getMemoryResource()}, values_{makeValues(std::move(values))} {}
+
+    SharedColumn (const std::vector<T>& values) : values_{makeValues(values.begin(), values.end())} {}
+
+    // ############################################################################
+    // Read Access
+    // ############################################################################
+    const ColumnVector<T>& get () const {
+        static const ColumnVector<T> EMPTY_VALUES{};
+        return values_ ? *values_ : EMPTY_VALUES;
+    }
+
+    std::size_t size () const {
+        return values_ ? values_->size() : 0;
+    }
+
+    bool empty () const {
+        return size() == 0;
+    }
+
+    std::size_t capacity () const {
+        return values_ ? values_->capacity() : 0;
+    }
+
+    const_reference operator[] (std::size_t index) const {
+        return (*values_)[index];
+    }
+
+    const_reference front () const {
+        return get().front();
+    }
+
+    const_reference back () const {
+        return get().back();
+    }
+
+    const T* data () const requires (not std::is_same_v<T, bool>) {
+        return get().data();
+    }
+
+    const_iterator begin () const {
+        return get().begin();
+    }
+
+    const_iterator end () const {
+        return get().end();
+    }
+
+    /**
+     * Returns true if the buffer is shared with other columns.
+    */
+    bool isShared () const {
+        return values_.use_count() > 1;
+    }
+
+    MemoryResource* getMemoryResource () const {
+        return memory_resource_;
+    }
+
+    ColumnAllocator<T> get_allocator () const {
+        return values_ ? values_->get_allocator() : ColumnAllocator<T>{memory_resource_};
+    }
+
+    friend bool operator== (const SharedColumn& lhs, const SharedColumn& rhs) {
+        return lhs.values_ == rhs.values_ || lhs.get() == rhs.get();
+    }
+
+    // ############################################################################
+    // Write Access (Copy-On-Write)
+    // ############################################################################
+    /**
+     * Returns the values for modification, copying them first if the buffer is shared.
+    */
+    ColumnVector<T>& getMutable () {
+        if (not values_) {
+            values_ = makeValues();
+        }
+        else if (isShared()) {
+            values_ = makeValues(begin(), end());
+        }
+        return *values_;
+    }
+
+    reference operator[] (std::size_t index) {
+        return getMutable()[index];
+    }
+
+    template <typename U>
+    void push_back (U&& value) {
+        getMutable().push_back(std::forward<U>(value));
+    }
+
+    void pop_back () {
+        getMutable().pop_back();
+    }
+
+    void reserve (std::size_t capacity) {
+        if (isShared()) {
+            // copy directly into a buffer of the requested capacity
+            auto values = makeValues();
+            values->reserve(std::max(capacity, size()));
+            values->insert(values->end(), begin(), end());
+            values_ = std::move(values);
+        }
+        else if (capacity > this->capacity()) {
+            getMutable().reserve(capacity);
+        }
+    }
+
+    /**
+     * Releases the unused capacity. A shared buffer is kept as is as copying it would not release any memory.
+    */
+    void shrink_to_fit () {
+        if (values_ && not isShared()) {
+            if (values_->empty()) {
+                values_.reset();
+            }
+            else {
+                values_->shrink_to_fit();
+            }
+        }
+    }
+
+    void resize (std::size_t size) {
+        getMutable().resize(size);
+    }
+
+    void clear () {
+        if (isShared()) {
+            values_.reset();
+        }
+        else if (values_) {
+            values_->clear();
+        }
+    }
+
+    template <typename InputIt>
+    void assign (InputIt first, InputIt last) {
+        values_ = makeValues(first, last);
+    }
+
+    template <typename InputIt>
+    void insert (const_iterator position, InputIt first, InputIt last) {
+        const auto offset = std::distance(begin(), position);
+        auto& values = getMutable();
+        values.insert(values.begin() + offset, first, last);
+    }
+
+    void erase (const_iterator first, const_iterator last) {
+        const auto offset_first = std::distance(begin(), first);
+        const auto offset_last = std::distance(begin(), last);
+        auto& values = getMutable();
+        values.erase(values.begin() + offset_first, values.begin() + offset_last);
+    }
+
+    /**
+     * Replaces the values without copying them.
+    */
+    SharedColumn& operator= (ColumnVector<T>&& values) {
+        memory_resource_ = values.get_allocator().getMemoryResource();
+        values_ = makeValues(std::move(values));
+        return *this;
+    }
+
+private:
+    template <typename ...Args>
+    std::shared_ptr<ColumnVector<T>> makeValues (Args&& ...args) const {
+        return std::allocate_shared<ColumnVector<T>>(
+            ColumnAllocator<ColumnVector<T>>{memory_resource_},
+            std::forward<Args>(args)...,
+            ColumnAllocator<T>{memory_resource_}
+        );
+    }
+
+    std::shared_ptr<ColumnVector<T>> makeValues (ColumnVector<T>&& values) const {
+        return std::allocate_shared<ColumnVector<T>>(ColumnAllocator<ColumnVector<T>>{memory_resource_}, std::move(values));
+    }
+
+    MemoryResource* memory_resource_ {getDefaultMemoryResource()};
+    std::shared_ptr<ColumnVector<T>> values_{};
+};
+
+// ############################################################################
+// Util: Get Mutable Values
+// ############################################################################
+/**
+ * Returns the container to modify in bulk: the (unshared) values of a shared column, any other
+ * container as is. Avoids the copy-on-write check per element when appending many values.
+*/
+template <typename Container>
+inline Container& getMutableValues (Container& container) {
+    return container;
+}
+
+template <typename T>
+inline ColumnVector<T>& getMutableValues (SharedColumn<T>& container) {
+    return container.getMutable();
+}
+
+} // namespace dacr::internal
+
+#endif // DATA_CRUNCHING_INTERNAL_SHARED_COLUMN_HPP
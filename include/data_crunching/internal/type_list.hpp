@@ -45,6 +45,20 @@ struct TypeListPrependImpl<TypeToPrepend, TypeList<TypesInList...>> {
 template <typename TypeToPrepend, typename List>
 using TypeListPrepend = typename TypeListPrependImpl<TypeToPrepend, List>::type;
 
+// ############################################################################
+// Trait: Merge Type Lists
+// ############################################################################
+template <typename, typename>
+struct TypeListMergeImpl {};
+
+template <typename ...Types1, typename ...Types2>
+struct TypeListMergeImpl<TypeList<Types1...>, TypeList<Types2...>> {
+    using type = TypeList<Types1..., Types2...>;
+};
+
+template <typename List1, typename List2>
+using TypeListMerge = typename TypeListMergeImpl<List1, List2>::type;
+
 // ############################################################################
 // Trait: Convert TypeList To Tuple
 // ############################################################################
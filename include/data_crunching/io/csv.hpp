@@ -18,6 +18,7 @@
 
 #include "data_crunching/dataframe.hpp"
 #include "data_crunching/string.hpp"
+#include "data_crunching/io/exception.hpp"
 #include "data_crunching/internal/type_conversion.hpp"
 #include "data_crunching/internal/type_list.hpp"
 
@@ -26,10 +27,6 @@
 
 namespace dacr {
 
-class IoException : std::runtime_error {
-    using std::runtime_error::runtime_error;
-};
-
 namespace internal {
 
 template <typename ...Types>
@@ -39,11 +36,16 @@ auto splitIntoTuple (const std::string line, const std::string& delimeter, TypeL
 
 } // namespace internal
 
-template <IsDataFrame DataFrame>
-requires (
-    internal::are_types_convertible_from_string<typename DataFrame::ColumnTypes>
-)
-auto load_from_csv (const std::filesystem::path& path_to_csv, const std::string& delimeter = ",", bool has_header = true) {
+namespace internal {
+
+/**
+ * Number of rows parsed into a chunk before the filter expression of load_from_csv is
+ * evaluated column-at-a-time on the chunk (chunked filtering).
+*/
+inline constexpr std::size_t CSV_FILTER_CHUNK_ROWS = 1 << 14;
+
+template <IsDataFrame DataFrame, typename Func>
+void readCsvRows (const std::filesystem::path& path_to_csv, const std::string& delimeter, bool has_header, Func&& insert_row) {
     if (not std::filesystem::exists(path_to_csv)) {
         throw IoException(std::format("Failed to read file: {}", path_to_csv.native()));
     }
@@ -53,13 +55,49 @@ auto load_from_csv (const std::filesystem::path& path_to_csv, const std::string&
     if (has_header) {
         (void)std::getline(file_stream, line);
     }
-    DataFrame result{};
     while (std::getline(file_stream, line)) {
-        auto tuple = internal::splitIntoTuple(line, delimeter, typename DataFrame::ColumnTypes{});
-        std::apply([&result](auto ...data) {
-            result.insert(data...);
+        auto tuple = splitIntoTuple(line, delimeter, typename DataFrame::ColumnTypes{});
+        std::apply([&insert_row](auto ...data) {
+            insert_row(data...);
         }, tuple);
     }
+}
+
+} // namespace internal
+
+template <IsDataFrame DataFrame>
+requires (
+    internal::are_types_convertible_from_string<typename DataFrame::ColumnTypes>
+)
+auto load_from_csv (const std::filesystem::path& path_to_csv, const std::string& delimeter = ",", bool has_header = true) {
+    DataFrame result{};
+    internal::readCsvRows<DataFrame>(path_to_csv, delimeter, has_header, [&result](auto ...data) {
+        result.insert(data...);
+    });
+    return result;
+}
+
+/**
+ * Loads only the rows satisfying the filter expression by chunked filtering: all rows are parsed,
+ * but only a chunk of rows is stored at a time and the rows not selected are never stored in the
+ * resulting DataFrame. The chunk storage is reused across chunks.
+*/
+template <IsDataFrame DataFrame, internal::IsExpression Expr>
+requires (
+    internal::are_types_convertible_from_string<typename DataFrame::ColumnTypes> &&
+    requires (const DataFrame& df, const Expr& filter) { df.query(filter); }
+)
+auto load_from_csv (const std::filesystem::path& path_to_csv, const Expr& filter, const std::string& delimeter = ",", bool has_header = true) {
+    DataFrame result{};
+    DataFrame chunk{};
+    internal::readCsvRows<DataFrame>(path_to_csv, delimeter, has_header, [&](auto ...data) {
+        chunk.insert(data...);
+        if (chunk.getSize() == internal::CSV_FILTER_CHUNK_ROWS) {
+            result.append(chunk.query(filter));
+            chunk.clear();
+        }
+    });
+    result.append(chunk.query(filter));
     return result;
 }
 
@@ -0,0 +1,28 @@
+// Copyright 2022 Andi Hellmund
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef DATA_CRUNCHING_IO_EXCEPTION_HPP
+#define DATA_CRUNCHING_IO_EXCEPTION_HPP
+
+#include <stdexcept>
+
+namespace dacr {
+
+class IoException : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
+} // namespace dacr
+
+#endif // DATA_CRUNCHING_IO_EXCEPTION_HPP
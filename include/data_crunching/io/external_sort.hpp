@@ -0,0 +1,413 @@
+// Copyright 2022 Andi Hellmund
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef DATA_CRUNCHING_IO_EXTERNAL_SORT_HPP
+#define DATA_CRUNCHING_IO_EXTERNAL_SORT_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "data_crunching/dataframe.hpp"
+#include "data_crunching/io/exception.hpp"
+#include "data_crunching/internal/dataframe_general.hpp"
+#include "data_crunching/internal/dataframe_sort.hpp"
+#include "data_crunching/internal/type_list.hpp"
+
+namespace dacr {
+
+struct ExternalSortOptions {
+    std::size_t memory_budget {std::size_t{256} << 20}; // bytes of rows buffered in memory before a run is spilled
+    std::filesystem::path temp_directory {std::filesystem::temp_directory_path()};
+};
+
+namespace internal {
+
+// ############################################################################
+// Concept: Is Spillable Type
+// ############################################################################
+template <typename T>
+concept IsSpillableType = std::is_same_v<T, std::string> || (std::is_trivially_copyable_v<T> && not std::is_pointer_v<T>);
+
+template <typename>
+struct AreColumnsSpillableImpl : std::false_type {};
+
+template <FixedString ...Names, typename ...Types>
+struct AreColumnsSpillableImpl<TypeList<Column<Names, Types>...>> {
+    static constexpr bool value = (IsSpillableType<Types> && ...);
+};
+
+template <typename ColumnSpecs>
+constexpr bool are_columns_spillable = AreColumnsSpillableImpl<ColumnSpecs>::value;
+
+// ############################################################################
+// Util: Binary Column Serialization
+// ############################################################################
+/**
+ * Estimates the number of bytes a value occupies in memory.
+*/
+template <typename T>
+inline std::size_t estimateValueSize (const T& value) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        return sizeof(T) + value.capacity();
+    }
+    else {
+        return sizeof(T);
+    }
+}
+
+template <typename T>
+inline void writeBinary (std::ostream& stream, const T* data, std::size_t count) {
+    stream.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(count * sizeof(T)));
+}
+
+template <typename T>
+inline void readBinary (std::istream& stream, T* data, std::size_t count) {
+    stream.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(count * sizeof(T)));
+}
+
+/**
+ * Writes the values of the column at the given row indices in a compact binary layout.
+ *
+ * Trivially copyable values are written as raw bytes. Strings are written as the array of
+ * their lengths followed by their concatenated characters.
+*/
+template <typename Container>
+void writeColumnBlock (std::ostream& stream, const Container& column, const std::size_t* row_indices, std::size_t num_rows) {
+    using T = typename Container::value_type;
+    if constexpr (std::is_same_v<T, std::string>) {
+        std::vector<std::uint64_t> lengths(num_rows);
+        for (std::size_t i = 0; i < num_rows; ++i) {
+            lengths[i] = column[row_indices[i]].size();
+        }
+        writeBinary(stream, lengths.data(), num_rows);
+        for (std::size_t i = 0; i < num_rows; ++i) {
+            writeBinary(stream, column[row_indices[i]].data(), lengths[i]);
+        }
+    }
+    else {
+        std::vector<std::conditional_t<std::is_same_v<T, bool>, std::uint8_t, T>> values(num_rows);
+        for (std::size_t i = 0; i < num_rows; ++i) {
+            values[i] = column[row_indices[i]];
+        }
+        writeBinary(stream, values.data(), num_rows);
+    }
+}
+
+template <typename Container>
+void readColumnBlock (std::istream& stream, Container& column, std::size_t num_rows) {
+    using T = typename Container::value_type;
+    column.clear();
+    if constexpr (std::is_same_v<T, std::string>) {
+        std::vector<std::uint64_t> lengths(num_rows);
+        readBinary(stream, lengths.data(), num_rows);
+        column.resize(num_rows);
+        for (std::size_t i = 0; i < num_rows; ++i) {
+            column[i].resize(lengths[i]);
+            readBinary(stream, column[i].data(), lengths[i]);
+        }
+    }
+    else if constexpr (std::is_same_v<T, bool>) {
+        std::vector<std::uint8_t> values(num_rows);
+        readBinary(stream, values.data(), num_rows);
+        column.assign(values.begin(), values.end());
+    }
+    else {
+        column.resize(num_rows);
+        readBinary(stream, column.data(), num_rows);
+    }
+}
+
+// ############################################################################
+// Class: Sort Run Reader
+// ############################################################################
+inline constexpr std::size_t EXTERNAL_SORT_BLOCK_ROWS = 1UL << 12;
+
+/**
+ * Reads a sorted run from its file block by block, such that only one block per run is kept in memory.
+ *
+ * A run file is a sequence of blocks, each consisting of the number of rows followed by one column block per column.
+*/
+template <typename ColumnStoreData>
+class SortRunReader {
+public:
+    explicit SortRunReader (const std::filesystem::path& path) : stream_{path, std::ios::binary} {
+        if (not stream_) {
+            throw IoException("Failed to open external sort run: " + path.string());
+        }
+        readNextBlock();
+    }
+
+    bool hasRow () const {
+        return row_index_ < block_size_;
+    }
+
+    void advance () {
+        if (++row_index_ == block_size_) {
+            readNextBlock();
+        }
+    }
+
+    const ColumnStoreData& getBlock () const {
+        return block_;
+    }
+
+    std::size_t getRowIndex () const {
+        return row_index_;
+    }
+
+private:
+    void readNextBlock () {
+        row_index_ = 0;
+        block_size_ = 0;
+        std::uint64_t num_rows {0};
+        readBinary(stream_, &num_rows, 1);
+        if (stream_.eof()) {
+            return;
+        }
+        std::apply([&](auto& ...columns) {
+            (readColumnBlock(stream_, columns, num_rows), ...);
+        }, block_);
+        if (not stream_) {
+            throw IoException("Failed to read external sort run");
+        }
+        block_size_ = num_rows;
+    }
+
+    std::ifstream stream_;
+    ColumnStoreData block_{};
+    std::size_t block_size_ {0};
+    std::size_t row_index_ {0};
+};
+
+} // namespace internal
+
+// ############################################################################
+// Class: External Sorter
+// ############################################################################
+/**
+ * Sorts more rows than fit into memory by spilling sorted runs to temporary files.
+ *
+ * Rows are inserted into an in-memory buffer. Whenever the (estimated) size of the buffer exceeds the
+ * memory budget, the buffer is sorted with the DataFrame sort and written as run in a binary layout
+ * into the temporary directory. Finally, the runs are merged with a k-way merge either into a
+ * DataFrame or into a sink which is invoked once per row in sorted order. The temporary files are
+ * removed when the sorter is destroyed.
+*/
+template <IsDataFrame DataFrameType, typename ...SortKeySpecs>
+class ExternalSorter;
+
+template <internal::IsColumn ...Columns, typename ...SortKeySpecs>
+requires (
+    internal::are_columns_spillable<TypeList<Columns...>> &&
+    internal::is_valid_sort_key_spec_list<TypeList<SortKeySpecs...>, Columns...>
+)
+class ExternalSorter<DataFrame<Columns...>, SortKeySpecs...> {
+public:
+    using DataFrameType = DataFrame<Columns...>;
+
+    explicit ExternalSorter (const ExternalSortOptions& options = ExternalSortOptions{}) : options_{options} {
+        std::random_device random_device{};
+        run_file_prefix_ = "dacr_external_sort_" + std::to_string(random_device()) + "_" + std::to_string(random_device()) + "_";
+    }
+
+    ExternalSorter (const ExternalSorter&) = delete;
+    ExternalSorter& operator= (const ExternalSorter&) = delete;
+
+    ~ExternalSorter () {
+        removeRunFiles();
+    }
+
+    template <typename ...TypesToInsert>
+    requires (
+        sizeof...(TypesToInsert) == sizeof...(Columns) &&
+        internal::is_convertible_to<TypeList<TypesToInsert...>, internal::GetColumnTypes<Columns...>>
+    )
+    void insert (TypesToInsert&& ...values) {
+        buffer_.insert(std::forward<TypesToInsert>(values)...);
+        buffer_bytes_ += sizeof(std::size_t);
+        std::apply([&](const auto& ...columns) {
+            ((buffer_bytes_ += internal::estimateValueSize(columns.back())), ...);
+        }, getBufferColumns());
+        spillIfOverBudget();
+    }
+
+    void insert (const DataFrameType& df) {
+        buffer_.append(df);
+        buffer_bytes_ += df.getSize() * sizeof(std::size_t);
+        std::apply([&](const auto& ...columns) {
+            ((buffer_bytes_ += estimateColumnSize(columns)), ...);
+        }, std::forward_as_tuple(df.template getColumn<getColumnName<Columns>()>()...));
+        spillIfOverBudget();
+    }
+
+    std::size_t getNumberOfRuns () const {
+        return run_paths_.size();
+    }
+
+    /**
+     * Merges all rows in sorted order into the sink, i.e. sink(values...) is invoked once per row.
+    */
+    template <typename Sink>
+    void finish (Sink&& sink) {
+        if (run_paths_.empty()) {
+            const auto row_indices = buffer_.template argsort<SortKeySpecs...>();
+            const auto columns = getBufferColumns();
+            for (auto row_index : row_indices) {
+                std::apply([&](const auto& ...column) {
+                    sink(column[row_index]...);
+                }, columns);
+            }
+        }
+        else {
+            spillRun();
+            mergeRuns(std::forward<Sink>(sink));
+        }
+        buffer_ = DataFrameType{};
+        buffer_bytes_ = 0;
+        removeRunFiles();
+    }
+
+    DataFrameType finish () {
+        DataFrameType result{};
+        finish([&result](const auto& ...values) {
+            result.insert(values...);
+        });
+        return result;
+    }
+
+private:
+    using ColumnStoreDataType = internal::ConstructColumnStoreDataType<std::vector, Columns...>;
+    using SortKeys = internal::ConstructSortKeysBySpecs<TypeList<SortKeySpecs...>, Columns...>;
+
+    template <typename ColumnSpec>
+    static constexpr auto getColumnName () {
+        return []<FixedString Name, typename Type>(Column<Name, Type>*) {
+            return Name;
+        }(static_cast<ColumnSpec*>(nullptr));
+    }
+
+    template <typename Container>
+    static std::size_t estimateColumnSize (const Container& column) {
+        if constexpr (std::is_same_v<typename Container::value_type, std::string>) {
+            std::size_t bytes {0};
+            for (const auto& value : column) {
+                bytes += internal::estimateValueSize(value);
+            }
+            return bytes;
+        }
+        else {
+            return column.size() * sizeof(typename Container::value_type);
+        }
+    }
+
+    auto getBufferColumns () const {
+        return std::forward_as_tuple(buffer_.template getColumn<getColumnName<Columns>()>()...);
+    }
+
+    void spillIfOverBudget () {
+        if (buffer_bytes_ >= options_.memory_budget) {
+            spillRun();
+        }
+    }
+
+    void spillRun () {
+        const auto path = options_.temp_directory / (run_file_prefix_ + std::to_string(run_paths_.size()) + ".bin");
+        std::ofstream stream{path, std::ios::binary | std::ios::trunc};
+        if (not stream) {
+            throw IoException("Failed to create external sort run: " + path.string());
+        }
+        run_paths_.push_back(path);
+
+        const auto row_indices = buffer_.template argsort<SortKeySpecs...>();
+        const auto columns = getBufferColumns();
+        for (std::size_t begin = 0; begin < row_indices.size(); begin += internal::EXTERNAL_SORT_BLOCK_ROWS) {
+            const std::uint64_t num_rows = std::min(internal::EXTERNAL_SORT_BLOCK_ROWS, row_indices.size() - begin);
+            internal::writeBinary(stream, &num_rows, 1);
+            std::apply([&](const auto& ...column) {
+                (internal::writeColumnBlock(stream, column, row_indices.data() + begin, num_rows), ...);
+            }, columns);
+        }
+        if (not stream.flush()) {
+            throw IoException("Failed to write external sort run: " + path.string());
+        }
+        buffer_ = DataFrameType{};
+        buffer_bytes_ = 0;
+    }
+
+    template <typename Sink>
+    void mergeRuns (Sink&& sink) {
+        std::vector<internal::SortRunReader<ColumnStoreDataType>> readers{};
+        readers.reserve(run_paths_.size());
+        for (const auto& path : run_paths_) {
+            readers.emplace_back(path);
+        }
+
+        // rows comparing equal are taken from the earlier run first
+        auto is_after_in_heap = [&](std::size_t lhs, std::size_t rhs) {
+            const auto& reader_lhs = readers[lhs];
+            const auto& reader_rhs = readers[rhs];
+            if (internal::isRowBeforeBySortKeys(reader_rhs.getBlock(), reader_rhs.getRowIndex(), reader_lhs.getBlock(), reader_lhs.getRowIndex(), SortKeys{})) {
+                return true;
+            }
+            return not internal::isRowBeforeBySortKeys(reader_lhs.getBlock(), reader_lhs.getRowIndex(), reader_rhs.getBlock(), reader_rhs.getRowIndex(), SortKeys{}) && rhs < lhs;
+        };
+        std::vector<std::size_t> heap{};
+        for (std::size_t run_index = 0; run_index < readers.size(); ++run_index) {
+            if (readers[run_index].hasRow()) {
+                heap.push_back(run_index);
+            }
+        }
+        std::make_heap(heap.begin(), heap.end(), is_after_in_heap);
+        while (not heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end(), is_after_in_heap);
+            auto& reader = readers[heap.back()];
+            std::apply([&](const auto& ...column) {
+                sink(column[reader.getRowIndex()]...);
+            }, reader.getBlock());
+            reader.advance();
+            if (reader.hasRow()) {
+                std::push_heap(heap.begin(), heap.end(), is_after_in_heap);
+            }
+            else {
+                heap.pop_back();
+            }
+        }
+    }
+
+    void removeRunFiles () noexcept {
+        for (const auto& path : run_paths_) {
+            std::error_code error_code{};
+            std::filesystem::remove(path, error_code);
+        }
+        run_paths_.clear();
+    }
+
+    ExternalSortOptions options_;
+    std::string run_file_prefix_{};
+    DataFrameType buffer_{};
+    std::size_t buffer_bytes_ {0};
+    std::vector<std::filesystem::path> run_paths_{};
+};
+
+} // namespace dacr
+
+#endif // DATA_CRUNCHING_IO_EXTERNAL_SORT_HPP
@@ -15,7 +15,9 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <optional>
 #include <sstream>
+#include <stdexcept>
 #include <vector>
 #include <ranges>
 
@@ -91,6 +93,111 @@ TEST(DataFrame, Append) {
     EXPECT_THAT(testdf1.getColumn<"chr">(), ::testing::ElementsAre('A', 'B'));
 }
 
+TEST(DataFrame, Capacity) {
+    DataFrame<
+        Column<"int", int>,
+        Column<"dbl", double>
+    > testdf;
+    EXPECT_EQ(testdf.getCapacity(), 0);
+
+    testdf.reserve(100);
+    EXPECT_GE(testdf.getCapacity(), 100);
+    testdf.shrinkToFit();
+    EXPECT_EQ(testdf.getCapacity(), 0);
+
+    // bulk insertions reserve the exact size
+    std::vector<int> rng_int(1000, 1);
+    std::vector<double> rng_dbl(1000, 1.5);
+    testdf.insertRanges(rng_int, rng_dbl);
+    EXPECT_EQ(testdf.getCapacity(), 1000);
+    auto copydf = testdf;
+    testdf.append(copydf);
+    EXPECT_EQ(testdf.getSize(), 2000);
+    EXPECT_EQ(testdf.getCapacity(), 2000);
+
+    // scalar insertions grow geometrically
+    testdf.setGrowthPolicy(GrowthPolicy{.factor = 2.0, .min_capacity = 4});
+    testdf.insert(2, 2.5);
+    EXPECT_EQ(testdf.getCapacity(), 4000);
+    testdf.shrinkToFit();
+    EXPECT_EQ(testdf.getCapacity(), 2001);
+    EXPECT_THAT(testdf.getColumn<"int">().back(), 2);
+
+    // clearing keeps the capacity unless the columns are shared
+    auto shareddf = testdf;
+    testdf.clear();
+    EXPECT_EQ(testdf.getSize(), 0);
+    EXPECT_EQ(shareddf.getSize(), 2001);
+    shareddf.clear();
+    EXPECT_EQ(shareddf.getSize(), 0);
+    EXPECT_EQ(shareddf.getCapacity(), 2001);
+
+    EXPECT_THROW(testdf.setGrowthPolicy(GrowthPolicy{.factor = 1.0}), std::invalid_argument);
+}
+
+TEST(DataFrame, CapacityAmortizedInsert) {
+    DataFrame<Column<"int", int>> testdf;
+    std::size_t num_reallocations {0};
+    std::size_t last_capacity {testdf.getCapacity()};
+    for (int i = 0; i < 100'000; ++i) {
+        testdf.insert(i);
+        if (testdf.getCapacity() != last_capacity) {
+            last_capacity = testdf.getCapacity();
+            ++num_reallocations;
+        }
+    }
+    EXPECT_EQ(testdf.getSize(), 100'000);
+    EXPECT_LT(num_reallocations, 30);
+}
+
+TEST(DataFrame, MemoryResource) {
+    MonotonicMemoryResource arena{};
+    DataFrame<
+        Column<"int", int>,
+        Column<"str", std::string>
+    > testdf{&arena};
+    EXPECT_EQ(testdf.getMemoryResource(), &arena);
+
+    testdf.insert(2, "b");
+    testdf.insert(1, "a");
+    testdf.insert(3, "c");
+    const std::size_t allocated_bytes = arena.getAllocatedBytes();
+    EXPECT_GT(allocated_bytes, 0);
+
+    auto sorted = testdf.sort<SortOrder::Ascending, "int">();
+    auto queried = sorted.query([](dacr_param) { return dacr_value("int") > 1; });
+    auto applied = queried.apply<"twice">([](dacr_param) { return dacr_value("int") * 2; });
+    EXPECT_EQ(applied.getMemoryResource(), &arena);
+    EXPECT_EQ(applied.getColumn<"twice">().get_allocator().getMemoryResource(), &arena);
+    EXPECT_THAT(applied.getColumn<"str">(), ::testing::ElementsAre("b", "c"));
+    EXPECT_THAT(applied.getColumn<"twice">(), ::testing::ElementsAre(4, 6));
+    EXPECT_GT(arena.getAllocatedBytes(), allocated_bytes);
+
+    DataFrame<Column<"int", int>> defaultdf;
+    EXPECT_EQ(defaultdf.getMemoryResource(), getDefaultMemoryResource());
+}
+
+TEST(DataFrame, MemoryResourceParallel) {
+    MonotonicMemoryResource arena{};
+    DataFrame<
+        Column<"int", int>,
+        Column<"dbl", double>
+    > testdf{&arena};
+    constexpr int NUM_ROWS = 200'000;
+    for (int i = 0; i < NUM_ROWS; ++i) {
+        testdf.insert(NUM_ROWS - i, static_cast<double>(i));
+    }
+
+    // the result columns are allocated concurrently from the arena
+    auto sorted = testdf.sort<SortOrder::Ascending, "int">(ParallelPolicy{4});
+    auto queried = testdf.query([](dacr_param) { return dacr_value("int") % 2 == 0; }, ParallelPolicy{4});
+    EXPECT_EQ(sorted.getMemoryResource(), &arena);
+    EXPECT_EQ(sorted.getColumn<"int">().front(), 1);
+    EXPECT_EQ(sorted.getColumn<"dbl">().front(), NUM_ROWS - 1);
+    EXPECT_EQ(queried.getSize(), NUM_ROWS / 2);
+    EXPECT_TRUE(std::ranges::all_of(queried.getColumn<"int">(), [](int value) { return value % 2 == 0; }));
+}
+
 TEST(DataFrame, Select) {
     DataFrame<
         Column<"int", int>,
@@ -198,6 +305,170 @@ TEST(DataFrame, JoinWithType) {
     EXPECT_THAT(dfjoined.getColumn<"flt">(), ::testing::ElementsAre(50.0f));
 }
 
+TEST(DataFrame, JoinWithDuplicateKeys) {
+    DataFrame<
+        Column<"id", int>,
+        Column<"name", std::string>
+    > testdf1;
+    testdf1.insert(1, "a");
+    testdf1.insert(2, "b");
+    testdf1.insert(1, "c");
+    testdf1.insert(3, "d");
+
+    DataFrame<
+        Column<"id", int>,
+        Column<"value", double>
+    > testdf2;
+    testdf2.insert(1, 10.0);
+    testdf2.insert(1, 20.0);
+    testdf2.insert(3, 30.0);
+
+    auto dfjoined = testdf1.join<Join::Inner, "id">(testdf2);
+    EXPECT_THAT(dfjoined.getColumn<"id">(), ::testing::ElementsAre(1, 1, 1, 1, 3));
+    EXPECT_THAT(dfjoined.getColumn<"name">(), ::testing::ElementsAre("a", "a", "c", "c", "d"));
+    EXPECT_THAT(dfjoined.getColumn<"value">(), ::testing::ElementsAre(10.0, 20.0, 10.0, 20.0, 30.0));
+
+    auto dfjoined_swapped = testdf2.join<Join::Inner, "id">(testdf1);
+    EXPECT_THAT(dfjoined_swapped.getColumn<"id">(), ::testing::ElementsAre(1, 1, 1, 1, 3));
+    EXPECT_THAT(dfjoined_swapped.getColumn<"value">(), ::testing::ElementsAre(10.0, 10.0, 20.0, 20.0, 30.0));
+    EXPECT_THAT(dfjoined_swapped.getColumn<"name">(), ::testing::ElementsAre("a", "c", "a", "c", "d"));
+}
+
+TEST(DataFrame, JoinOuter) {
+    DataFrame<
+        Column<"id", int>,
+        Column<"name", std::string>
+    > testdf1;
+    testdf1.insert(1, "a");
+    testdf1.insert(2, "b");
+    testdf1.insert(3, "c");
+
+    DataFrame<
+        Column<"id", int>,
+        Column<"value", double>
+    > testdf2;
+    testdf2.insert(3, 30.0);
+    testdf2.insert(4, 40.0);
+    testdf2.insert(1, 10.0);
+
+    auto dfjoined_left = testdf1.join<Join::Left, "id">(testdf2);
+    EXPECT_TRUE((std::is_same_v<
+        decltype(dfjoined_left),
+        DataFrame<Column<"id", int>, Column<"name", std::string>, Column<"value", std::optional<double>>>
+    >));
+    EXPECT_THAT(dfjoined_left.getColumn<"id">(), ::testing::ElementsAre(1, 2, 3));
+    EXPECT_THAT(dfjoined_left.getColumn<"name">(), ::testing::ElementsAre("a", "b", "c"));
+    EXPECT_THAT(dfjoined_left.getColumn<"value">(), ::testing::ElementsAre(10.0, std::nullopt, 30.0));
+
+    auto dfjoined_right = testdf1.join<Join::Right, "id">(testdf2);
+    EXPECT_TRUE((std::is_same_v<
+        decltype(dfjoined_right),
+        DataFrame<Column<"id", int>, Column<"name", std::optional<std::string>>, Column<"value", double>>
+    >));
+    EXPECT_THAT(dfjoined_right.getColumn<"id">(), ::testing::ElementsAre(1, 3, 4));
+    EXPECT_THAT(dfjoined_right.getColumn<"name">(), ::testing::ElementsAre("a", "c", std::nullopt));
+    EXPECT_THAT(dfjoined_right.getColumn<"value">(), ::testing::ElementsAre(10.0, 30.0, 40.0));
+
+    auto dfjoined_outer = testdf1.join<Join::Outer, "id">(testdf2);
+    EXPECT_TRUE((std::is_same_v<
+        decltype(dfjoined_outer),
+        DataFrame<Column<"id", int>, Column<"name", std::optional<std::string>>, Column<"value", std::optional<double>>>
+    >));
+    EXPECT_THAT(dfjoined_outer.getColumn<"id">(), ::testing::ElementsAre(1, 2, 3, 4));
+    EXPECT_THAT(dfjoined_outer.getColumn<"name">(), ::testing::ElementsAre("a", "b", "c", std::nullopt));
+    EXPECT_THAT(dfjoined_outer.getColumn<"value">(), ::testing::ElementsAre(10.0, std::nullopt, 30.0, 40.0));
+}
+
+TEST(DataFrame, JoinSemiAnti) {
+    DataFrame<
+        Column<"id", int>,
+        Column<"name", std::string>
+    > testdf1;
+    testdf1.insert(1, "a");
+    testdf1.insert(2, "b");
+    testdf1.insert(1, "c");
+
+    DataFrame<
+        Column<"id", int>,
+        Column<"value", double>
+    > testdf2;
+    testdf2.insert(1, 10.0);
+    testdf2.insert(1, 20.0);
+
+    auto dfjoined_semi = testdf1.join<Join::Semi, "id">(testdf2);
+    EXPECT_TRUE((std::is_same_v<decltype(dfjoined_semi), decltype(testdf1)>));
+    EXPECT_THAT(dfjoined_semi.getColumn<"id">(), ::testing::ElementsAre(1, 1));
+    EXPECT_THAT(dfjoined_semi.getColumn<"name">(), ::testing::ElementsAre("a", "c"));
+
+    auto dfjoined_anti = testdf1.join<Join::Anti, "id">(testdf2);
+    EXPECT_TRUE((std::is_same_v<decltype(dfjoined_anti), decltype(testdf1)>));
+    EXPECT_THAT(dfjoined_anti.getColumn<"id">(), ::testing::ElementsAre(2));
+    EXPECT_THAT(dfjoined_anti.getColumn<"name">(), ::testing::ElementsAre("b"));
+
+    auto dfjoined_semi_swapped = testdf2.join<Join::Semi, "id">(testdf1);
+    EXPECT_THAT(dfjoined_semi_swapped.getColumn<"value">(), ::testing::ElementsAre(10.0, 20.0));
+}
+
+TEST(DataFrame, JoinPartitioned) {
+    DataFrame<
+        Column<"id", int>,
+        Column<"name", std::string>
+    > testdf1;
+    testdf1.insert(1, "a");
+    testdf1.insert(2, "b");
+    testdf1.insert(3, "c");
+
+    DataFrame<
+        Column<"id", int>,
+        Column<"value", double>
+    > testdf2;
+    testdf2.insert(3, 30.0);
+    testdf2.insert(1, 10.0);
+    testdf2.insert(4, 40.0);
+
+    auto dfjoined = testdf1.join<Join::Inner, "id">(testdf2, PartitionedHashJoin{.num_threads = 2});
+    auto dfsorted = dfjoined.sort<SortOrder::Ascending, "id">();
+    EXPECT_THAT(dfsorted.getColumn<"id">(), ::testing::ElementsAre(1, 3));
+    EXPECT_THAT(dfsorted.getColumn<"name">(), ::testing::ElementsAre("a", "c"));
+    EXPECT_THAT(dfsorted.getColumn<"value">(), ::testing::ElementsAre(10.0, 30.0));
+
+    auto dfjoined_outer = testdf1.join<Join::Outer, "id">(testdf2, PartitionedHashJoin{});
+    EXPECT_EQ(dfjoined_outer.getSize(), 4);
+    EXPECT_THAT(dfjoined_outer.getColumn<"id">(), ::testing::UnorderedElementsAre(1, 2, 3, 4));
+}
+
+TEST(DataFrame, JoinSortMerge) {
+    DataFrame<
+        Column<"id", int>,
+        Column<"name", std::string>
+    > testdf1;
+    testdf1.insert(1, "a");
+    testdf1.insert(2, "b");
+    testdf1.insert(3, "c");
+
+    DataFrame<
+        Column<"id", int>,
+        Column<"value", double>
+    > testdf2;
+    testdf2.insert(1, 10.0);
+    testdf2.insert(3, 30.0);
+    testdf2.insert(3, 31.0);
+    testdf2.insert(4, 40.0);
+
+    auto dfjoined = testdf1.join<Join::Inner, "id">(testdf2, SortMergeJoin{});
+    EXPECT_THAT(dfjoined.getColumn<"id">(), ::testing::ElementsAre(1, 3, 3));
+    EXPECT_THAT(dfjoined.getColumn<"name">(), ::testing::ElementsAre("a", "c", "c"));
+    EXPECT_THAT(dfjoined.getColumn<"value">(), ::testing::ElementsAre(10.0, 30.0, 31.0));
+
+    auto dfjoined_outer = testdf1.join<Join::Outer, "id">(testdf2, SortMergeJoin{});
+    EXPECT_THAT(dfjoined_outer.getColumn<"id">(), ::testing::ElementsAre(1, 2, 3, 3, 4));
+    EXPECT_THAT(dfjoined_outer.getColumn<"name">(), ::testing::ElementsAre("a", "b", "c", "c", std::nullopt));
+    EXPECT_THAT(dfjoined_outer.getColumn<"value">(), ::testing::ElementsAre(10.0, std::nullopt, 30.0, 31.0, 40.0));
+
+    testdf2.insert(2, 20.0);
+    EXPECT_THROW((testdf1.join<Join::Inner, "id">(testdf2, SortMergeJoin{})), std::invalid_argument);
+}
+
 std::vector<std::string> getLines (std::stringstream& sstr) {
     std::string line;
     std::vector<std::string> lines;
@@ -246,6 +517,499 @@ TEST(DataFrame, Sort) {
     EXPECT_THAT(sorted_by_two_asc.getColumn<"c">(), ::testing::ElementsAre(43.0, 42.0, 45.0, 44.0));
 }
 
+TEST(DataFrame, ArgsortAndGather) {
+    DataFrame<
+        Column<"a", int>,
+        Column<"b", std::string>
+    > testdf;
+    testdf.insert(10, "x");
+    testdf.insert(5, "y");
+    testdf.insert(20, "z");
+
+    auto permutation = testdf.argsort<SortOrder::Descending, "a">();
+    EXPECT_THAT(permutation, ::testing::ElementsAre(2, 0, 1));
+
+    auto gathered = testdf.gather(permutation);
+    EXPECT_THAT(gathered.getColumn<"a">(), ::testing::ElementsAre(20, 10, 5));
+    EXPECT_THAT(gathered.getColumn<"b">(), ::testing::ElementsAre("z", "x", "y"));
+
+    // the permutation can be applied to a frame with the same row order
+    DataFrame<Column<"c", bool>> otherdf;
+    otherdf.insert(true);
+    otherdf.insert(false);
+    otherdf.insert(true);
+    EXPECT_THAT(otherdf.gather(permutation).getColumn<"c">(), ::testing::ElementsAre(true, true, false));
+
+    auto subset = testdf.gather({1, 1});
+    EXPECT_THAT(subset.getColumn<"a">(), ::testing::ElementsAre(5, 5));
+}
+
+TEST(DataFrame, SortWithRadixSort) {
+    DataFrame<
+        Column<"a", int>,
+        Column<"b", double>,
+        Column<"c", std::string>
+    > testdf;
+    for (int i = 0; i < 1000; ++i) {
+        testdf.insert((i * 37) % 11 - 5, ((i * 53) % 101) / 4.0 - 10.0, std::to_string(i));
+    }
+
+    auto sorted_df = testdf.sort<SortOrder::Descending, "a", "b">();
+    ASSERT_EQ(sorted_df.getSize(), 1000);
+    const auto& a = sorted_df.getColumn<"a">();
+    const auto& b = sorted_df.getColumn<"b">();
+    for (std::size_t i = 1; i < sorted_df.getSize(); ++i) {
+        EXPECT_TRUE(a[i - 1] > a[i] || (a[i - 1] == a[i] && b[i - 1] >= b[i]));
+    }
+
+    // rows with equal keys keep their relative order
+    auto stable_df = testdf.sort<SortOrder::Ascending, "a">();
+    const auto& stable_a = stable_df.getColumn<"a">();
+    const auto& stable_c = stable_df.getColumn<"c">();
+    for (std::size_t i = 1; i < stable_df.getSize(); ++i) {
+        if (stable_a[i - 1] == stable_a[i]) {
+            EXPECT_LT(std::stoi(stable_c[i - 1]), std::stoi(stable_c[i]));
+        }
+    }
+}
+
+TEST(DataFrame, SortParallel) {
+    DataFrame<
+        Column<"a", std::string>,
+        Column<"b", int>
+    > testdf;
+    for (int i = 0; i < 100000; ++i) {
+        testdf.insert(std::to_string((i * 7) % 100), i);
+    }
+
+    auto sorted_df = testdf.sort<SortOrder::Ascending, "a">(ParallelPolicy{4});
+    ASSERT_EQ(sorted_df.getSize(), testdf.getSize());
+    const auto& a = sorted_df.getColumn<"a">();
+    const auto& b = sorted_df.getColumn<"b">();
+    for (std::size_t i = 1; i < sorted_df.getSize(); ++i) {
+        EXPECT_TRUE(a[i - 1] < a[i] || (a[i - 1] == a[i] && b[i - 1] < b[i]));
+    }
+    EXPECT_EQ(sorted_df.getColumn<"a">(), (testdf.sort<SortOrder::Ascending, "a">().getColumn<"a">()));
+}
+
+TEST(DataFrame, TopN) {
+    DataFrame<
+        Column<"name", std::string>,
+        Column<"revenue", double>
+    > testdf;
+    testdf.insert("a", 10.0);
+    testdf.insert("b", 50.0);
+    testdf.insert("c", 20.0);
+    testdf.insert("d", 50.0);
+    testdf.insert("e", 5.0);
+
+    auto top = testdf.topN<SortOrder::Descending, "revenue">(3);
+    EXPECT_THAT(top.getColumn<"name">(), ::testing::ElementsAre("b", "d", "c"));
+    EXPECT_THAT(top.getColumn<"revenue">(), ::testing::ElementsAre(50.0, 50.0, 20.0));
+
+    auto bottom = testdf.topN<SortOrder::Ascending, "revenue", "name">(1);
+    EXPECT_THAT(bottom.getColumn<"name">(), ::testing::ElementsAre("e"));
+
+    EXPECT_EQ((testdf.topN<SortOrder::Ascending, "name">(100).getSize()), 5);
+}
+
+TEST(DataFrame, SortSignedZeros) {
+    // -0.0 and +0.0 compare equal: the order must not depend on whether the radix sort is used
+    DataFrame<Column<"a", double>, Column<"b", int>> testdf;
+    for (int i = 0; i < 300; ++i) {
+        testdf.insert(i % 2 == 0 ? 0.0 : -0.0, 300 - i);
+    }
+    auto sorted_small = testdf.gather(std::vector<std::size_t>{0, 1, 2, 3}).sort<SortOrder::Ascending, "a", "b">();
+    EXPECT_THAT(sorted_small.getColumn<"b">(), ::testing::ElementsAre(297, 298, 299, 300));
+    auto sorted = testdf.sort<SortOrder::Ascending, "a", "b">();
+    const auto& b = sorted.getColumn<"b">();
+    EXPECT_TRUE(std::is_sorted(b.begin(), b.end()));
+
+    auto stable = testdf.stableSort<Asc<"a">>();
+    EXPECT_EQ(stable.getColumn<"b">(), testdf.getColumn<"b">());
+}
+
+TEST(DataFrame, SortMixedOrdersAndStable) {
+    DataFrame<
+        Column<"country", std::string>,
+        Column<"revenue", double>,
+        Column<"id", int>
+    > testdf;
+    testdf.insert("DE", 10.0, 0);
+    testdf.insert("US", 30.0, 1);
+    testdf.insert("DE", 20.0, 2);
+    testdf.insert("US", 30.0, 3);
+    testdf.insert("DE", 20.0, 4);
+    testdf.insert("FR", 5.0, 5);
+
+    auto sorted_df = testdf.stableSort<Asc<"country">, Desc<"revenue">>();
+    EXPECT_THAT(sorted_df.getColumn<"id">(), ::testing::ElementsAre(2, 4, 0, 5, 1, 3));
+
+    auto sorted_unstable_df = testdf.sort<Desc<"revenue">, Asc<"id">>();
+    EXPECT_THAT(sorted_unstable_df.getColumn<"id">(), ::testing::ElementsAre(1, 3, 2, 4, 0, 5));
+
+    auto stable_df = testdf.stableSort<SortOrder::Descending, "country">();
+    EXPECT_THAT(stable_df.getColumn<"id">(), ::testing::ElementsAre(1, 3, 5, 0, 2, 4));
+
+    EXPECT_THAT((testdf.argsort<Desc<"country">, Asc<"revenue">>()), ::testing::ElementsAre(1, 3, 5, 0, 2, 4));
+    EXPECT_THAT((testdf.argsort<Asc<"country">, Desc<"revenue">>(ParallelPolicy{2})), ::testing::ElementsAre(2, 4, 0, 5, 1, 3));
+    EXPECT_THAT((testdf.topN<Asc<"country">, Desc<"revenue">>(2).getColumn<"id">()), ::testing::ElementsAre(2, 4));
+}
+
+TEST(DataFrame, SortByStringPrefix) {
+    DataFrame<
+        Column<"city", std::string>,
+        Column<"id", int>
+    > testdf;
+    testdf.insert("Hamburg", 0);
+    testdf.insert("Berlin-Mitte", 1);
+    testdf.insert("Berlin-Kreuzberg", 2);
+    testdf.insert("Berlin", 3);
+    testdf.insert("Berlin-Mitte", 4);
+
+    EXPECT_THAT((testdf.sort<SortOrder::Ascending, "city", "id">().getColumn<"id">()), ::testing::ElementsAre(3, 2, 1, 4, 0));
+    EXPECT_THAT((testdf.stableSort<Desc<"city">>().getColumn<"id">()), ::testing::ElementsAre(0, 1, 4, 2, 3));
+}
+
+TEST(DataFrame, QueryAndApplyWithRowView) {
+    DataFrame<
+        Column<"name", std::string>,
+        Column<"age", int>
+    > testdf;
+    testdf.insert("Alice", 30);
+    testdf.insert("Bob", 40);
+
+    const std::string* name_addresses[2] {nullptr, nullptr};
+    auto query_df = testdf.query([&](dacr_param) {
+        static_assert(std::is_same_v<decltype(dacr_value("name")), const std::string&>);
+        name_addresses[data.getRowIndex()] = &dacr_value("name");
+        return dacr_value("age") > 35;
+    });
+    EXPECT_THAT(query_df.getColumn<"name">(), ::testing::ElementsAre("Bob"));
+    EXPECT_EQ(name_addresses[0], &testdf.getColumn<"name">()[0]);
+    EXPECT_EQ(name_addresses[1], &testdf.getColumn<"name">()[1]);
+
+    // callbacks taking the NamedTuple are still supported
+    auto apply_df = testdf.apply<"name_length", Select<"name">>([](NamedTuple<Field<"name", std::string>> data) {
+        return data.get<"name">().size();
+    });
+    EXPECT_THAT(apply_df.getColumn<"name_length">(), ::testing::ElementsAre(5, 3));
+}
+
+TEST(DataFrame, QuerySelection) {
+    DataFrame<
+        Column<"name", std::string>,
+        Column<"age", int>,
+        Column<"city", std::string>
+    > testdf;
+    testdf.insert("Alice", 30, "Berlin");
+    testdf.insert("Bob", 40, "Paris");
+    testdf.insert("Carol", 50, "Berlin");
+    testdf.insert("Dave", 20, "Berlin");
+
+    auto is_older = testdf.querySelection<Select<"age">>([](dacr_param) {
+        return dacr_value("age") > 25;
+    });
+    auto is_in_berlin = testdf.querySelection<Select<"city">>([](dacr_param) {
+        return dacr_value("city") == "Berlin";
+    });
+    EXPECT_THAT(is_older.getRowIndices(), ::testing::ElementsAre(0, 1, 2));
+    EXPECT_THAT(testdf.gather(is_older & is_in_berlin).getColumn<"name">(), ::testing::ElementsAre("Alice", "Carol"));
+    EXPECT_THAT(testdf.gather(is_older | is_in_berlin).getColumn<"name">(), ::testing::ElementsAre("Alice", "Bob", "Carol", "Dave"));
+    EXPECT_THAT(testdf.gather(~is_in_berlin).getColumn<"name">(), ::testing::ElementsAre("Bob"));
+
+    auto is_older_in_berlin = testdf.querySelection<Select<"city">>([](dacr_param) {
+        return dacr_value("city") == "Berlin";
+    }, is_older);
+    EXPECT_EQ(is_older_in_berlin, is_older & is_in_berlin);
+
+    EXPECT_THROW(testdf.gather(Selection::all(3)), std::invalid_argument);
+}
+
+TEST(DataFrame, QueryWithExpression) {
+    DataFrame<
+        Column<"name", std::string>,
+        Column<"age", int>,
+        Column<"city", std::string>
+    > testdf;
+    testdf.insert("Alice", 30, "Berlin");
+    testdf.insert("Bob", 40, "Paris");
+    testdf.insert("Carol", 50, "Berlin");
+    testdf.insert("Dave", 20, "Berlin");
+
+    auto dfquery = testdf.query(col<"age"> > 25 && col<"city"> == "Berlin");
+    EXPECT_THAT(dfquery.getColumn<"name">(), ::testing::ElementsAre("Alice", "Carol"));
+
+    auto dfquery_negated = testdf.query(!(col<"city"> == "Berlin") || col<"age"> <= 20);
+    EXPECT_THAT(dfquery_negated.getColumn<"name">(), ::testing::ElementsAre("Bob", "Dave"));
+
+    auto is_older = testdf.querySelection(col<"age"> > 25);
+    EXPECT_THAT(is_older.getRowIndices(), ::testing::ElementsAre(0, 1, 2));
+    EXPECT_EQ(testdf.querySelection(col<"city"> == "Berlin", is_older), (Selection{{0, 2}, 4}));
+    EXPECT_EQ(testdf.query(col<"age"> > 100).getSize(), 0);
+}
+
+TEST(DataFrame, JoinWithFilter) {
+    DataFrame<
+        Column<"id", int>,
+        Column<"name", std::string>
+    > testdf1;
+    testdf1.insert(1, "a");
+    testdf1.insert(2, "b");
+    testdf1.insert(3, "c");
+
+    DataFrame<
+        Column<"id", int>,
+        Column<"value", double>
+    > testdf2;
+    testdf2.insert(3, 30.0);
+    testdf2.insert(4, 40.0);
+    testdf2.insert(1, 10.0);
+
+    auto dfjoined_inner = testdf1.join<Join::Inner, "id">(testdf2, col<"value"> > 15.0 && col<"name"> != "b");
+    EXPECT_THAT(dfjoined_inner.getColumn<"id">(), ::testing::ElementsAre(3));
+    EXPECT_THAT(dfjoined_inner.getColumn<"value">(), ::testing::ElementsAre(30.0));
+
+    auto dfjoined_left = testdf1.join<Join::Left, "id">(testdf2, col<"id"> < 3 && col<"value"> < 15.0);
+    EXPECT_THAT(dfjoined_left.getColumn<"id">(), ::testing::ElementsAre(1));
+    EXPECT_THAT(dfjoined_left.getColumn<"value">(), ::testing::ElementsAre(10.0));
+
+    auto dfjoined_outer = testdf1.join<Join::Outer, "id">(testdf2, col<"id"> > 1, SortMergeJoin{});
+    EXPECT_THAT(dfjoined_outer.getColumn<"id">(), ::testing::ElementsAre(2, 3, 4));
+    EXPECT_THAT(dfjoined_outer.getColumn<"name">(), ::testing::ElementsAre("b", "c", std::nullopt));
+
+    auto dfjoined_anti = testdf1.join<Join::Anti, "id">(testdf2, col<"name"> != "a");
+    EXPECT_THAT(dfjoined_anti.getColumn<"id">(), ::testing::ElementsAre(2));
+
+    auto dfjoined_semi_right = testdf1.join<Join::Semi, "id">(testdf2, col<"value"> > 15.0);
+    EXPECT_THAT(dfjoined_semi_right.getColumn<"id">(), ::testing::ElementsAre(3));
+
+    auto dfjoined_anti_right = testdf1.join<Join::Anti, "id">(testdf2, col<"value"> > 15.0 && col<"name"> != "b");
+    EXPECT_THAT(dfjoined_anti_right.getColumn<"id">(), ::testing::ElementsAre(1));
+}
+
+TEST(DataFrame, ApplyAndQueryParallel) {
+    DataFrame<
+        Column<"a", int>,
+        Column<"b", double>
+    > testdf;
+    for (int i = 0; i < 100'000; ++i) {
+        testdf.insert(i, static_cast<double>(i % 97) * 0.5);
+    }
+
+    auto dfapply = testdf.apply<"c">([](dacr_param) {
+        return dacr_value("a") * dacr_value("b");
+    });
+    auto dfapply_parallel = testdf.apply<"c">([](dacr_param) {
+        return dacr_value("a") * dacr_value("b");
+    }, ParallelPolicy{.num_threads = 4});
+    EXPECT_EQ(dfapply_parallel.getColumn<"c">(), dfapply.getColumn<"c">());
+    EXPECT_EQ(dfapply_parallel.getColumn<"a">(), testdf.getColumn<"a">());
+
+    auto dfapply_bool = testdf.apply<"even", Select<"a">>([](dacr_param) {
+        return dacr_value("a") % 2 == 0;
+    }, ParallelPolicy{.num_threads = 4});
+    EXPECT_EQ(dfapply_bool.getSize(), testdf.getSize());
+    EXPECT_TRUE(dfapply_bool.getColumn<"even">()[99'998]);
+    EXPECT_FALSE(dfapply_bool.getColumn<"even">()[99'999]);
+
+    auto query_function = [](dacr_param) {
+        return dacr_value("b") > 20.0 && dacr_value("a") % 3 != 0;
+    };
+    auto dfquery = testdf.query(query_function);
+    auto dfquery_parallel = testdf.query(query_function, ParallelPolicy{.num_threads = 4});
+    EXPECT_EQ(dfquery_parallel.getColumn<"a">(), dfquery.getColumn<"a">());
+    EXPECT_EQ(dfquery_parallel.getColumn<"b">(), dfquery.getColumn<"b">());
+    EXPECT_EQ(testdf.querySelection(query_function, par), testdf.querySelection(query_function));
+}
+
+template <typename DataFrameType>
+concept CanCreateLazyFrame = requires (DataFrameType&& df) {
+    std::forward<DataFrameType>(df).lazy();
+};
+
+TEST(DataFrame, Lazy) {
+    DataFrame<Column<"a", int>, Column<"b", double>, Column<"name", std::string>> testdf;
+    for (int i = 0; i < 1'000; ++i) {
+        testdf.insert(i, static_cast<double>(i % 17), "name" + std::to_string(i));
+    }
+
+    int num_unused_apply_calls {0};
+    auto dflazy = testdf.lazy()
+        .query<Select<"a">>([](dacr_param) { return dacr_value("a") % 2 == 0; })
+        .apply<"c">([](dacr_param) { return dacr_value("a") * dacr_value("b"); })
+        .apply<"unused">([&num_unused_apply_calls](dacr_param) { ++num_unused_apply_calls; return 1; })
+        .query(col<"c"> > 100.0 && col<"b"> < 16.0)
+        .sort<Desc<"c">, Asc<"a">>()
+        .apply<"d", Select<"c", "name">>([](dacr_param) { return dacr_value("c") + 1.0; })
+        .select<"d", "name", "c">()
+        .collect();
+
+    auto dfeager = testdf
+        .query<Select<"a">>([](dacr_param) { return dacr_value("a") % 2 == 0; })
+        .apply<"c">([](dacr_param) { return dacr_value("a") * dacr_value("b"); })
+        .query(col<"c"> > 100.0 && col<"b"> < 16.0)
+        .sort<Desc<"c">, Asc<"a">>()
+        .apply<"d", Select<"c", "name">>([](dacr_param) { return dacr_value("c") + 1.0; })
+        .select<"d", "name", "c">();
+
+    EXPECT_EQ(num_unused_apply_calls, 0);
+    EXPECT_TRUE((std::is_same_v<decltype(dflazy), decltype(dfeager)>));
+    EXPECT_GT(dflazy.getSize(), 0);
+    EXPECT_EQ(dflazy.getColumn<"d">(), dfeager.getColumn<"d">());
+    EXPECT_EQ(dflazy.getColumn<"name">(), dfeager.getColumn<"name">());
+    EXPECT_EQ(dflazy.getColumn<"c">(), dfeager.getColumn<"c">());
+
+    // computed columns are compacted across several filtering passes
+    auto dfpasses = testdf.lazy()
+        .apply<"c">([](dacr_param) { return std::to_string(dacr_value("a")); })
+        .query<Select<"b">>([](dacr_param) { return dacr_value("b") == 3.0; })
+        .sort<SortOrder::Descending, "a">()
+        .query<Select<"a">>([](dacr_param) { return dacr_value("a") < 500; })
+        .collect();
+    ASSERT_EQ(dfpasses.getSize(), 30);
+    EXPECT_EQ(dfpasses.getColumn<"a">()[0], 496);
+    EXPECT_EQ(dfpasses.getColumn<"c">()[0], "496");
+    EXPECT_EQ(dfpasses.getColumn<"c">()[29], "3");
+
+    EXPECT_TRUE((CanCreateLazyFrame<const decltype(testdf)&>));
+    EXPECT_FALSE((CanCreateLazyFrame<decltype(testdf)&&>));
+}
+
+TEST(DataFrame, View) {
+    DataFrame<
+        Column<"id", int>,
+        Column<"name", std::string>,
+        Column<"value", double>,
+        Column<"flag", bool>
+    > testdf;
+    testdf.insert(3, "c", 30.0, true);
+    testdf.insert(1, "a", 10.0, false);
+    testdf.insert(2, "b", 20.0, true);
+
+    auto testview = testdf.view<"value", "id", "flag">();
+    EXPECT_TRUE((std::is_same_v<
+        decltype(testview),
+        DataFrameView<Column<"value", double>, Column<"id", int>, Column<"flag", bool>>
+    >));
+    EXPECT_EQ(testview.getSize(), 3);
+    EXPECT_EQ(testview.getColumn<"value">().data(), testdf.getColumn<"value">().data());
+    EXPECT_TRUE((std::is_same_v<decltype(testview.materialize()), decltype(testdf.select<"value", "id", "flag">())>));
+    EXPECT_THAT(testview.materialize().getColumn<"flag">(), ::testing::ElementsAre(true, false, true));
+
+    auto dfquery = testview.query<Select<"flag">>([](dacr_param) { return dacr_value("flag"); });
+    EXPECT_THAT(dfquery.getColumn<"id">(), ::testing::ElementsAre(3, 2));
+    auto dfquery_expression = testview.query(col<"value"> > 15.0);
+    EXPECT_THAT(dfquery_expression.getColumn<"value">(), ::testing::ElementsAre(30.0, 20.0));
+
+    auto dfsorted = testview.sort<SortOrder::Ascending, "id">();
+    EXPECT_THAT(dfsorted.getColumn<"id">(), ::testing::ElementsAre(1, 2, 3));
+    EXPECT_THAT(dfsorted.getColumn<"value">(), ::testing::ElementsAre(10.0, 20.0, 30.0));
+    EXPECT_THAT((testview.argsort<Desc<"value">>()), ::testing::ElementsAre(0, 2, 1));
+
+    auto dfsummarized = testview.summarize<GroupBy<"flag">, Sum<"value", "value_sum">>();
+    EXPECT_THAT(dfsummarized.getColumn<"value_sum">(), ::testing::UnorderedElementsAre(50.0, 10.0));
+
+    DataFrame<Column<"id", int>, Column<"label", char>> otherdf;
+    otherdf.insert(2, 'B');
+    otherdf.insert(3, 'C');
+    auto dfjoined = testview.join<Join::Inner, "id">(otherdf);
+    EXPECT_TRUE((std::is_same_v<
+        decltype(dfjoined),
+        DataFrame<Column<"value", double>, Column<"id", int>, Column<"flag", bool>, Column<"label", char>>
+    >));
+    EXPECT_THAT(dfjoined.getColumn<"id">(), ::testing::ElementsAre(3, 2));
+    EXPECT_THAT(dfjoined.getColumn<"label">(), ::testing::ElementsAre('C', 'B'));
+    auto dfjoined_views = testdf.view<"id", "name">().join<Join::Left, "id">(otherdf.view<"id", "label">());
+    EXPECT_THAT(dfjoined_views.getColumn<"label">(), ::testing::ElementsAre('C', std::nullopt, 'B'));
+
+    std::stringstream view_stream, df_stream;
+    testdf.view<"id", "name">().view<"name">().print(PrintOptions{}, view_stream);
+    testdf.select<"name">().print(PrintOptions{}, df_stream);
+    EXPECT_EQ(view_stream.str(), df_stream.str());
+}
+
+TEST(DataFrame, CopyOnWrite) {
+    DataFrame<Column<"a", int>, Column<"b", double>> testdf;
+    testdf.insert(1, 1.5);
+    testdf.insert(2, 2.5);
+
+    auto dfselect = testdf.select<"b">();
+    EXPECT_EQ(dfselect.getColumn<"b">().data(), testdf.getColumn<"b">().data());
+
+    auto dfapply = testdf.apply<"c">([](dacr_param) { return dacr_value("a") * 2; });
+    EXPECT_EQ(dfapply.getColumn<"a">().data(), testdf.getColumn<"a">().data());
+    EXPECT_EQ(dfapply.getColumn<"b">().data(), testdf.getColumn<"b">().data());
+    EXPECT_THAT(dfapply.getColumn<"c">(), ::testing::ElementsAre(2, 4));
+
+    auto dfquery = testdf.query([](dacr_param) { return dacr_value("a") > 0; });
+    EXPECT_EQ(dfquery.getColumn<"a">().data(), testdf.getColumn<"a">().data());
+
+    auto dfcopy = testdf;
+    dfcopy.insert(3, 3.5);
+    testdf.append(dfselect.apply<"a", Select<"b">>([](dacr_param) { return 0; }).select<"a", "b">());
+    EXPECT_THAT(dfcopy.getColumn<"a">(), ::testing::ElementsAre(1, 2, 3));
+    EXPECT_THAT(testdf.getColumn<"a">(), ::testing::ElementsAre(1, 2, 0, 0));
+    EXPECT_THAT(dfselect.getColumn<"b">(), ::testing::ElementsAre(1.5, 2.5));
+    EXPECT_THAT(dfapply.getColumn<"a">(), ::testing::ElementsAre(1, 2));
+    EXPECT_THAT(dfquery.getColumn<"b">(), ::testing::ElementsAre(1.5, 2.5));
+}
+
+TEST(DataFrame, CopyOnWriteColumnReference) {
+    DataFrame<Column<"a", int>> testdf;
+    testdf.insert(1);
+    testdf.insert(2);
+
+    // the column reference stays valid when the shared buffer is copied on write
+    const auto& column = testdf.getColumn<"a">();
+    {
+        auto dfcopy = testdf;
+        testdf.insert(3);
+    }
+    EXPECT_EQ(column.size(), 3);
+    EXPECT_THAT(column, ::testing::ElementsAre(1, 2, 3));
+}
+
+TEST(DataFrame, Categorical) {
+    DataFrame<
+        Column<"city", Categorical>,
+        Column<"revenue", int>
+    > testdf;
+    testdf.insert("Munich", 10);
+    testdf.insert(std::string{"Berlin"}, 20);
+    testdf.insert("Hamburg", 30);
+    testdf.insert("Berlin", 40);
+    EXPECT_EQ(testdf.getColumn<"city">()[1], testdf.getColumn<"city">()[3]);
+
+    auto dfquery = testdf.query([](dacr_param) { return dacr_value("city") == "Berlin"; });
+    EXPECT_THAT(dfquery.getColumn<"revenue">(), ::testing::ElementsAre(20, 40));
+    EXPECT_EQ(testdf.query(col<"city"> != "Berlin").getSize(), 2);
+
+    const auto dictionary_size = getCategoricalDictionary().getSize();
+    EXPECT_EQ(testdf.query(col<"city"> < "Cologne").getSize(), 2);
+    EXPECT_EQ(testdf.query(col<"city"> == "Cologne").getSize(), 0);
+    EXPECT_EQ(getCategoricalDictionary().getSize(), dictionary_size);
+
+    auto dfsorted = testdf.sort<Asc<"city">, Desc<"revenue">>();
+    EXPECT_THAT(dfsorted.getColumn<"city">(), ::testing::ElementsAre("Berlin", "Berlin", "Hamburg", "Munich"));
+    EXPECT_THAT(dfsorted.getColumn<"revenue">(), ::testing::ElementsAre(40, 20, 30, 10));
+
+    auto dfsummary = testdf.summarize<GroupBy<"city">, Sum<"revenue", "revenue_sum">>().sort<SortOrder::Ascending, "city">();
+    EXPECT_THAT(dfsummary.getColumn<"city">(), ::testing::ElementsAre("Berlin", "Hamburg", "Munich"));
+    EXPECT_THAT(dfsummary.getColumn<"revenue_sum">(), ::testing::ElementsAre(60, 30, 10));
+
+    DataFrame<Column<"city", Categorical>, Column<"country", std::string>> countries;
+    countries.insert("Berlin", "DE");
+    countries.insert("Paris", "FR");
+    auto dfjoin = testdf.join<Join::Inner, "city">(countries);
+    EXPECT_THAT(dfjoin.getColumn<"revenue">(), ::testing::UnorderedElementsAre(20, 40));
+    EXPECT_THAT(dfjoin.getColumn<"country">(), ::testing::ElementsAre("DE", "DE"));
+
+    std::stringstream sstr;
+    testdf.print(PrintOptions{}, sstr);
+    EXPECT_THAT(sstr.str(), ::testing::HasSubstr("Hamburg"));
+}
+
 TEST(DataFrame, GroupBy) {
     DataFrame<
         Column<"a", int>,
@@ -288,6 +1052,70 @@ TEST(DataFrame, GroupBy) {
     EXPECT_THAT(summarize_group_by_two_columns.getColumn<"d_false">(), ::testing::ElementsAre(0, 2));
 }
 
+TEST(DataFrame, GroupByManyGroups) {
+    DataFrame<
+        Column<"id", int>,
+        Column<"value", double>
+    > testdf;
+    for (int i = 0; i < 10000; ++i) {
+        testdf.insert(999 - (i % 1000), 1.0);
+    }
+
+    auto summarized = testdf.summarize<
+        GroupBy<"id">,
+        Sum<"value", "value_sum">
+    >();
+    ASSERT_EQ(summarized.getSize(), 1000);
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(summarized.getColumn<"id">()[i], 999 - i);
+        EXPECT_EQ(summarized.getColumn<"value_sum">()[i], 10.0);
+    }
+}
+
+TEST(DataFrame, SummarizeParallel) {
+    DataFrame<
+        Column<"id", int>,
+        Column<"value", double>,
+        Column<"flag", bool>
+    > testdf;
+    for (int i = 0; i < 1000; ++i) {
+        testdf.insert((i * 17) % 23, static_cast<double>(i % 50), i % 3 == 0);
+    }
+
+    auto summarized = testdf.summarize<
+        GroupBy<"id">,
+        Sum<"value", "value_sum">,
+        Avg<"value", "value_avg">,
+        Max<"value", "value_max">,
+        CountIf<"flag", "flag_true">
+    >();
+    auto summarized_parallel = testdf.summarize<
+        GroupBy<"id">,
+        Sum<"value", "value_sum">,
+        Avg<"value", "value_avg">,
+        Max<"value", "value_max">,
+        CountIf<"flag", "flag_true">
+    >(ParallelPolicy{.num_threads = 4});
+    EXPECT_EQ(summarized_parallel.getColumn<"id">(), summarized.getColumn<"id">());
+    EXPECT_EQ(summarized_parallel.getColumn<"value_sum">(), summarized.getColumn<"value_sum">());
+    EXPECT_EQ(summarized_parallel.getColumn<"value_max">(), summarized.getColumn<"value_max">());
+    EXPECT_EQ(summarized_parallel.getColumn<"flag_true">(), summarized.getColumn<"flag_true">());
+    for (std::size_t i = 0; i < summarized.getSize(); ++i) {
+        EXPECT_DOUBLE_EQ(summarized_parallel.getColumn<"value_avg">()[i], summarized.getColumn<"value_avg">()[i]);
+    }
+
+    auto summarized_variance = testdf.summarize<GroupBy<"flag">, StdDev<"value", "value_stddev">, VarianceSample<"value", "value_var">>();
+    auto summarized_variance_parallel = testdf.summarize<GroupBy<"flag">, StdDev<"value", "value_stddev">, VarianceSample<"value", "value_var">>(ParallelPolicy{.num_threads = 3});
+    for (std::size_t i = 0; i < summarized_variance.getSize(); ++i) {
+        EXPECT_NEAR(summarized_variance_parallel.getColumn<"value_stddev">()[i], summarized_variance.getColumn<"value_stddev">()[i], 1e-9);
+        EXPECT_NEAR(summarized_variance_parallel.getColumn<"value_var">()[i], summarized_variance.getColumn<"value_var">()[i], 1e-9);
+    }
+
+    auto summarized_no_group_by = testdf.summarize<GroupByNone, Sum<"value", "value_sum">, CountIf<"flag", "flag_true">>(par);
+    EXPECT_THAT(summarized_no_group_by.getColumn<"value_sum">(), ::testing::ElementsAre(24500.0));
+    EXPECT_THAT(summarized_no_group_by.getColumn<"flag_true">(), ::testing::ElementsAre(334));
+}
+
 struct MyData {
     int a;
     char b;
@@ -0,0 +1,104 @@
+// Copyright 2022 Andi Hellmund
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "data_crunching/internal/categorical.hpp"
+#include "data_crunching/internal/dataframe_sort.hpp"
+
+using namespace dacr;
+using namespace dacr::internal;
+
+TEST(Categorical, Dictionary) {
+    CategoricalDictionary dictionary{};
+    EXPECT_EQ(dictionary.getSize(), 1);
+    EXPECT_EQ(dictionary.decode(0), "");
+
+    const auto code_b = dictionary.encode("b");
+    const auto code_a = dictionary.encode("a");
+    EXPECT_EQ(dictionary.encode("b"), code_b);
+    EXPECT_EQ(dictionary.decode(code_a), "a");
+    EXPECT_EQ(dictionary.getSize(), 3);
+    EXPECT_EQ(dictionary.find("a"), code_a);
+    EXPECT_FALSE(dictionary.find("c").has_value());
+    EXPECT_EQ(dictionary.getSize(), 3);
+}
+
+TEST(Categorical, DictionaryChunks) {
+    CategoricalDictionary dictionary{};
+    std::vector<std::thread> threads{};
+    for (int thread_index = 0; thread_index < 4; ++thread_index) {
+        threads.emplace_back([&dictionary]() {
+            for (int i = 0; i < 1000; ++i) {
+                dictionary.encode(std::to_string(i));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(dictionary.getSize(), 1001);
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(dictionary.decode(dictionary.encode(std::to_string(i))), std::to_string(i));
+    }
+}
+
+TEST(Categorical, Value) {
+    Categorical berlin {"Berlin"};
+    Categorical munich {std::string{"Munich"}};
+    EXPECT_EQ(sizeof(Categorical), sizeof(std::uint32_t));
+    EXPECT_EQ(Categorical{}.view(), "");
+    EXPECT_EQ(berlin.view(), "Berlin");
+    EXPECT_EQ(munich.str(), "Munich");
+    EXPECT_EQ(berlin, Categorical::fromCode(berlin.getCode()));
+    EXPECT_EQ(std::hash<Categorical>{}(berlin), std::hash<Categorical>{}(Categorical{"Berlin"}));
+
+    EXPECT_NE(berlin, munich);
+    EXPECT_LT(berlin, munich);
+    EXPECT_TRUE(berlin == "Berlin");
+    EXPECT_TRUE("Berlin" == berlin);
+    EXPECT_TRUE(berlin < std::string{"Bonn"});
+
+    std::stringstream sstr;
+    sstr << berlin;
+    EXPECT_EQ(sstr.str(), "Berlin");
+}
+
+TEST(Categorical, RankCategoricalCodes) {
+    std::vector<Categorical> column {"rank_z", "rank_x", "rank_y", "rank_x", "rank_w"};
+    const auto ranks = rankCategoricalCodes(column, 4);
+    EXPECT_EQ(ranks.size(), 3);
+    EXPECT_EQ(ranks.at(Categorical{"rank_x"}.getCode()), 0);
+    EXPECT_EQ(ranks.at(Categorical{"rank_y"}.getCode()), 1);
+    EXPECT_EQ(ranks.at(Categorical{"rank_z"}.getCode()), 2);
+}
+
+TEST(Categorical, ArgsortByRank) {
+    std::tuple<std::vector<Categorical>, std::vector<int>> column_store_data {
+        {"c", "a", "b", "a"},
+        {1, 2, 3, 4}
+    };
+    using SortKeysAsc = TypeList<SortKey<SortOrder::Ascending, 0>, SortKey<SortOrder::Descending, 1>>;
+    EXPECT_TRUE((has_categorical_key<SortKeysAsc, decltype(column_store_data)>));
+    EXPECT_THAT((argsortRowsByCategoricalRank<SortKeysAsc, false>(column_store_data, 4)), ::testing::ElementsAre(3, 1, 2, 0));
+
+    using SortKeysDesc = TypeList<SortKey<SortOrder::Descending, 0>>;
+    EXPECT_THAT((argsortRowsByCategoricalRank<SortKeysDesc, true>(column_store_data, 4)), ::testing::ElementsAre(0, 2, 1, 3));
+}
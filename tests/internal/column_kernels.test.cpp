@@ -0,0 +1,132 @@
+// Copyright 2022 Andi Hellmund
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <limits>
+#include <vector>
+
+#include "data_crunching/internal/column_kernels.hpp"
+
+using namespace dacr::internal;
+
+template <typename T>
+std::vector<T> createValues (std::size_t size) {
+    std::vector<T> values{};
+    for (std::size_t i = 0; i < size; ++i) {
+        values.push_back(static_cast<T>((i * 37) % 101) - static_cast<T>(50));
+    }
+    return values;
+}
+
+/**
+ * Runs the test function with the kernels of each SIMD level supported by the CPU.
+*/
+template <typename Func>
+void forEachSimdLevel (Func&& test_function) {
+    for (auto simd_level : {SimdLevel::Scalar, SimdLevel::Avx2, SimdLevel::Avx512}) {
+        if (simd_level <= getSupportedSimdLevel()) {
+            SCOPED_TRACE(static_cast<int>(simd_level));
+            setSimdLevel(simd_level);
+            test_function();
+        }
+    }
+    setSimdLevel(getSupportedSimdLevel());
+}
+
+TEST(ColumnKernels, SimdLevel) {
+    EXPECT_EQ(getSimdLevel(), getSupportedSimdLevel());
+    setSimdLevel(SimdLevel::Scalar);
+    EXPECT_EQ(getSimdLevel(), SimdLevel::Scalar);
+    setSimdLevel(SimdLevel::Avx512);
+    EXPECT_EQ(getSimdLevel(), getSupportedSimdLevel());
+}
+
+TEST(ColumnKernels, SumColumn) {
+    forEachSimdLevel([]() {
+        // sizes cover the vectorized part as well as the remainder
+        for (std::size_t size : {0, 1, 7, 8, 33, 1000}) {
+            auto values_int = createValues<int>(size);
+            auto values_double = createValues<double>(size);
+            auto values_float = createValues<float>(size);
+            int expected {0};
+            for (auto value : values_int) {
+                expected += value;
+            }
+            EXPECT_EQ(sumColumn(values_int.data(), size), expected);
+            EXPECT_DOUBLE_EQ(sumColumn(values_double.data(), size), expected);
+            EXPECT_FLOAT_EQ(sumColumn(values_float.data(), size), expected);
+            EXPECT_DOUBLE_EQ(sumColumnAsDouble(values_int.data(), size), expected);
+            EXPECT_DOUBLE_EQ(sumColumnAsDouble(values_double.data(), size), expected);
+        }
+    });
+}
+
+TEST(ColumnKernels, MinMaxColumn) {
+    forEachSimdLevel([]() {
+        for (std::size_t size : {1, 7, 8, 33, 1000}) {
+            auto values_int = createValues<int>(size);
+            auto values_double = createValues<double>(size);
+            values_int[size - 1] = -1000;
+            values_double[size / 2] = 1000.0;
+            EXPECT_EQ(minColumn(values_int.data(), size, std::numeric_limits<int>::max()), -1000);
+            EXPECT_DOUBLE_EQ(maxColumn(values_double.data(), size, std::numeric_limits<double>::lowest()), 1000.0);
+            EXPECT_EQ(maxColumn(values_int.data(), size, 5000), 5000);
+            EXPECT_DOUBLE_EQ(minColumn(values_double.data(), size, -5000.0), -5000.0);
+        }
+        EXPECT_EQ(minColumn(static_cast<const int*>(nullptr), 0, 42), 42);
+    });
+}
+
+TEST(ColumnKernels, SumSquaredDeviationsColumn) {
+    std::vector<int> values{2, 4, 4, 4, 5, 5, 7, 9, 2, 4, 4, 4, 5, 5, 7, 9, 5};
+    EXPECT_DOUBLE_EQ(sumSquaredDeviationsColumn(values.data(), values.size(), 5.0), 64.0);
+}
+
+TEST(ColumnKernels, CompareColumnWithValue) {
+    forEachSimdLevel([]() {
+        const auto values = createValues<double>(1003);
+        std::vector<std::uint8_t> mask(values.size());
+        for (double threshold : {-60.0, -10.0, 0.0, 17.0, 60.0}) {
+            compareColumnWithValue(values.data(), values.size(), threshold, GreaterOp{}, mask.data());
+            for (std::size_t index = 0; index < values.size(); ++index) {
+                EXPECT_EQ(mask[index], values[index] > threshold ? 1 : 0);
+            }
+            compareColumnWithValue(values.data(), values.size(), static_cast<int>(threshold), LessEqualOp{}, mask.data());
+            for (std::size_t index = 0; index < values.size(); ++index) {
+                EXPECT_EQ(mask[index], values[index] <= static_cast<int>(threshold) ? 1 : 0);
+            }
+        }
+
+        const std::vector<double> special_values {0.0, std::numeric_limits<double>::quiet_NaN(), -0.0, 1.0, std::numeric_limits<double>::quiet_NaN()};
+        std::vector<std::uint8_t> special_mask(special_values.size());
+        compareColumnWithValue(special_values.data(), special_values.size(), 0.0, EqualOp{}, special_mask.data());
+        EXPECT_THAT(special_mask, ::testing::ElementsAre(1, 0, 1, 0, 0));
+        compareColumnWithValue(special_values.data(), special_values.size(), 0.0, NotEqualOp{}, special_mask.data());
+        EXPECT_THAT(special_mask, ::testing::ElementsAre(0, 1, 0, 1, 1));
+    });
+}
+
+TEST(ColumnKernels, CombineMasks) {
+    std::vector<std::uint8_t> mask {0, 1, 1, 0};
+    const std::vector<std::uint8_t> other {1, 1, 0, 0};
+    andMasks(mask.data(), other.data(), mask.size());
+    EXPECT_THAT(mask, ::testing::ElementsAre(0, 1, 0, 0));
+    orMasks(mask.data(), other.data(), mask.size());
+    EXPECT_THAT(mask, ::testing::ElementsAre(1, 1, 0, 0));
+    invertMask(mask.data(), mask.size());
+    EXPECT_THAT(mask, ::testing::ElementsAre(0, 0, 1, 1));
+    EXPECT_EQ(countMask(mask.data(), mask.size()), 2);
+}
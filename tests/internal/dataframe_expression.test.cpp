@@ -0,0 +1,189 @@
+// Copyright 2022 Andi Hellmund
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "data_crunching/internal/dataframe_expression.hpp"
+#include "data_crunching/internal/dataframe_general.hpp"
+
+using namespace dacr;
+using namespace dacr::internal;
+
+using ExpressionColumns = TypeList<Column<"age", int>, Column<"weight", double>, Column<"city", std::string>, Column<"valid", bool>>;
+using ExpressionColumnStore = std::tuple<std::vector<int>, std::vector<double>, std::vector<std::string>, std::vector<bool>>;
+
+ExpressionColumnStore createExpressionColumnStore () {
+    return {
+        {20, 35, 40, 31, 50},
+        {60.0, 80.5, 72.0, 90.0, 55.5},
+        {"Berlin", "Munich", "Berlin", "Hamburg", "Berlin"},
+        {true, false, true, true, false},
+    };
+}
+
+TEST(DataFrameExpression, ExpressionTypes) {
+    auto expression = col<"age"> > 30 && col<"city"> == "Berlin";
+    EXPECT_TRUE((std::is_same_v<
+        decltype(expression),
+        Conjunction<
+            Comparison<GreaterOp, ColumnReference<"age">, Literal<int>>,
+            Comparison<EqualOp, ColumnReference<"city">, Literal<std::string>>
+        >
+    >));
+    EXPECT_TRUE(IsExpression<decltype(expression)>);
+    EXPECT_FALSE(IsExpression<decltype(col<"age">)>);
+    EXPECT_FALSE(IsExpression<int>);
+}
+
+TEST(DataFrameExpression, ExpressionNames) {
+    EXPECT_TRUE((std::is_same_v<GetExpressionNames<decltype(col<"age"> > 30)>, NameList<"age">>));
+    EXPECT_TRUE((std::is_same_v<
+        GetExpressionNames<decltype(!(col<"age"> > col<"weight">) || col<"age"> < 10)>,
+        NameList<"age", "weight">
+    >));
+    EXPECT_TRUE((is_valid_expression<decltype(col<"age"> > 30), Column<"age", int>>));
+    EXPECT_FALSE((is_valid_expression<decltype(col<"age"> > 30), Column<"weight", int>>));
+}
+
+TEST(DataFrameExpression, EvaluateComparison) {
+    const auto data = createExpressionColumnStore();
+    EXPECT_THAT(evaluateExpression(col<"age"> > 31, data, 5, ExpressionColumns{}), ::testing::ElementsAre(0, 1, 1, 0, 1));
+    EXPECT_THAT(evaluateExpression(col<"age"> <= 31, data, 5, ExpressionColumns{}), ::testing::ElementsAre(1, 0, 0, 1, 0));
+    EXPECT_THAT(evaluateExpression(31 < col<"age">, data, 5, ExpressionColumns{}), ::testing::ElementsAre(0, 1, 1, 0, 1));
+    EXPECT_THAT(evaluateExpression(col<"weight"> >= 72.0, data, 5, ExpressionColumns{}), ::testing::ElementsAre(0, 1, 1, 1, 0));
+    EXPECT_THAT(evaluateExpression(col<"weight"> != 72, data, 5, ExpressionColumns{}), ::testing::ElementsAre(1, 1, 0, 1, 1));
+    EXPECT_THAT(evaluateExpression(col<"city"> == "Berlin", data, 5, ExpressionColumns{}), ::testing::ElementsAre(1, 0, 1, 0, 1));
+    EXPECT_THAT(evaluateExpression(col<"valid"> == true, data, 5, ExpressionColumns{}), ::testing::ElementsAre(1, 0, 1, 1, 0));
+    EXPECT_THAT(evaluateExpression(col<"age"> < col<"weight">, data, 5, ExpressionColumns{}), ::testing::ElementsAre(1, 1, 1, 1, 1));
+}
+
+TEST(DataFrameExpression, EvaluateLogicalOperations) {
+    const auto data = createExpressionColumnStore();
+    EXPECT_THAT(evaluateExpression(col<"age"> > 30 && col<"city"> == "Berlin", data, 5, ExpressionColumns{}), ::testing::ElementsAre(0, 0, 1, 0, 1));
+    EXPECT_THAT(evaluateExpression(col<"age"> < 30 || col<"city"> == "Hamburg", data, 5, ExpressionColumns{}), ::testing::ElementsAre(1, 0, 0, 1, 0));
+    EXPECT_THAT(evaluateExpression(!(col<"city"> == "Berlin"), data, 5, ExpressionColumns{}), ::testing::ElementsAre(0, 1, 0, 1, 0));
+    EXPECT_THAT(evaluateExpression(Tautology{}, data, 5, ExpressionColumns{}), ::testing::ElementsAre(1, 1, 1, 1, 1));
+}
+
+TEST(DataFrameExpression, ToSelection) {
+    EXPECT_THAT(toSelection(ExpressionMask{0, 1, 1, 0, 1}).getRowIndices(), ::testing::ElementsAre(1, 2, 4));
+    EXPECT_THAT(toSelection(ExpressionMask{1, 0, 0}).getRowIndices(), ::testing::ElementsAre(0));
+    EXPECT_EQ(toSelection(ExpressionMask{0, 0}).getSize(), 0);
+    EXPECT_EQ(toSelection(ExpressionMask{0, 0}).getNumberOfRows(), 2);
+    EXPECT_EQ(toSelection(ExpressionMask{}).getSize(), 0);
+
+    Selection selection{{0, 1, 3}, 5};
+    EXPECT_EQ(toSelection(ExpressionMask{0, 1, 1, 1, 1}, selection), (Selection{{1, 3}, 5}));
+}
+
+TEST(DataFrameExpression, SplitAndCombineConjunctions) {
+    auto expression = col<"age"> > 30 && (col<"city"> == "Berlin" && col<"weight"> < 80.0);
+    auto conjunctions = splitConjunctions(expression);
+    EXPECT_EQ(std::tuple_size_v<decltype(conjunctions)>, 3);
+    EXPECT_EQ(std::get<0>(conjunctions).rhs.value, 30);
+    EXPECT_EQ(std::get<1>(conjunctions).rhs.value, "Berlin");
+    EXPECT_EQ(std::tuple_size_v<decltype(splitConjunctions(col<"age"> > 30 || col<"age"> < 10))>, 1);
+    EXPECT_EQ(std::tuple_size_v<decltype(splitConjunctions(Tautology{}))>, 0);
+
+    EXPECT_TRUE((std::is_same_v<decltype(combineConjunctions(std::tuple<>{})), Tautology>));
+    const auto data = createExpressionColumnStore();
+    EXPECT_THAT(evaluateExpression(combineConjunctions(conjunctions), data, 5, ExpressionColumns{}), ::testing::ElementsAre(0, 0, 1, 0, 1));
+}
+
+TEST(DataFrameExpression, JoinPushdown) {
+    using Names = NameList<"id">;
+    using NamesLeft = NameList<"id", "a">;
+    using NamesRight = NameList<"id", "b">;
+    using OnLeft = decltype(col<"a"> > 1);
+    using OnRight = decltype(col<"b"> > 1);
+    using OnKey = decltype(col<"id"> > 1);
+    using OnBoth = decltype(col<"a"> > col<"b">);
+
+    using Inner = JoinPushdown<Join::Inner, Names, NamesLeft, NamesRight>;
+    EXPECT_TRUE((Inner::is_pushed_left<OnLeft> && not Inner::is_pushed_right<OnLeft>));
+    EXPECT_TRUE((not Inner::is_pushed_left<OnRight> && Inner::is_pushed_right<OnRight>));
+    EXPECT_TRUE((Inner::is_pushed_left<OnKey> && Inner::is_pushed_right<OnKey>));
+    EXPECT_TRUE((Inner::Residual::value<OnBoth>));
+
+    using Left = JoinPushdown<Join::Left, Names, NamesLeft, NamesRight>;
+    EXPECT_TRUE((Left::is_pushed_left<OnLeft>));
+    EXPECT_TRUE((Left::Residual::value<OnRight>));
+    EXPECT_TRUE((Left::is_pushed_left<OnKey> && Left::is_pushed_right<OnKey>));
+
+    using Outer = JoinPushdown<Join::Outer, Names, NamesLeft, NamesRight>;
+    EXPECT_TRUE((Outer::Residual::value<OnLeft>));
+    EXPECT_TRUE((Outer::Residual::value<OnRight>));
+    EXPECT_TRUE((Outer::is_pushed_left<OnKey> && Outer::is_pushed_right<OnKey>));
+
+    using Semi = JoinPushdown<Join::Semi, Names, NamesLeft, NamesRight>;
+    EXPECT_TRUE((Semi::is_pushed_left<OnLeft> && not Semi::is_pushed_right<OnLeft>));
+    EXPECT_TRUE((not Semi::is_pushed_left<OnRight> && Semi::is_pushed_right<OnRight>));
+    EXPECT_TRUE((Semi::is_valid_filter<std::tuple<OnLeft, OnRight, OnKey>>));
+    EXPECT_FALSE((Semi::is_valid_filter<std::tuple<OnLeft, OnBoth>>));
+
+    using Anti = JoinPushdown<Join::Anti, Names, NamesLeft, NamesRight>;
+    EXPECT_TRUE((not Anti::is_pushed_left<OnRight> && Anti::is_pushed_right<OnRight>));
+    EXPECT_FALSE((is_valid_join_filter<Join::Anti, Names, NamesLeft, NamesRight, decltype(col<"b"> > 1 && col<"a"> > col<"b">)>));
+    EXPECT_TRUE((is_valid_join_filter<Join::Inner, Names, NamesLeft, NamesRight, decltype(col<"b"> > 1 && col<"a"> > col<"b">)>));
+}
+
+TEST(DataFrameExpression, EvaluateWithMissingValues) {
+    using OptionalColumns = TypeList<Column<"value", std::optional<double>>, Column<"name", std::optional<std::string>>>;
+    std::tuple<std::vector<std::optional<double>>, std::vector<std::optional<std::string>>> data {
+        {1.0, std::nullopt, 3.0},
+        {"a", "b", std::nullopt},
+    };
+    EXPECT_THAT(evaluateExpression(col<"value"> < 2.0, data, 3, OptionalColumns{}), ::testing::ElementsAre(1, 0, 0));
+    EXPECT_THAT(evaluateExpression(col<"value"> != 1.0, data, 3, OptionalColumns{}), ::testing::ElementsAre(0, 0, 1));
+    EXPECT_THAT(evaluateExpression(col<"name"> != "a", data, 3, OptionalColumns{}), ::testing::ElementsAre(0, 1, 0));
+}
+
+TEST(DataFrameExpression, EvaluateCategorical) {
+    using CategoricalColumns = TypeList<Column<"city", Categorical>, Column<"optional_city", std::optional<Categorical>>>;
+    std::tuple<std::vector<Categorical>, std::vector<std::optional<Categorical>>> data {
+        {"Munich", "Berlin", "Hamburg", "Berlin"},
+        {"Munich", std::nullopt, "Hamburg", "Berlin"},
+    };
+    const auto dictionary_size = getCategoricalDictionary().getSize();
+    EXPECT_THAT(evaluateExpression(col<"city"> == "Berlin", data, 4, CategoricalColumns{}), ::testing::ElementsAre(0, 1, 0, 1));
+    EXPECT_THAT(evaluateExpression(col<"city"> != "Berlin", data, 4, CategoricalColumns{}), ::testing::ElementsAre(1, 0, 1, 0));
+    EXPECT_THAT(evaluateExpression(col<"city"> == "Cologne", data, 4, CategoricalColumns{}), ::testing::ElementsAre(0, 0, 0, 0));
+    EXPECT_THAT(evaluateExpression(col<"city"> != "Cologne", data, 4, CategoricalColumns{}), ::testing::ElementsAre(1, 1, 1, 1));
+    EXPECT_THAT(evaluateExpression(col<"city"> < "Cologne", data, 4, CategoricalColumns{}), ::testing::ElementsAre(0, 1, 0, 1));
+    EXPECT_THAT(evaluateExpression(col<"city"> >= "Hamburg", data, 4, CategoricalColumns{}), ::testing::ElementsAre(1, 0, 1, 0));
+    EXPECT_THAT(evaluateExpression("Hamburg" < col<"city">, data, 4, CategoricalColumns{}), ::testing::ElementsAre(1, 0, 0, 0));
+    EXPECT_THAT(evaluateExpression(col<"optional_city"> != "Cologne", data, 4, CategoricalColumns{}), ::testing::ElementsAre(1, 0, 1, 1));
+    EXPECT_THAT(evaluateExpression(col<"optional_city"> <= "Hamburg", data, 4, CategoricalColumns{}), ::testing::ElementsAre(0, 0, 1, 1));
+    EXPECT_FALSE(getCategoricalDictionary().find("Cologne").has_value());
+    EXPECT_EQ(getCategoricalDictionary().getSize(), dictionary_size);
+}
+
+TEST(DataFrameExpression, EvaluateOnRow) {
+    const auto data = createExpressionColumnStore();
+    using Names = NameList<"age", "weight", "city", "valid">;
+    using Indices = std::integer_sequence<std::size_t, 0, 1, 2, 3>;
+    auto expression = (col<"age"> > 30 && col<"city"> == "Berlin") || !(col<"weight"> < 90.0);
+    ExpressionMask mask{};
+    for (std::size_t row_index = 0; row_index < 5; ++row_index) {
+        mask.push_back(evaluateExpressionOnRow(expression, RowView<ExpressionColumnStore, Names, Indices>{data, row_index}));
+    }
+    EXPECT_EQ(mask, evaluateExpression(expression, data, 5, ExpressionColumns{}));
+    EXPECT_TRUE(evaluateExpressionOnRow(35 < col<"age">, RowView<ExpressionColumnStore, Names, Indices>{data, 2}));
+}
@@ -15,6 +15,7 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <string>
 #include <type_traits>
 #include <vector>
 
@@ -133,4 +134,34 @@ TEST(DataFrameInternal, ConstructDataFrameForApply) {
         ConstructDataFrameForApply<NameList<"first">, "newcol", double, Column<"first", int>>,
         DataFrame<Column<"first", int>, Column<"newcol", double>>
     >));
-}
\ No newline at end of file
+}
+
+TEST(DataFrameInternal, GatherIntoContainer) {
+    std::vector<int> source {10, 20, 30};
+    std::vector<int> container {1};
+
+    gatherIntoContainer(container, source, {2, 0, 2});
+    EXPECT_THAT(container, ::testing::ElementsAre(1, 30, 10, 30));
+}
+
+TEST(DataFrameInternal, RowView) {
+    auto data = std::make_tuple(std::vector<int>{1, 2}, std::vector<std::string>{"a", "b"}, std::vector<bool>{true, false});
+    using View = RowView<decltype(data), NameList<"str", "flag">, std::integer_sequence<std::size_t, 1, 2>>;
+
+    View view{data, 1};
+    EXPECT_EQ(view.getRowIndex(), 1);
+    EXPECT_TRUE((std::is_same_v<decltype(view.get<"str">()), const std::string&>));
+    EXPECT_EQ(&view.get<"str">(), &std::get<1>(data)[1]);
+    EXPECT_EQ(view.get<"flag">(), false);
+    EXPECT_EQ(view.get<0>(), "b");
+
+    NamedTuple<Field<"str", std::string>, Field<"flag", bool>> named_tuple = View{data, 0};
+    EXPECT_EQ(named_tuple.get<"str">(), "a");
+    EXPECT_EQ(named_tuple.get<"flag">(), true);
+}
+
+TEST(DataFrameInternal, GetNamePosition) {
+    EXPECT_EQ((getNamePosition<"b", "a", "b", "c">()), 1);
+    EXPECT_EQ((getNamePosition<"a", "a">()), 0);
+    EXPECT_EQ((getNamePosition<"d", "a", "b">()), 2);
+}
@@ -0,0 +1,323 @@
+// Copyright 2022 Andi Hellmund
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "data_crunching/internal/dataframe_join.hpp"
+
+using namespace dacr;
+using namespace dacr::internal;
+
+TEST(DataFrameJoin, GetJoinedColumns) {
+    using ColumnsLeft = TypeList<Column<"id", int>, Column<"a", double>>;
+    using ColumnsRight = TypeList<Column<"b", char>>;
+
+    EXPECT_TRUE((std::is_same_v<
+        GetJoinedColumns<Join::Inner, NameList<"id">, ColumnsLeft, ColumnsRight>,
+        TypeList<Column<"id", int>, Column<"a", double>, Column<"b", char>>
+    >));
+    EXPECT_TRUE((std::is_same_v<
+        GetJoinedColumns<Join::Left, NameList<"id">, ColumnsLeft, ColumnsRight>,
+        TypeList<Column<"id", int>, Column<"a", double>, Column<"b", std::optional<char>>>
+    >));
+    EXPECT_TRUE((std::is_same_v<
+        GetJoinedColumns<Join::Right, NameList<"id">, ColumnsLeft, ColumnsRight>,
+        TypeList<Column<"id", int>, Column<"a", std::optional<double>>, Column<"b", char>>
+    >));
+    EXPECT_TRUE((std::is_same_v<
+        GetJoinedColumns<Join::Outer, NameList<"id">, ColumnsLeft, ColumnsRight>,
+        TypeList<Column<"id", int>, Column<"a", std::optional<double>>, Column<"b", std::optional<char>>>
+    >));
+    EXPECT_TRUE((std::is_same_v<
+        GetJoinedColumns<Join::Semi, NameList<"id">, ColumnsLeft, ColumnsRight>,
+        ColumnsLeft
+    >));
+    EXPECT_TRUE((std::is_same_v<
+        MakeColumnOptional<Column<"a", std::optional<int>>>,
+        Column<"a", std::optional<int>>
+    >));
+}
+
+TEST(DataFrameJoin, IsValidJoin) {
+    using ColumnsLeft = TypeList<Column<"id", int>, Column<"a", double>>;
+    EXPECT_TRUE((is_valid_join<NameList<"id">, ColumnsLeft, TypeList<Column<"id", int>, Column<"b", char>>>));
+    EXPECT_FALSE((is_valid_join<NameList<>, ColumnsLeft, TypeList<Column<"id", int>, Column<"b", char>>>));
+    EXPECT_FALSE((is_valid_join<NameList<"id">, ColumnsLeft, TypeList<Column<"id", long>, Column<"b", char>>>));
+    EXPECT_FALSE((is_valid_join<NameList<"id">, ColumnsLeft, TypeList<Column<"id", int>, Column<"a", char>>>));
+    EXPECT_FALSE((is_valid_join<NameList<"id", "b">, ColumnsLeft, TypeList<Column<"id", int>, Column<"b", char>>>));
+}
+
+TEST(DataFrameJoin, HashJoinTable) {
+    auto column_store_data = std::make_tuple(
+        std::vector<int>{1, 2, 1, 3},
+        std::vector<double>{1.0, 2.0, 3.0, 4.0}
+    );
+    auto probe_data = std::make_tuple(std::vector<int>{1, 4});
+
+    HashJoinTable<decltype(column_store_data), std::integer_sequence<std::size_t, 0>> table{column_store_data, 4};
+
+    std::vector<std::size_t> matches{};
+    table.forEachMatch(probe_data, 0, std::integer_sequence<std::size_t, 0>{}, [&](std::size_t row_index) {
+        matches.push_back(row_index);
+    });
+    EXPECT_THAT(matches, ::testing::ElementsAre(0, 2));
+
+    matches.clear();
+    table.forEachMatch(probe_data, 1, std::integer_sequence<std::size_t, 0>{}, [&](std::size_t row_index) {
+        matches.push_back(row_index);
+    });
+    EXPECT_TRUE(matches.empty());
+}
+
+TEST(DataFrameJoin, OrderJoinedRowsByLeftIndex) {
+    JoinedRowIndices joined_rows {
+        .left = {2, 0, 2, 1},
+        .right = {0, 1, 2, 3},
+    };
+    orderJoinedRowsByLeftIndex(joined_rows, 3);
+    EXPECT_THAT(joined_rows.left, ::testing::ElementsAre(0, 1, 2, 2));
+    EXPECT_THAT(joined_rows.right, ::testing::ElementsAre(1, 3, 0, 2));
+}
+
+TEST(DataFrameJoin, HashJoin) {
+    auto left = std::make_tuple(
+        std::vector<int>{1, 2, 3, 1},
+        std::vector<std::string>{"a", "b", "c", "b"}
+    );
+    auto right = std::make_tuple(
+        std::vector<std::string>{"b", "a", "b"},
+        std::vector<int>{1, 1, 1}
+    );
+    using KeyIndicesLeft = std::integer_sequence<std::size_t, 0, 1>;
+    using KeyIndicesRight = std::integer_sequence<std::size_t, 1, 0>;
+
+    // hash table built on the right (smaller) side
+    auto joined_rows = hashJoin<dacr::Join::Inner>(left, 4, right, 3, KeyIndicesLeft{}, KeyIndicesRight{});
+    EXPECT_THAT(joined_rows.left, ::testing::ElementsAre(0, 3, 3));
+    EXPECT_THAT(joined_rows.right, ::testing::ElementsAre(1, 0, 2));
+
+    // hash table built on the left (smaller) side
+    auto joined_rows_swapped = hashJoin<dacr::Join::Inner>(right, 3, left, 4, KeyIndicesRight{}, KeyIndicesLeft{});
+    EXPECT_THAT(joined_rows_swapped.left, ::testing::ElementsAre(0, 1, 2));
+    EXPECT_THAT(joined_rows_swapped.right, ::testing::ElementsAre(3, 0, 3));
+
+    auto joined_rows_empty = hashJoin<dacr::Join::Inner>(left, 0, right, 3, KeyIndicesLeft{}, KeyIndicesRight{});
+    EXPECT_EQ(joined_rows_empty.getSize(), 0);
+}
+
+TEST(DataFrameJoin, HashJoinOuter) {
+    auto left = std::make_tuple(std::vector<int>{1, 2, 3});
+    auto right = std::make_tuple(std::vector<int>{4, 3, 1, 3});
+    using KeyIndices = std::integer_sequence<std::size_t, 0>;
+
+    auto joined_rows_left = hashJoin<Join::Left>(left, 3, right, 4, KeyIndices{}, KeyIndices{});
+    EXPECT_THAT(joined_rows_left.left, ::testing::ElementsAre(0, 1, 2, 2));
+    EXPECT_THAT(joined_rows_left.right, ::testing::ElementsAre(2, NO_ROW_INDEX, 1, 3));
+
+    auto joined_rows_right = hashJoin<Join::Right>(left, 3, right, 4, KeyIndices{}, KeyIndices{});
+    EXPECT_THAT(joined_rows_right.left, ::testing::ElementsAre(0, 2, 2, NO_ROW_INDEX));
+    EXPECT_THAT(joined_rows_right.right, ::testing::ElementsAre(2, 1, 3, 0));
+
+    auto joined_rows_outer = hashJoin<Join::Outer>(right, 4, left, 3, KeyIndices{}, KeyIndices{});
+    EXPECT_THAT(joined_rows_outer.left, ::testing::ElementsAre(0, 1, 2, 3, NO_ROW_INDEX));
+    EXPECT_THAT(joined_rows_outer.right, ::testing::ElementsAre(NO_ROW_INDEX, 2, 0, 2, 1));
+}
+
+TEST(DataFrameJoin, HashJoinSemiAnti) {
+    auto left = std::make_tuple(std::vector<int>{1, 2, 3});
+    auto right = std::make_tuple(std::vector<int>{3, 1, 3, 5});
+    using KeyIndices = std::integer_sequence<std::size_t, 0>;
+
+    auto joined_rows_semi = hashJoin<Join::Semi>(left, 3, right, 4, KeyIndices{}, KeyIndices{});
+    EXPECT_THAT(joined_rows_semi.left, ::testing::ElementsAre(0, 2));
+    EXPECT_TRUE(joined_rows_semi.right.empty());
+
+    auto joined_rows_anti = hashJoin<Join::Anti>(left, 3, right, 4, KeyIndices{}, KeyIndices{});
+    EXPECT_THAT(joined_rows_anti.left, ::testing::ElementsAre(1));
+
+    auto joined_rows_semi_swapped = hashJoin<Join::Semi>(right, 4, left, 3, KeyIndices{}, KeyIndices{});
+    EXPECT_THAT(joined_rows_semi_swapped.left, ::testing::ElementsAre(0, 1, 2));
+
+    auto joined_rows_anti_swapped = hashJoin<Join::Anti>(right, 4, left, 3, KeyIndices{}, KeyIndices{});
+    EXPECT_THAT(joined_rows_anti_swapped.left, ::testing::ElementsAre(3));
+}
+
+TEST(DataFrameJoin, CompareRowsByKeys) {
+    auto lhs = std::make_tuple(std::vector<int>{1, 1, 2}, std::vector<double>{1.0, 2.0, 0.0});
+    auto rhs = std::make_tuple(std::vector<double>{2.0}, std::vector<int>{1});
+    using KeyIndicesLhs = std::integer_sequence<std::size_t, 0, 1>;
+    using KeyIndicesRhs = std::integer_sequence<std::size_t, 1, 0>;
+
+    EXPECT_EQ(compareRowsByKeys(lhs, 0, KeyIndicesLhs{}, rhs, 0, KeyIndicesRhs{}), -1);
+    EXPECT_EQ(compareRowsByKeys(lhs, 1, KeyIndicesLhs{}, rhs, 0, KeyIndicesRhs{}), 0);
+    EXPECT_EQ(compareRowsByKeys(lhs, 2, KeyIndicesLhs{}, rhs, 0, KeyIndicesRhs{}), 1);
+}
+
+TEST(DataFrameJoin, SortMergeJoin) {
+    auto left = std::make_tuple(std::vector<int>{1, 2, 2, 3, 5});
+    auto right = std::make_tuple(std::vector<int>{0, 2, 2, 3, 4});
+    using KeyIndices = std::integer_sequence<std::size_t, 0>;
+
+    auto joined_rows_inner = sortMergeJoin<Join::Inner>(left, 5, right, 5, KeyIndices{}, KeyIndices{});
+    EXPECT_THAT(joined_rows_inner.left, ::testing::ElementsAre(1, 1, 2, 2, 3));
+    EXPECT_THAT(joined_rows_inner.right, ::testing::ElementsAre(1, 2, 1, 2, 3));
+
+    auto joined_rows_outer = sortMergeJoin<Join::Outer>(left, 5, right, 5, KeyIndices{}, KeyIndices{});
+    EXPECT_THAT(joined_rows_outer.left, ::testing::ElementsAre(0, 1, 1, 2, 2, 3, 4, NO_ROW_INDEX, NO_ROW_INDEX));
+    EXPECT_THAT(joined_rows_outer.right, ::testing::ElementsAre(NO_ROW_INDEX, 1, 2, 1, 2, 3, NO_ROW_INDEX, 0, 4));
+
+    auto joined_rows_semi = sortMergeJoin<Join::Semi>(left, 5, right, 5, KeyIndices{}, KeyIndices{});
+    EXPECT_THAT(joined_rows_semi.left, ::testing::ElementsAre(1, 2, 3));
+    EXPECT_TRUE(joined_rows_semi.right.empty());
+
+    auto joined_rows_anti = sortMergeJoin<Join::Anti>(left, 5, right, 5, KeyIndices{}, KeyIndices{});
+    EXPECT_THAT(joined_rows_anti.left, ::testing::ElementsAre(0, 4));
+}
+
+TEST(DataFrameJoin, SortMergeJoinMatchesHashJoin) {
+    auto left = std::make_tuple(std::vector<int>{1, 1, 2, 2, 4, 6}, std::vector<int>{0, 1, 0, 0, 1, 1});
+    auto right = std::make_tuple(std::vector<int>{0, 1, 1, 2, 4, 4, 5}, std::vector<int>{0, 1, 1, 0, 0, 1, 1});
+    using KeyIndices = std::integer_sequence<std::size_t, 0, 1>;
+
+    auto expect_same = [&]<Join JoinType>() {
+        auto joined_rows_hash = hashJoin<JoinType>(left, 6, right, 7, KeyIndices{}, KeyIndices{});
+        auto joined_rows_merge = sortMergeJoin<JoinType>(left, 6, right, 7, KeyIndices{}, KeyIndices{});
+        EXPECT_EQ(joined_rows_hash.left, joined_rows_merge.left);
+        EXPECT_EQ(joined_rows_hash.right, joined_rows_merge.right);
+    };
+    expect_same.template operator()<Join::Inner>();
+    expect_same.template operator()<Join::Left>();
+    expect_same.template operator()<Join::Right>();
+    expect_same.template operator()<Join::Outer>();
+    expect_same.template operator()<Join::Semi>();
+    expect_same.template operator()<Join::Anti>();
+}
+
+struct CountedJoinKey {
+    int value;
+
+    static inline std::size_t num_comparisons {0};
+
+    friend bool operator< (const CountedJoinKey& lhs, const CountedJoinKey& rhs) {
+        ++num_comparisons;
+        return lhs.value < rhs.value;
+    }
+};
+
+TEST(DataFrameJoin, SortMergeJoinLargeKeyGroup) {
+    // one group of equal keys on the left, distinct keys on the right: each row is scanned once
+    constexpr std::size_t NUM_ROWS = 1000;
+    auto left = std::make_tuple(std::vector<CountedJoinKey>(NUM_ROWS, CountedJoinKey{static_cast<int>(NUM_ROWS)}));
+    auto right = std::make_tuple(std::vector<CountedJoinKey>{});
+    for (std::size_t i = 0; i < NUM_ROWS; ++i) {
+        std::get<0>(right).push_back(CountedJoinKey{static_cast<int>(i)});
+    }
+    using KeyIndices = std::integer_sequence<std::size_t, 0>;
+
+    CountedJoinKey::num_comparisons = 0;
+    auto joined_rows = sortMergeJoin<Join::Left>(left, NUM_ROWS, right, NUM_ROWS, KeyIndices{}, KeyIndices{});
+    EXPECT_EQ(joined_rows.left.size(), NUM_ROWS);
+    EXPECT_LT(CountedJoinKey::num_comparisons, 10 * NUM_ROWS);
+
+    CountedJoinKey::num_comparisons = 0;
+    auto joined_rows_outer = sortMergeJoin<Join::Outer>(left, NUM_ROWS, right, NUM_ROWS, KeyIndices{}, KeyIndices{});
+    ASSERT_EQ(joined_rows_outer.right.size(), 2 * NUM_ROWS);
+    EXPECT_EQ(joined_rows_outer.right[NUM_ROWS], 0);
+    EXPECT_EQ(joined_rows_outer.right.back(), NUM_ROWS - 1);
+    EXPECT_LT(CountedJoinKey::num_comparisons, 10 * NUM_ROWS);
+}
+
+TEST(DataFrameJoin, SortMergeJoinUnsorted) {
+    auto sorted = std::make_tuple(std::vector<int>{1, 2, 3});
+    auto unsorted = std::make_tuple(std::vector<int>{1, 3, 2});
+    using KeyIndices = std::integer_sequence<std::size_t, 0>;
+
+    EXPECT_THROW((sortMergeJoin<Join::Inner>(sorted, 3, unsorted, 3, KeyIndices{}, KeyIndices{})), std::invalid_argument);
+    EXPECT_THROW((sortMergeJoin<Join::Inner>(unsorted, 3, sorted, 3, KeyIndices{}, KeyIndices{})), std::invalid_argument);
+}
+
+TEST(DataFrameJoin, RadixPartitionRows) {
+    auto column_store_data = std::make_tuple(std::vector<int>{5, 1, 5, 7, 1, 3, 5, 2});
+    using KeyIndices = std::integer_sequence<std::size_t, 0>;
+
+    auto partitioning = radixPartitionRows(column_store_data, 8, KeyIndices{}, 2, 3);
+    ASSERT_EQ(partitioning.offsets.size(), 5);
+    EXPECT_EQ(partitioning.offsets.front(), 0);
+    EXPECT_EQ(partitioning.offsets.back(), 8);
+    for (std::size_t partition = 0; partition < 4; ++partition) {
+        auto rows = partitioning.getRows(partition);
+        auto hashes = partitioning.getHashes(partition);
+        EXPECT_TRUE(std::is_sorted(rows.begin(), rows.end()));
+        for (std::size_t slot = 0; slot < rows.size(); ++slot) {
+            EXPECT_EQ(hashes[slot], hashRow(column_store_data, rows[slot], KeyIndices{}));
+            EXPECT_EQ(getRadixPartition(hashes[slot], 2), partition);
+        }
+    }
+}
+
+TEST(DataFrameJoin, PartitionedHashJoinMatchesHashJoin) {
+    std::vector<int> left_keys{};
+    std::vector<int> right_keys{};
+    for (int i = 0; i < 5000; ++i) {
+        left_keys.push_back((i * 7) % 1500);
+    }
+    for (int i = 0; i < 2000; ++i) {
+        right_keys.push_back((i * 13) % 3000);
+    }
+    auto left = std::make_tuple(left_keys);
+    auto right = std::make_tuple(right_keys);
+    using KeyIndices = std::integer_sequence<std::size_t, 0>;
+
+    auto to_sorted_pairs = [](const JoinedRowIndices& joined_rows) {
+        std::vector<std::pair<std::size_t, std::size_t>> pairs{};
+        for (std::size_t i = 0; i < joined_rows.left.size(); ++i) {
+            pairs.emplace_back(joined_rows.left[i], joined_rows.right.empty() ? NO_ROW_INDEX : joined_rows.right[i]);
+        }
+        std::sort(pairs.begin(), pairs.end());
+        return pairs;
+    };
+    auto expect_same = [&]<Join JoinType>() {
+        auto joined_rows_hash = hashJoin<JoinType>(left, left_keys.size(), right, right_keys.size(), KeyIndices{}, KeyIndices{});
+        auto joined_rows_partitioned = partitionedHashJoin<JoinType>(left, left_keys.size(), right, right_keys.size(), KeyIndices{}, KeyIndices{}, 4);
+        auto joined_rows_swapped = partitionedHashJoin<JoinType>(right, right_keys.size(), left, left_keys.size(), KeyIndices{}, KeyIndices{}, 3);
+        auto joined_rows_hash_swapped = hashJoin<JoinType>(right, right_keys.size(), left, left_keys.size(), KeyIndices{}, KeyIndices{});
+        EXPECT_EQ(to_sorted_pairs(joined_rows_hash), to_sorted_pairs(joined_rows_partitioned));
+        EXPECT_EQ(to_sorted_pairs(joined_rows_hash_swapped), to_sorted_pairs(joined_rows_swapped));
+    };
+    expect_same.template operator()<Join::Inner>();
+    expect_same.template operator()<Join::Left>();
+    expect_same.template operator()<Join::Right>();
+    expect_same.template operator()<Join::Outer>();
+    expect_same.template operator()<Join::Semi>();
+    expect_same.template operator()<Join::Anti>();
+}
+
+TEST(DataFrameJoin, GatherJoinedRowsIntoContainer) {
+    std::vector<int> source {10, 20};
+    std::vector<std::optional<int>> container {};
+    gatherJoinedRowsIntoContainer(container, source, {1, NO_ROW_INDEX, 0});
+    EXPECT_THAT(container, ::testing::ElementsAre(20, std::nullopt, 10));
+
+    std::vector<int> join_column {1, 0};
+    fillJoinColumnForUnmatchedRightRows(join_column, source, JoinedRowIndices{.left = {0, NO_ROW_INDEX}, .right = {NO_ROW_INDEX, 1}});
+    EXPECT_THAT(join_column, ::testing::ElementsAre(1, 20));
+}
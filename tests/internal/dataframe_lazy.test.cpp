@@ -0,0 +1,101 @@
+// Copyright 2022 Andi Hellmund
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "data_crunching/internal/dataframe_lazy.hpp"
+
+using namespace dacr;
+using namespace dacr::internal;
+
+using LazyTestSourceSchema = GetLazySourceSchema<TypeList<Column<"a", int>, Column<"b", double>>>;
+using LazyTestSourceStore = std::tuple<std::vector<int>, std::vector<double>>;
+
+TEST(DataFrameLazy, Schema) {
+    EXPECT_TRUE((std::is_same_v<
+        LazyTestSourceSchema,
+        TypeList<LazyColumn<"a", int, false, 0>, LazyColumn<"b", double, false, 1>>
+    >));
+    EXPECT_TRUE((std::is_same_v<GetLazySchemaNames<LazyTestSourceSchema>, NameList<"a", "b">>));
+    EXPECT_TRUE((std::is_same_v<GetLazyColumnByName<"b", LazyTestSourceSchema>, LazyColumn<"b", double, false, 1>>));
+    EXPECT_TRUE((std::is_same_v<GetLazyColumnByName<"c", LazyTestSourceSchema>, void>));
+    EXPECT_TRUE((std::is_same_v<GetLazySelectNames<SelectAll, LazyTestSourceSchema>, NameList<"a", "b">>));
+    EXPECT_TRUE((std::is_same_v<GetLazySelectNames<Select<"b">, LazyTestSourceSchema>, NameList<"b">>));
+
+    EXPECT_TRUE((is_valid_lazy_select<SelectAll, LazyTestSourceSchema>));
+    EXPECT_TRUE((is_valid_lazy_select<Select<"b", "a">, LazyTestSourceSchema>));
+    EXPECT_FALSE((is_valid_lazy_select<Select<"c">, LazyTestSourceSchema>));
+    EXPECT_FALSE((is_valid_lazy_select<Select<"a", "a">, LazyTestSourceSchema>));
+}
+
+TEST(DataFrameLazy, Plan) {
+    auto apply_function = [](auto row) { return row.template get<"a">() * 0.5; };
+    auto query_function = [](auto row) { return row.template get<"c">() > 1.0; };
+    using Stages = std::tuple<
+        LazyApply<"c", Select<"a">, decltype(apply_function)>,
+        LazyQuery<SelectAll, decltype(query_function)>,
+        LazySelect<NameList<"c", "a">>
+    >;
+
+    using PlanAfterApply = LazyPlanAt<1, LazyTestSourceSchema, LazyTestSourceStore, Stages>;
+    EXPECT_TRUE((std::is_same_v<typename PlanAfterApply::computed_types, TypeList<double>>));
+    EXPECT_TRUE((std::is_same_v<GetLazySchemaNames<typename PlanAfterApply::schema>, NameList<"a", "c">>));
+    EXPECT_TRUE((std::is_same_v<GetLazyColumnByName<"c", typename PlanAfterApply::schema>, LazyColumn<"c", double, true, 0>>));
+
+    using PlanAfterSelect = LazyPlanAt<3, LazyTestSourceSchema, LazyTestSourceStore, Stages>;
+    EXPECT_TRUE((std::is_same_v<
+        typename PlanAfterSelect::schema,
+        TypeList<LazyColumn<"c", double, true, 0>, LazyColumn<"a", int, false, 0>>
+    >));
+
+    EXPECT_TRUE((std::is_same_v<GetLazyStageReadNames<std::tuple_element_t<0, Stages>, LazyTestSourceSchema>, NameList<"a">>));
+    EXPECT_TRUE((std::is_same_v<GetLazyStageReadNames<std::tuple_element_t<1, Stages>, typename PlanAfterApply::schema>, NameList<"a", "c">>));
+    EXPECT_TRUE((std::is_same_v<GetLazyStageReadNames<LazySort<TypeList<Desc<"b">>>, LazyTestSourceSchema>, NameList<"b">>));
+}
+
+TEST(DataFrameLazy, RowView) {
+    LazyTestSourceStore source{std::vector<int>{1, 2, 3, 4}, std::vector<double>{1.5, 2.5, 3.5, 4.5}};
+    std::vector<double> computed_previous{10.0, 20.0, 30.0};
+    std::vector<double> computed_current{100.0};
+    using Schema = TypeList<
+        LazyColumn<"b", double, false, 1>,
+        LazyColumn<"c", double, true, 0>,
+        LazyColumn<"d", double, true, 1>
+    >;
+    using RowView = LazyRowView<Schema, LazyTestSourceStore, std::tuple<const std::vector<double>*, const std::vector<double>*>>;
+
+    // source row 3 at input position 2, to be written at output position 0
+    RowView row{source, {&computed_previous, &computed_current}, 3, 2, 0, 1};
+    EXPECT_EQ(row.get<"b">(), 4.5);
+    EXPECT_EQ(row.get<"c">(), 30.0);
+    EXPECT_EQ(row.get<"d">(), 100.0);
+    EXPECT_EQ(row.getRowIndex(), 3);
+}
+
+TEST(DataFrameLazy, IsRowBefore) {
+    LazyTestSourceStore source{std::vector<int>{1, 1, 2}, std::vector<double>{1.5, 2.5, 0.5}};
+    using RowView = LazyRowView<LazyTestSourceSchema, LazyTestSourceStore, std::tuple<>>;
+    auto row = [&source](std::size_t row_index) { return RowView{source, {}, row_index, row_index, row_index, 0}; };
+
+    EXPECT_TRUE(isLazyRowBefore(row(0), row(2), TypeList<Asc<"a">>{}));
+    EXPECT_FALSE(isLazyRowBefore(row(0), row(1), TypeList<Asc<"a">>{}));
+    EXPECT_TRUE(isLazyRowBefore(row(1), row(0), TypeList<Asc<"a">, Desc<"b">>{}));
+    EXPECT_TRUE(isLazyRowBefore(row(2), row(0), TypeList<Desc<"a">>{}));
+}
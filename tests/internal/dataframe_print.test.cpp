@@ -93,4 +93,16 @@ TEST(DataFramePrint, DataFormatter) {
     EXPECT_GE(DataFormatter<double>::getWidth({.fixedpoint_width = 20}), 11);
     EXPECT_GE(DataFormatter<std::string>::getWidth({.string_width = 30}), 30);
     EXPECT_GE(DataFormatter<CustomData>::getWidth({.custom_width = 40}), 40);
-}
\ No newline at end of file
+}
+
+TEST(DataFramePrint, DataFormatterOptional) {
+    EXPECT_EQ(DataFormatter<std::optional<int>>::getWidth({}), DataFormatter<int>::getWidth({}));
+
+    std::stringstream sstr;
+    DataFormatter<std::optional<std::string>>::format(sstr, std::nullopt, {.string_width = 6});
+    EXPECT_EQ(sstr.str(), "null  ");
+
+    sstr.str(std::string());
+    DataFormatter<std::optional<std::string>>::format(sstr, "abc", {.string_width = 6});
+    EXPECT_EQ(sstr.str(), "abc   ");
+}
@@ -0,0 +1,74 @@
+// Copyright 2022 Andi Hellmund
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include "data_crunching/internal/dataframe_query.hpp"
+
+using namespace dacr;
+using namespace dacr::internal;
+
+TEST(DataFrameQuery, SelectionAll) {
+    auto selection = Selection::all(4);
+    EXPECT_THAT(selection.getRowIndices(), ::testing::ElementsAre(0, 1, 2, 3));
+    EXPECT_EQ(selection.getSize(), 4);
+    EXPECT_EQ(selection.getNumberOfRows(), 4);
+    EXPECT_EQ(Selection::all(0).getSize(), 0);
+}
+
+TEST(DataFrameQuery, SelectionCombination) {
+    Selection lhs{{0, 2, 3, 6}, 8};
+    Selection rhs{{1, 2, 6, 7}, 8};
+    EXPECT_THAT((lhs & rhs).getRowIndices(), ::testing::ElementsAre(2, 6));
+    EXPECT_THAT((lhs | rhs).getRowIndices(), ::testing::ElementsAre(0, 1, 2, 3, 6, 7));
+    EXPECT_THAT((~lhs).getRowIndices(), ::testing::ElementsAre(1, 4, 5, 7));
+    EXPECT_EQ(~~lhs, lhs);
+    EXPECT_EQ((lhs & rhs).getNumberOfRows(), 8);
+    EXPECT_EQ(~Selection::all(3), (Selection{{}, 3}));
+
+    EXPECT_THROW((lhs & Selection{{}, 7}), std::invalid_argument);
+    EXPECT_THROW((lhs | Selection{{}, 9}), std::invalid_argument);
+}
+
+TEST(DataFrameQuery, SelectRows) {
+    auto is_even = [](std::size_t row_index) {
+        return row_index % 2 == 0;
+    };
+    auto selection = selectRows(7, is_even);
+    EXPECT_THAT(selection.getRowIndices(), ::testing::ElementsAre(0, 2, 4, 6));
+    EXPECT_EQ(selection.getNumberOfRows(), 7);
+
+    std::vector<std::size_t> evaluated_rows{};
+    auto sub_selection = selectRows(Selection{{1, 2, 5, 6}, 7}, [&](std::size_t row_index) {
+        evaluated_rows.push_back(row_index);
+        return is_even(row_index);
+    });
+    EXPECT_THAT(sub_selection.getRowIndices(), ::testing::ElementsAre(2, 6));
+    EXPECT_THAT(evaluated_rows, ::testing::ElementsAre(1, 2, 5, 6));
+}
+
+TEST(DataFrameQuery, SelectRowsParallel) {
+    const std::size_t num_rows = 5 * ROWS_PER_MORSEL + 17;
+    auto is_selected = [](std::size_t row_index) {
+        return row_index % 3 == 0 || row_index % 7 == 0;
+    };
+    for (std::size_t num_threads : {1, 4}) {
+        EXPECT_EQ(selectRowsParallel(num_rows, num_threads, is_selected), selectRows(num_rows, is_selected));
+    }
+    EXPECT_EQ(selectRowsParallel(0, 4, is_selected).getSize(), 0);
+}
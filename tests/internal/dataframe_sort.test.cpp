@@ -15,6 +15,12 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <string>
 #include <type_traits>
 #include <vector>
 #include <tuple>
@@ -78,3 +84,209 @@ TEST(DataFramePrint, ConstructElementComparison) {
         >
     >));
 }
+
+TEST(DataFrameSort, ArgsortRows) {
+    auto data = std::make_tuple(
+        std::vector<int>{3, 1, 2, 1},
+        std::vector<char>{'a', 'b', 'c', 'a'}
+    );
+    using ComparisonAsc = ConstructElementComparison<SortOrder::Ascending, std::integer_sequence<std::size_t, 0, 1>>;
+    EXPECT_THAT(argsortRows<ComparisonAsc>(data, 4), ::testing::ElementsAre(3, 1, 2, 0));
+
+    using ComparisonDesc = ConstructElementComparison<SortOrder::Descending, std::integer_sequence<std::size_t, 1, 0>>;
+    EXPECT_THAT(argsortRows<ComparisonDesc>(data, 4), ::testing::ElementsAre(2, 1, 0, 3));
+
+    EXPECT_TRUE(argsortRows<ComparisonAsc>(data, 0).empty());
+}
+
+TEST(DataFrameSort, IsRadixSortable) {
+    EXPECT_TRUE((is_radix_sortable<TypeList<int>>));
+    EXPECT_TRUE((is_radix_sortable<TypeList<double, long>>));
+    EXPECT_TRUE((is_radix_sortable<TypeList<bool, char, float>>));
+    EXPECT_FALSE((is_radix_sortable<TypeList<std::string>>));
+    EXPECT_FALSE((is_radix_sortable<TypeList<int, std::string>>));
+#if defined(__SIZEOF_INT128__)
+    EXPECT_FALSE((is_radix_sortable<TypeList<double, long, int>>));
+#endif
+}
+
+TEST(DataFrameSort, ToRadixKey) {
+    auto expect_ordered = []<typename T>(std::vector<T> ascending_values) {
+        for (std::size_t i = 1; i < ascending_values.size(); ++i) {
+            EXPECT_LT(toRadixKey<SortOrder::Ascending>(ascending_values[i - 1]), toRadixKey<SortOrder::Ascending>(ascending_values[i]));
+            EXPECT_GT(toRadixKey<SortOrder::Descending>(ascending_values[i - 1]), toRadixKey<SortOrder::Descending>(ascending_values[i]));
+        }
+    };
+    expect_ordered(std::vector<int>{std::numeric_limits<int>::min(), -5, -1, 0, 1, 7, std::numeric_limits<int>::max()});
+    expect_ordered(std::vector<char>{-128, -1, 0, 1, 127});
+    expect_ordered(std::vector<unsigned long>{0, 1, 1UL << 40, std::numeric_limits<unsigned long>::max()});
+    expect_ordered(std::vector<double>{-std::numeric_limits<double>::infinity(), -1e300, -2.5, -1e-300, 0.0, 1e-300, 2.5, 1e300, std::numeric_limits<double>::infinity()});
+    expect_ordered(std::vector<float>{-3.5f, -0.5f, 0.0f, 0.25f, 8.0f});
+    EXPECT_LT(toRadixKey<SortOrder::Ascending>(false), toRadixKey<SortOrder::Ascending>(true));
+    EXPECT_GT(toRadixKey<SortOrder::Descending>(false), toRadixKey<SortOrder::Descending>(true));
+    EXPECT_EQ(toRadixKey<SortOrder::Ascending>(-0.0), toRadixKey<SortOrder::Ascending>(0.0));
+    EXPECT_EQ(toRadixKey<SortOrder::Descending>(-0.0f), toRadixKey<SortOrder::Descending>(0.0f));
+}
+
+TEST(DataFrameSort, ArgsortRowsByRadix) {
+    std::vector<int> column_int{};
+    std::vector<double> column_double{};
+    std::vector<std::int64_t> column_long{};
+    for (int i = 0; i < 2000; ++i) {
+        column_int.push_back((i * 7919) % 61 - 30);
+        column_double.push_back(((i * 104729) % 1013) / 7.0 - 50.0);
+        column_long.push_back((static_cast<std::int64_t>(i) * 15485863) % 100003 - 50000);
+    }
+    auto data = std::make_tuple(column_int, column_double, column_long);
+
+    // the radix sort is stable, i.e. it must be identical to a stable comparison sort
+    auto expect_same_as_stable_sort = [&]<SortOrder Order, std::size_t ...Indices>(std::integer_sequence<std::size_t, Indices...>) {
+        using Comparison = ConstructElementComparison<Order, std::integer_sequence<std::size_t, Indices...>>;
+        std::vector<std::size_t> expected(2000);
+        std::iota(expected.begin(), expected.end(), 0);
+        std::stable_sort(expected.begin(), expected.end(), [&](std::size_t lhs, std::size_t rhs) {
+            return Comparison::compare(data, lhs, rhs);
+        });
+        EXPECT_EQ((argsortRowsByRadix<ConstructSortKeys<Order, std::integer_sequence<std::size_t, Indices...>>>(data, 2000)), expected);
+    };
+    expect_same_as_stable_sort.template operator()<SortOrder::Ascending>(std::integer_sequence<std::size_t, 0>{});
+    expect_same_as_stable_sort.template operator()<SortOrder::Descending>(std::integer_sequence<std::size_t, 1>{});
+    expect_same_as_stable_sort.template operator()<SortOrder::Ascending>(std::integer_sequence<std::size_t, 0, 1>{});
+    expect_same_as_stable_sort.template operator()<SortOrder::Descending>(std::integer_sequence<std::size_t, 0, 2>{});
+    expect_same_as_stable_sort.template operator()<SortOrder::Ascending>(std::integer_sequence<std::size_t, 2, 1>{});
+
+    EXPECT_TRUE((argsortRowsByRadix<ConstructSortKeys<SortOrder::Ascending, std::integer_sequence<std::size_t, 0>>>(data, 0).empty()));
+}
+
+TEST(DataFrameSort, MergeSortedRuns) {
+    std::vector<std::size_t> row_indices{1, 4, 7, 0, 2, 9, 3, 5, 6, 8};
+    std::vector<std::size_t> output(row_indices.size());
+    mergeSortedRuns(row_indices, {{0, 3}, {3, 6}, {6, 6}, {6, 10}}, output.data(), std::less<std::size_t>{});
+    EXPECT_THAT(output, ::testing::ElementsAre(0, 1, 2, 3, 4, 5, 6, 7, 8, 9));
+}
+
+TEST(DataFrameSort, ArgsortRowsParallel) {
+    const std::size_t size = 5 * MIN_ROWS_PER_SORT_RUN + 123;
+    std::vector<int> column_int(size);
+    std::vector<std::string> column_string(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        column_int[i] = static_cast<int>((i * 7919) % 13);
+        column_string[i] = std::to_string((i * 104729) % 997);
+    }
+    auto data = std::make_tuple(column_int, column_string);
+
+    using Comparison = ConstructElementComparison<SortOrder::Descending, std::integer_sequence<std::size_t, 0, 1>>;
+    std::vector<std::size_t> expected(size);
+    std::iota(expected.begin(), expected.end(), 0);
+    std::stable_sort(expected.begin(), expected.end(), [&](std::size_t lhs, std::size_t rhs) {
+        return Comparison::compare(data, lhs, rhs);
+    });
+    for (std::size_t num_threads : {1, 2, 3, 8}) {
+        EXPECT_EQ(argsortRowsParallel<Comparison>(data, size, num_threads), expected);
+    }
+    EXPECT_TRUE(argsortRowsParallel<Comparison>(data, 0, 4).empty());
+}
+
+TEST(DataFrameSort, ArgsortTopRows) {
+    auto data = std::make_tuple(std::vector<int>{5, 1, 9, 3, 9, 7, 1}, std::vector<char>{'a', 'b', 'c', 'd', 'e', 'f', 'g'});
+    using ComparisonDescending = ConstructElementComparison<SortOrder::Descending, std::integer_sequence<std::size_t, 0>>;
+    using ComparisonAscending = ConstructElementComparison<SortOrder::Ascending, std::integer_sequence<std::size_t, 0>>;
+
+    EXPECT_THAT(argsortTopRows<ComparisonDescending>(data, 7, 3), ::testing::ElementsAre(2, 4, 5));
+    EXPECT_THAT(argsortTopRows<ComparisonAscending>(data, 7, 2), ::testing::ElementsAre(1, 6));
+    EXPECT_THAT(argsortTopRows<ComparisonAscending>(data, 7, 10), ::testing::ElementsAre(1, 6, 3, 0, 5, 2, 4));
+    EXPECT_TRUE(argsortTopRows<ComparisonAscending>(data, 7, 0).empty());
+    EXPECT_TRUE(argsortTopRows<ComparisonAscending>(data, 0, 3).empty());
+}
+
+TEST(DataFrameSort, ConstructSortKeys) {
+    EXPECT_TRUE((std::is_same_v<
+        ConstructSortKeys<SortOrder::Descending, std::integer_sequence<std::size_t, 2, 0>>,
+        TypeList<SortKey<SortOrder::Descending, 2>, SortKey<SortOrder::Descending, 0>>
+    >));
+    EXPECT_TRUE((std::is_same_v<
+        ConstructSortKeysBySpecs<TypeList<Asc<"c">, Desc<"a">>, Column<"a", int>, Column<"b", double>, Column<"c", char>>,
+        TypeList<SortKey<SortOrder::Ascending, 2>, SortKey<SortOrder::Descending, 0>>
+    >));
+    EXPECT_TRUE((std::is_same_v<
+        GetSortKeyIndices<TypeList<SortKey<SortOrder::Ascending, 2>, SortKey<SortOrder::Descending, 0>>>,
+        std::integer_sequence<std::size_t, 2, 0>
+    >));
+    EXPECT_TRUE((std::is_same_v<
+        ConstructElementComparisonBySortKeys<TypeList<SortKey<SortOrder::Ascending, 2>, SortKey<SortOrder::Descending, 0>>>,
+        CompareElementsForSort<SortOrder::Ascending, 2, CompareElementsForSort<SortOrder::Descending, 0, void>>
+    >));
+}
+
+TEST(DataFrameSort, IsValidSortKeySpecList) {
+    EXPECT_TRUE((is_valid_sort_key_spec_list<TypeList<Asc<"a">, Desc<"b">>, Column<"a", int>, Column<"b", double>>));
+    EXPECT_FALSE((is_valid_sort_key_spec_list<TypeList<>, Column<"a", int>>));
+    EXPECT_FALSE((is_valid_sort_key_spec_list<TypeList<Asc<"a">, Desc<"a">>, Column<"a", int>>));
+    EXPECT_FALSE((is_valid_sort_key_spec_list<TypeList<Asc<"c">>, Column<"a", int>>));
+    EXPECT_FALSE((is_valid_sort_key_spec_list<TypeList<int>, Column<"a", int>>));
+}
+
+TEST(DataFrameSort, ArgsortRowsMixedOrders) {
+    auto data = std::make_tuple(std::vector<int>{1, 2, 1, 2, 1}, std::vector<double>{1.0, 5.0, 3.0, 5.0, 2.0});
+    using SortKeys = TypeList<SortKey<SortOrder::Ascending, 0>, SortKey<SortOrder::Descending, 1>>;
+    using Comparison = ConstructElementComparisonBySortKeys<SortKeys>;
+    EXPECT_THAT(argsortRowsStable<Comparison>(data, 5), ::testing::ElementsAre(2, 4, 0, 1, 3));
+
+    std::vector<int> column_int{};
+    std::vector<double> column_double{};
+    for (int i = 0; i < 1000; ++i) {
+        column_int.push_back(i % 7);
+        column_double.push_back((i * 31) % 11 - 5.5);
+    }
+    auto large_data = std::make_tuple(column_int, column_double);
+    EXPECT_EQ(argsortRowsByRadix<SortKeys>(large_data, 1000), argsortRowsStable<Comparison>(large_data, 1000));
+}
+
+TEST(DataFrameSort, HasStringPrefixKey) {
+    using Data = std::tuple<std::vector<int>, std::vector<std::string>>;
+    EXPECT_TRUE((has_string_prefix_key<TypeList<SortKey<SortOrder::Ascending, 1>, SortKey<SortOrder::Ascending, 0>>, Data>));
+    EXPECT_FALSE((has_string_prefix_key<TypeList<SortKey<SortOrder::Ascending, 0>, SortKey<SortOrder::Ascending, 1>>, Data>));
+}
+
+TEST(DataFrameSort, ToStringPrefixKey) {
+    EXPECT_EQ(toStringPrefixKey<SortOrder::Ascending>(""), 0);
+    EXPECT_EQ(toStringPrefixKey<SortOrder::Ascending>("a"), 0x6100000000000000ULL);
+    EXPECT_EQ(toStringPrefixKey<SortOrder::Ascending>("abcdefghij"), toStringPrefixKey<SortOrder::Ascending>("abcdefghxy"));
+    EXPECT_LT(toStringPrefixKey<SortOrder::Ascending>("ab"), toStringPrefixKey<SortOrder::Ascending>("abc"));
+    EXPECT_LT(toStringPrefixKey<SortOrder::Ascending>("abc"), toStringPrefixKey<SortOrder::Ascending>("b"));
+    EXPECT_LT(toStringPrefixKey<SortOrder::Ascending>("z"), toStringPrefixKey<SortOrder::Ascending>("\xff"));
+    EXPECT_GT(toStringPrefixKey<SortOrder::Descending>("abc"), toStringPrefixKey<SortOrder::Descending>("b"));
+}
+
+TEST(DataFrameSort, ArgsortRowsByStringPrefix) {
+    std::vector<std::string> column_string{
+        "berlin", "", "berlin_mitte", "berlin_mitte", "a", std::string("a\0", 2), "berlin_kreuzberg",
+        "\xff", "paris", "berlin_mitte_", "", "a",
+    };
+    std::vector<int> column_int{3, 1, 2, 5, 7, 1, 9, 0, 4, 4, 2, 6};
+    auto data = std::make_tuple(column_string, column_int);
+
+    auto expect_same_as_stable_sort = [&]<typename SortKeys>(SortKeys) {
+        using Comparison = ConstructElementComparisonBySortKeys<SortKeys>;
+        EXPECT_EQ((argsortRowsByStringPrefix<SortKeys, true>(data, column_string.size())), argsortRowsStable<Comparison>(data, column_string.size()));
+        auto row_indices = argsortRowsByStringPrefix<SortKeys, false>(data, column_string.size());
+        for (std::size_t i = 1; i < row_indices.size(); ++i) {
+            EXPECT_FALSE(Comparison::compare(data, row_indices[i], row_indices[i - 1]));
+        }
+    };
+    expect_same_as_stable_sort(TypeList<SortKey<SortOrder::Ascending, 0>>{});
+    expect_same_as_stable_sort(TypeList<SortKey<SortOrder::Descending, 0>>{});
+    expect_same_as_stable_sort(TypeList<SortKey<SortOrder::Ascending, 0>, SortKey<SortOrder::Descending, 1>>{});
+    expect_same_as_stable_sort(TypeList<SortKey<SortOrder::Descending, 0>, SortKey<SortOrder::Ascending, 1>>{});
+}
+
+TEST(DataFrameSort, IsRowBeforeBySortKeys) {
+    auto lhs = std::make_tuple(std::vector<int>{1, 2}, std::vector<double>{5.0, 3.0});
+    auto rhs = std::make_tuple(std::vector<int>{2, 1}, std::vector<double>{4.0, 6.0});
+    using SortKeys = TypeList<SortKey<SortOrder::Ascending, 0>, SortKey<SortOrder::Descending, 1>>;
+    EXPECT_TRUE(isRowBeforeBySortKeys(lhs, 0, rhs, 0, SortKeys{}));
+    EXPECT_FALSE(isRowBeforeBySortKeys(lhs, 0, rhs, 1, SortKeys{}));
+    EXPECT_TRUE(isRowBeforeBySortKeys(rhs, 1, lhs, 0, SortKeys{}));
+    EXPECT_FALSE(isRowBeforeBySortKeys(lhs, 1, rhs, 0, SortKeys{}));
+    EXPECT_TRUE(isRowBeforeBySortKeys(rhs, 0, lhs, 1, SortKeys{}));
+}
@@ -15,6 +15,8 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <cmath>
+#include <string>
 #include <type_traits>
 #include <vector>
 #include <tuple>
@@ -66,6 +68,35 @@ TEST(DataFrameSummarize, SummarizerStdDev) {
     EXPECT_FLOAT_EQ(summarizer.getState(), 2.1602468994693f);
 }
 
+TEST(DataFrameSummarize, SummarizerVariance) {
+    auto data = std::make_tuple(std::vector<int>{2, 4, 4, 4, 5, 5, 7, 9});
+    SummarizerVariance<0, int> variance;
+    applyToSummarizer(variance, data);
+    EXPECT_DOUBLE_EQ(variance.getState(), 4.0);
+
+    SummarizerVarianceSample<0, int> variance_sample;
+    applyToSummarizer(variance_sample, data);
+    EXPECT_DOUBLE_EQ(variance_sample.getState(), 32.0 / 7.0);
+
+    SummarizerStdDevSample<0, int> stddev_sample;
+    applyToSummarizer(stddev_sample, data);
+    EXPECT_DOUBLE_EQ(stddev_sample.getState(), std::sqrt(32.0 / 7.0));
+
+    SummarizerStdDev<0, int> stddev_empty;
+    EXPECT_TRUE(std::isnan(stddev_empty.getState()));
+    SummarizerVarianceSample<0, int> variance_sample_single;
+    applyToSummarizer(variance_sample_single, std::make_tuple(std::vector<int>{1}));
+    EXPECT_TRUE(std::isnan(variance_sample_single.getState()));
+}
+
+TEST(DataFrameSummarize, SummarizerVarianceLargeOffset) {
+    // the naive sum-of-squares formula loses all precision for such values
+    auto data = std::make_tuple(std::vector<double>{1e9 + 4, 1e9 + 7, 1e9 + 13, 1e9 + 16});
+    SummarizerVarianceSample<0, double> variance;
+    applyToSummarizer(variance, data);
+    EXPECT_DOUBLE_EQ(variance.getState(), 30.0);
+}
+
 TEST(DataFrameSummarize, SummarizerCountIfCountIfNot) {
     auto data = std::make_tuple(std::vector<bool>{true, false, true});
     SummarizerCountIf<0, bool> summarizer;
@@ -77,6 +108,79 @@ TEST(DataFrameSummarize, SummarizerCountIfCountIfNot) {
     EXPECT_EQ(summarizer_not.getState(), 1);
 }
 
+template <typename Summarizer, typename ColumnStoreData>
+Summarizer summarizeInTwoParts (const ColumnStoreData& data, std::size_t split_index) {
+    Summarizer first{};
+    Summarizer second{};
+    for (auto loop_index = 0LU; loop_index < std::get<0>(data).size(); ++loop_index) {
+        (loop_index < split_index ? first : second).summarize(data, loop_index);
+    }
+    first.merge(second);
+    return first;
+}
+
+TEST(DataFrameSummarize, SummarizerMerge) {
+    auto data = std::make_tuple(std::vector<int>{10, 5, 8, 3, 12});
+    EXPECT_EQ((summarizeInTwoParts<SummarizerSum<0, int>>(data, 2).getState()), 38);
+    EXPECT_EQ((summarizeInTwoParts<SummarizerMin<0, int>>(data, 2).getState()), 3);
+    EXPECT_EQ((summarizeInTwoParts<SummarizerMax<0, int>>(data, 2).getState()), 12);
+    EXPECT_DOUBLE_EQ((summarizeInTwoParts<SummarizerAvg<0, int>>(data, 2).getState()), 7.6);
+    EXPECT_DOUBLE_EQ((summarizeInTwoParts<SummarizerAvg<0, int>>(data, 0).getState()), 7.6);
+    EXPECT_DOUBLE_EQ((summarizeInTwoParts<SummarizerAvg<0, int>>(data, 5).getState()), 7.6);
+
+    SummarizerStdDev<0, int> stddev{};
+    applyToSummarizer(stddev, data);
+    EXPECT_DOUBLE_EQ((summarizeInTwoParts<SummarizerStdDev<0, int>>(data, 3).getState()), stddev.getState());
+    EXPECT_DOUBLE_EQ((summarizeInTwoParts<SummarizerStdDev<0, int>>(data, 0).getState()), stddev.getState());
+    EXPECT_DOUBLE_EQ((summarizeInTwoParts<SummarizerStdDev<0, int>>(data, 5).getState()), stddev.getState());
+    SummarizerVarianceSample<0, int> variance_sample{};
+    applyToSummarizer(variance_sample, data);
+    EXPECT_DOUBLE_EQ((summarizeInTwoParts<SummarizerVarianceSample<0, int>>(data, 2).getState()), variance_sample.getState());
+
+    auto data_bool = std::make_tuple(std::vector<bool>{true, false, true, true});
+    EXPECT_EQ((summarizeInTwoParts<SummarizerCountIf<0, bool>>(data_bool, 1).getState()), 3);
+    EXPECT_EQ((summarizeInTwoParts<SummarizerCountIfNot<0, bool>>(data_bool, 1).getState()), 1);
+}
+
+TEST(DataFrameSummarize, SummarizeRange) {
+    std::vector<int> values{};
+    std::vector<bool> flags{};
+    for (int i = 0; i < 100; ++i) {
+        values.push_back((i * 31) % 97 - 40);
+        flags.push_back(i % 3 == 0);
+    }
+    auto data = std::make_tuple(values, flags);
+
+    auto expect_same_as_row_wise = [&]<typename Summarizer>(std::size_t begin, std::size_t end) {
+        Summarizer summarizer_rows{};
+        Summarizer summarizer_range{};
+        for (auto index = begin; index < end; ++index) {
+            summarizer_rows.summarize(data, index);
+        }
+        summarizer_range.summarizeRange(data, begin, end);
+        if constexpr (std::is_same_v<typename Summarizer::TargetType, double>) {
+            if (std::isnan(summarizer_rows.getState())) {
+                EXPECT_TRUE(std::isnan(summarizer_range.getState()));
+            }
+            else {
+                EXPECT_NEAR(summarizer_range.getState(), summarizer_rows.getState(), 1e-9);
+            }
+        }
+        else {
+            EXPECT_EQ(summarizer_range.getState(), summarizer_rows.getState());
+        }
+    };
+    for (auto [begin, end] : {std::make_pair(0UL, 100UL), std::make_pair(13UL, 50UL), std::make_pair(20UL, 20UL)}) {
+        expect_same_as_row_wise.template operator()<SummarizerSum<0, int>>(begin, end);
+        expect_same_as_row_wise.template operator()<SummarizerMin<0, int>>(begin, end);
+        expect_same_as_row_wise.template operator()<SummarizerMax<0, int>>(begin, end);
+        expect_same_as_row_wise.template operator()<SummarizerAvg<0, int>>(begin, end);
+        expect_same_as_row_wise.template operator()<SummarizerVarianceSample<0, int>>(begin, end);
+        expect_same_as_row_wise.template operator()<SummarizerCountIf<1, bool>>(begin, end);
+        expect_same_as_row_wise.template operator()<SummarizerCountIfNot<1, bool>>(begin, end);
+    }
+}
+
 TEST(DataFrameSummarize, AreValidSummarizeOps) {
     EXPECT_TRUE((are_valid_summarize_ops<
         TypeList<Avg<"first", "first_avg">, Sum<"second", "second_sum">, Max<"first", "first_max">, Min<"second", "second_min">>,
@@ -186,6 +290,20 @@ TEST(DataFrameSummarizer, GetSummarizerForOp) {
     >));
     EXPECT_TRUE((std::is_same_v<SummarizerForStdDev::TargetType, double>));
 
+    // Operation: StdDevSample, Variance, VarianceSample
+    EXPECT_TRUE((std::is_same_v<
+        GetSummarizerForOp<StdDevSample<"a", "a_stddev">, Column<"a", int>>,
+        SummarizerVarianceImpl<0, int, VarianceType::Sample, true>
+    >));
+    EXPECT_TRUE((std::is_same_v<
+        GetSummarizerForOp<Variance<"b", "b_var">, Column<"a", int>, Column<"b", float>>,
+        SummarizerVarianceImpl<1, float, VarianceType::Population, false>
+    >));
+    EXPECT_TRUE((std::is_same_v<
+        GetSummarizerForOp<VarianceSample<"a", "a_var">, Column<"a", int>>,
+        SummarizerVarianceImpl<0, int, VarianceType::Sample, false>
+    >));
+
     // Operation: CountIf
     using SummarizerForCountIf = GetSummarizerForOp<CountIf<"a", "a_cntif">, Column<"a", bool>, Column<"b", float>>;
     EXPECT_TRUE((std::is_same_v<
@@ -221,4 +339,54 @@ TEST(DataFrameSummarize, GetCompoundSummarizer) {
             SummarizerAvg<2, int>
         >
     >));
-}
\ No newline at end of file
+}
+
+TEST(DataFrameSummarize, SummarizationExecuterGroupBy) {
+    std::vector<int> keys1{};
+    std::vector<std::string> keys2{};
+    std::vector<int> values{};
+    for (int i = 0; i < 1000; ++i) {
+        keys1.push_back((i * 37) % 100);
+        keys2.push_back(i % 2 == 0 ? "even" : "odd");
+        values.push_back(i);
+    }
+    auto column_store_data = std::make_tuple(keys1, keys2, values);
+
+    using Executer = SummarizationExecuterGroupBy<
+        void,
+        std::integer_sequence<std::size_t, 0, 1>,
+        std::tuple<int, std::string>,
+        CompoundSummarizer<SummarizerSum<2, int>>
+    >;
+    Executer executer{};
+    applyToSummarizer(executer, column_store_data);
+    EXPECT_EQ(executer.getNumberOfGroups(), 100);
+
+    // groups are numbered in the order in which they are first seen
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(executer.findOrCreateGroup(column_store_data, i), i);
+    }
+    EXPECT_EQ(executer.getNumberOfGroups(), 100);
+}
+
+TEST(DataFrameSummarize, SummarizationExecuterGroupByMerge) {
+    auto column_store_data = std::make_tuple(std::vector<char>{'a', 'b', 'a', 'c', 'b', 'd'}, std::vector<int>{1, 2, 3, 4, 5, 6});
+
+    using Executer = SummarizationExecuterGroupBy<
+        void,
+        std::integer_sequence<std::size_t, 0>,
+        std::tuple<char>,
+        CompoundSummarizer<SummarizerSum<1, int>>
+    >;
+    Executer first{};
+    Executer second{};
+    for (std::size_t row_index = 0; row_index < 6; ++row_index) {
+        (row_index < 3 ? first : second).summarize(column_store_data, row_index);
+    }
+    first.merge(second);
+    ASSERT_EQ(first.getNumberOfGroups(), 4);
+    EXPECT_EQ(first.findOrCreateGroup(column_store_data, 0), 0);
+    EXPECT_EQ(first.findOrCreateGroup(column_store_data, 1), 1);
+    EXPECT_EQ(first.findOrCreateGroup(column_store_data, 3), 2);
+    EXPECT_EQ(first.findOrCreateGroup(column_store_data, 5), 3);
+}
@@ -0,0 +1,46 @@
+// Copyright 2022 Andi Hellmund
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <span>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "data_crunching/internal/dataframe_view.hpp"
+
+using namespace dacr;
+using namespace dacr::internal;
+
+TEST(DataFrameView, ColumnSpanStoreDataType) {
+    EXPECT_TRUE((std::is_same_v<
+        ConstructColumnSpanStoreDataType<Column<"a", int>, Column<"b", std::string>, Column<"c", bool>>,
+        std::tuple<std::span<const int>, std::span<const std::string>, BoolColumnSpan>
+    >));
+}
+
+TEST(DataFrameView, BoolColumnSpan) {
+    ColumnVector<bool> column {true, false, true};
+    BoolColumnSpan span {column};
+    EXPECT_EQ(span.size(), 3);
+    EXPECT_TRUE(span[0]);
+    EXPECT_FALSE(span[1]);
+    EXPECT_THAT(std::vector<bool>(span.begin(), span.end()), ::testing::ElementsAre(true, false, true));
+
+    column.push_back(false);
+    EXPECT_EQ(span.size(), 4);
+}
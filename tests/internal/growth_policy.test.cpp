@@ -0,0 +1,30 @@
+// Copyright 2022 Andi Hellmund
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "data_crunching/internal/growth_policy.hpp"
+
+using namespace dacr;
+
+TEST(GrowthPolicy, GetCapacity) {
+    GrowthPolicy policy{};
+    EXPECT_EQ(policy.getCapacity(0, 1), 16);
+    EXPECT_EQ(policy.getCapacity(100, 101), 150);
+    EXPECT_EQ(policy.getCapacity(100, 1000), 1000);
+
+    GrowthPolicy doubling{.factor = 2.0, .min_capacity = 0};
+    EXPECT_EQ(doubling.getCapacity(0, 1), 1);
+    EXPECT_EQ(doubling.getCapacity(8, 9), 16);
+}
@@ -0,0 +1,57 @@
+// Copyright 2022 Andi Hellmund
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "data_crunching/internal/hash.hpp"
+
+using namespace dacr::internal;
+
+TEST(Hash, IsHashable) {
+    struct NonHashable {};
+    EXPECT_TRUE(IsHashable<int>);
+    EXPECT_TRUE(IsHashable<std::string>);
+    EXPECT_FALSE(IsHashable<NonHashable>);
+}
+
+TEST(Hash, HashRow) {
+    auto column_store_data = std::make_tuple(
+        std::vector<int>{1, 2, 1},
+        std::vector<std::string>{"a", "a", "a"}
+    );
+
+    using KeyIndices = std::integer_sequence<std::size_t, 0, 1>;
+    EXPECT_EQ(hashRow(column_store_data, 0, KeyIndices{}), hashRow(column_store_data, 2, KeyIndices{}));
+    EXPECT_NE(hashRow(column_store_data, 0, KeyIndices{}), hashRow(column_store_data, 1, KeyIndices{}));
+    EXPECT_EQ(
+        hashRow(column_store_data, 0, std::integer_sequence<std::size_t, 1>{}),
+        hashRow(column_store_data, 1, std::integer_sequence<std::size_t, 1>{})
+    );
+}
+
+TEST(Hash, AreRowsEqual) {
+    auto lhs = std::make_tuple(std::vector<int>{1, 2}, std::vector<char>{'a', 'b'});
+    auto rhs = std::make_tuple(std::vector<char>{'b', 'a'}, std::vector<int>{2, 1});
+
+    using IndicesLhs = std::integer_sequence<std::size_t, 0, 1>;
+    using IndicesRhs = std::integer_sequence<std::size_t, 1, 0>;
+    EXPECT_TRUE(areRowsEqual(lhs, 0, IndicesLhs{}, rhs, 1, IndicesRhs{}));
+    EXPECT_TRUE(areRowsEqual(lhs, 1, IndicesLhs{}, rhs, 0, IndicesRhs{}));
+    EXPECT_FALSE(areRowsEqual(lhs, 0, IndicesLhs{}, rhs, 0, IndicesRhs{}));
+}
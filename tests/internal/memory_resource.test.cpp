@@ -0,0 +1,84 @@
+// Copyright 2022 Andi Hellmund
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cstdint>
+#include <string>
+
+#include "data_crunching/internal/memory_resource.hpp"
+#include "data_crunching/internal/shared_column.hpp"
+
+using namespace dacr;
+using namespace dacr::internal;
+
+static bool isAligned (const void* pointer, std::size_t alignment) {
+    return reinterpret_cast<std::uintptr_t>(pointer) % alignment == 0;
+}
+
+TEST(MemoryResource, MonotonicMemoryResource) {
+    MonotonicMemoryResource arena{128};
+    void* first = arena.allocate(10, 1);
+    void* second = arena.allocate(16, 16);
+    EXPECT_TRUE(isAligned(second, 16));
+    EXPECT_GE(static_cast<std::byte*>(second), static_cast<std::byte*>(first) + 10);
+
+    // exceeds the block size
+    void* large = arena.allocate(1000, 64);
+    EXPECT_TRUE(isAligned(large, 64));
+    arena.deallocate(large, 1000, 64);
+    EXPECT_EQ(arena.getAllocatedBytes(), 1026);
+
+    arena.release();
+    EXPECT_EQ(arena.getAllocatedBytes(), 0);
+}
+
+TEST(MemoryResource, AlignedMemoryResource) {
+    AlignedMemoryResource aligned{};
+    ColumnVector<double> values{ColumnAllocator<double>{&aligned}};
+    values.resize(3);
+    EXPECT_TRUE(isAligned(values.data(), 64));
+
+    HugePageMemoryResource huge_pages{};
+    ColumnVector<char> large{ColumnAllocator<char>{&huge_pages}};
+    large.resize(HugePageMemoryResource::HUGE_PAGE_SIZE);
+    EXPECT_TRUE(isAligned(large.data(), HugePageMemoryResource::HUGE_PAGE_SIZE));
+}
+
+TEST(MemoryResource, ColumnAllocator) {
+    MonotonicMemoryResource arena{};
+    ColumnVector<std::string> values{ColumnAllocator<std::string>{&arena}};
+    values.push_back("a");
+    EXPECT_GE(arena.getAllocatedBytes(), sizeof(std::string));
+
+    ColumnVector<std::string> copy = values;
+    EXPECT_EQ(copy.get_allocator().getMemoryResource(), &arena);
+    EXPECT_TRUE(ColumnAllocator<int>{} == ColumnAllocator<std::string>{getDefaultMemoryResource()});
+    EXPECT_FALSE(ColumnAllocator<int>{} == ColumnAllocator<int>{&arena});
+}
+
+TEST(MemoryResource, SharedColumn) {
+    MonotonicMemoryResource arena{};
+    SharedColumn<int> column{&arena};
+    column.push_back(1);
+    EXPECT_EQ(column.get().get_allocator().getMemoryResource(), &arena);
+
+    // copy-on-write copies stay in the memory resource
+    SharedColumn<int> copy = column;
+    copy.push_back(2);
+    EXPECT_EQ(copy.getMemoryResource(), &arena);
+    EXPECT_EQ(copy.get().get_allocator().getMemoryResource(), &arena);
+    EXPECT_THAT(column, ::testing::ElementsAre(1));
+}
@@ -94,4 +94,22 @@ TEST(NameList, NameListMerge) {
         NameListMerge<NameList<"a", "c">, NameList<"b", "d">>,
         NameList<"a", "c", "b", "d">
     >));
-}
\ No newline at end of file
+}
+
+TEST(NameList, NameListUnion) {
+    EXPECT_TRUE((std::is_same_v<
+        NameListUnion<NameList<"a">, NameList<>>,
+        NameList<"a">
+    >));
+
+    EXPECT_TRUE((std::is_same_v<
+        NameListUnion<NameList<"a", "b">, NameList<"b", "c", "a">>,
+        NameList<"a", "b", "c">
+    >));
+}
+
+TEST(NameList, AreNamesInNameList) {
+    EXPECT_TRUE((are_names_in_name_list<NameList<>, NameList<"a">>));
+    EXPECT_TRUE((are_names_in_name_list<NameList<"b", "a">, NameList<"a", "b", "c">>));
+    EXPECT_FALSE((are_names_in_name_list<NameList<"a", "d">, NameList<"a", "b", "c">>));
+}
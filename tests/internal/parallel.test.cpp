@@ -0,0 +1,72 @@
+// Copyright 2022 Andi Hellmund
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include "data_crunching/internal/parallel.hpp"
+
+using namespace dacr::internal;
+
+TEST(Parallel, GetNumberOfThreads) {
+    EXPECT_EQ(getNumberOfThreads(3), 3);
+    EXPECT_GE(getNumberOfThreads(0), 1);
+}
+
+TEST(Parallel, GetChunkRange) {
+    EXPECT_EQ(getChunkRange(10, 3, 0), std::make_pair(0UL, 4UL));
+    EXPECT_EQ(getChunkRange(10, 3, 1), std::make_pair(4UL, 7UL));
+    EXPECT_EQ(getChunkRange(10, 3, 2), std::make_pair(7UL, 10UL));
+    EXPECT_EQ(getChunkRange(2, 4, 3), std::make_pair(2UL, 2UL));
+}
+
+TEST(Parallel, ParallelFor) {
+    std::vector<int> values(100, 0);
+    parallelFor(values.size(), 4, [&](std::size_t task_index) {
+        values[task_index] = static_cast<int>(task_index) * 2;
+    });
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(values[i], i * 2);
+    }
+}
+
+TEST(Parallel, ParallelForException) {
+    EXPECT_THROW(parallelFor(100, 4, [](std::size_t task_index) {
+        if (task_index == 42) {
+            throw std::runtime_error("task failed");
+        }
+    }), std::runtime_error);
+}
+
+TEST(Parallel, ParallelForMorsels) {
+    const std::size_t size = 3 * ROWS_PER_MORSEL + 5;
+    EXPECT_EQ(getNumberOfMorsels(size), 4);
+    EXPECT_EQ(getNumberOfMorsels(0), 0);
+
+    std::vector<std::size_t> values(size, 0);
+    std::vector<std::size_t> morsel_sizes(getNumberOfMorsels(size), 0);
+    parallelForMorsels(size, 4, [&](std::size_t morsel_index, std::size_t begin, std::size_t end) {
+        morsel_sizes[morsel_index] = end - begin;
+        for (std::size_t i = begin; i < end; ++i) {
+            values[i] = i + 1;
+        }
+    });
+    EXPECT_THAT(morsel_sizes, ::testing::ElementsAre(ROWS_PER_MORSEL, ROWS_PER_MORSEL, ROWS_PER_MORSEL, 5));
+    for (std::size_t i = 0; i < size; ++i) {
+        EXPECT_EQ(values[i], i + 1);
+    }
+}
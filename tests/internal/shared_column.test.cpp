@@ -0,0 +1,103 @@
+// Copyright 2022 Andi Hellmund
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "data_crunching/internal/shared_column.hpp"
+
+using namespace dacr::internal;
+
+TEST(SharedColumn, ReadAccess) {
+    SharedColumn<int> empty_column{};
+    EXPECT_EQ(empty_column.size(), 0);
+    EXPECT_TRUE(empty_column.empty());
+    EXPECT_EQ(empty_column.begin(), empty_column.end());
+
+    SharedColumn<int> column{std::vector<int>{1, 2, 3}};
+    EXPECT_EQ(column.size(), 3);
+    EXPECT_EQ(column[1], 2);
+    EXPECT_EQ(column.data()[2], 3);
+    EXPECT_THAT(column, ::testing::ElementsAre(1, 2, 3));
+    EXPECT_FALSE(column.isShared());
+}
+
+TEST(SharedColumn, CopyOnWrite) {
+    SharedColumn<std::string> column{std::vector<std::string>{"a", "b"}};
+    SharedColumn<std::string> copy = column;
+    EXPECT_TRUE(column.isShared());
+    EXPECT_EQ(copy.data(), column.data());
+    EXPECT_EQ(copy, column);
+
+    copy.push_back("c");
+    EXPECT_FALSE(column.isShared());
+    EXPECT_FALSE(copy.isShared());
+    EXPECT_THAT(column, ::testing::ElementsAre("a", "b"));
+    EXPECT_THAT(copy, ::testing::ElementsAre("a", "b", "c"));
+
+    SharedColumn<std::string> other = column;
+    other[0] = "x";
+    EXPECT_THAT(column, ::testing::ElementsAre("a", "b"));
+    EXPECT_THAT(other, ::testing::ElementsAre("x", "b"));
+
+    SharedColumn<std::string> reserved = column;
+    reserved.reserve(10);
+    EXPECT_GE(reserved.capacity(), 10);
+    EXPECT_THAT(reserved, ::testing::ElementsAre("a", "b"));
+    EXPECT_THAT(column, ::testing::ElementsAre("a", "b"));
+}
+
+TEST(SharedColumn, Modify) {
+    SharedColumn<bool> column{};
+    column.push_back(true);
+    column.push_back(false);
+    EXPECT_THAT(column, ::testing::ElementsAre(true, false));
+
+    SharedColumn<bool> copy = column;
+    copy.insert(copy.end(), column.begin(), column.end());
+    copy.erase(copy.begin(), copy.begin() + 1);
+    EXPECT_THAT(copy, ::testing::ElementsAre(false, true, false));
+    EXPECT_THAT(column, ::testing::ElementsAre(true, false));
+
+    SharedColumn<bool> moved = std::move(copy);
+    EXPECT_EQ(moved.size(), 3);
+    copy.clear();
+    EXPECT_TRUE(copy.empty());
+
+    moved = std::vector<bool>{true};
+    EXPECT_THAT(moved, ::testing::ElementsAre(true));
+}
+
+TEST(SharedColumn, ShrinkToFit) {
+    SharedColumn<int> column{};
+    column.reserve(10);
+    column.push_back(1);
+    column.shrink_to_fit();
+    EXPECT_EQ(column.capacity(), 1);
+
+    column.reserve(10);
+    SharedColumn<int> copy = column;
+    copy.shrink_to_fit();
+    EXPECT_GE(copy.capacity(), 10);
+    EXPECT_TRUE(copy.isShared());
+
+    SharedColumn<int> empty{};
+    empty.reserve(10);
+    empty.shrink_to_fit();
+    EXPECT_EQ(empty.capacity(), 0);
+}
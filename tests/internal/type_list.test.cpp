@@ -32,6 +32,11 @@ TEST(TypeList, Prepend) {
     EXPECT_TRUE((std::is_same_v<TypeListPrepend<double, TypeList<int>>, TypeList<double, int>>));
 }
 
+TEST(TypeList, Merge) {
+    EXPECT_TRUE((std::is_same_v<TypeListMerge<TypeList<>, TypeList<>>, TypeList<>>));
+    EXPECT_TRUE((std::is_same_v<TypeListMerge<TypeList<int>, TypeList<double, char>>, TypeList<int, double, char>>));
+}
+
 TEST(TypeList, ConvertTypeListToTuple) {
     EXPECT_TRUE((std::is_same_v<
         ConvertTypeListToTuple<TypeList<>>, 
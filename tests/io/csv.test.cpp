@@ -15,6 +15,9 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <filesystem>
+#include <fstream>
+
 #include "data_crunching/dataframe.hpp"
 #include "data_crunching/io/csv.hpp"
 
@@ -36,4 +39,36 @@ TEST(IoCsv, LoadFromFileWithHeader) {
     EXPECT_THAT(df.getColumn<"id">(), ::testing::ElementsAre(10));
     EXPECT_THAT(df.getColumn<"number">(), ::testing::ElementsAre(::testing::DoubleEq(20.433)));
     EXPECT_THAT(df.getColumn<"string">(), ::testing::ElementsAre(::testing::StrEq("abc")));
-}
\ No newline at end of file
+}
+
+TEST(IoCsv, LoadFromFileWithFilter) {
+    using DF = DataFrame<Column<"id", int>, Column<"number", double>, Column<"string", std::string>>;
+    auto df = load_from_csv<DF>("tests/data/filter_with_header.csv", col<"number"> > 20.0 && col<"string"> == "Berlin", ",", true);
+    EXPECT_EQ(df.getSize(), 2);
+    EXPECT_THAT(df.getColumn<"id">(), ::testing::ElementsAre(3, 5));
+    EXPECT_THAT(df.getColumn<"string">(), ::testing::ElementsAre(::testing::StrEq("Berlin"), ::testing::StrEq("Berlin")));
+}
+
+TEST(IoCsv, LoadFromFileWithFilterChunks) {
+    using DF = DataFrame<Column<"id", int>, Column<"number", double>, Column<"string", std::string>>;
+    const auto path_to_csv = std::filesystem::temp_directory_path() / "dacr_csv_filter_chunks_test.csv";
+    const int num_rows = 3 * static_cast<int>(internal::CSV_FILTER_CHUNK_ROWS) + 10;
+    {
+        std::ofstream file_stream {path_to_csv};
+        for (int i = 0; i < num_rows; ++i) {
+            file_stream << i << "," << (i % 10) << ".5,name" << (i % 3) << "\n";
+        }
+    }
+    auto df = load_from_csv<DF>(path_to_csv, col<"number"> > 9.0 && col<"string"> == "name0", ",", false);
+    std::filesystem::remove(path_to_csv);
+    ASSERT_EQ(df.getSize(), (num_rows + 29) / 30);
+    EXPECT_EQ(df.getColumn<"id">().front(), 9);
+    EXPECT_EQ(df.getColumn<"id">().back(), 30 * (df.getSize() - 1) + 9);
+}
+
+TEST(IoCsv, LoadFromFileCategorical) {
+    using DF = DataFrame<Column<"id", int>, Column<"number", double>, Column<"string", Categorical>>;
+    auto df = load_from_csv<DF>("tests/data/filter_with_header.csv", col<"string"> == "Berlin", ",", true);
+    EXPECT_THAT(df.getColumn<"id">(), ::testing::ElementsAre(1, 3, 5));
+    EXPECT_THAT(df.getColumn<"string">(), ::testing::Each(Categorical{"Berlin"}));
+}
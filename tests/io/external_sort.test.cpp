@@ -0,0 +1,125 @@
+// Copyright 2022 Andi Hellmund
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "data_crunching/dataframe.hpp"
+#include "data_crunching/io/external_sort.hpp"
+
+using namespace dacr;
+
+using DF = DataFrame<Column<"city", std::string>, Column<"revenue", double>, Column<"id", int>, Column<"flag", bool>>;
+
+DF createTestDataFrame (int num_rows) {
+    DF df{};
+    for (int i = 0; i < num_rows; ++i) {
+        df.insert("city_" + std::to_string((i * 7919) % 37), static_cast<double>((i * 104729) % 101), i, i % 3 == 0);
+    }
+    return df;
+}
+
+TEST(IoExternalSort, ColumnBlockRoundTrip) {
+    std::vector<std::string> strings{"abc", "", "defgh"};
+    std::vector<bool> flags{true, false, true};
+    std::vector<double> numbers{1.5, -2.0, 3.25};
+    std::vector<std::size_t> row_indices{2, 0, 1};
+
+    std::stringstream stream{};
+    internal::writeColumnBlock(stream, strings, row_indices.data(), 3);
+    internal::writeColumnBlock(stream, flags, row_indices.data(), 3);
+    internal::writeColumnBlock(stream, numbers, row_indices.data(), 3);
+
+    std::vector<std::string> read_strings{};
+    std::vector<bool> read_flags{};
+    std::vector<double> read_numbers{};
+    internal::readColumnBlock(stream, read_strings, 3);
+    internal::readColumnBlock(stream, read_flags, 3);
+    internal::readColumnBlock(stream, read_numbers, 3);
+    EXPECT_THAT(read_strings, ::testing::ElementsAre("defgh", "abc", ""));
+    EXPECT_THAT(read_flags, ::testing::ElementsAre(true, true, false));
+    EXPECT_THAT(read_numbers, ::testing::ElementsAre(3.25, 1.5, -2.0));
+}
+
+TEST(IoExternalSort, SortInMemory) {
+    auto df = createTestDataFrame(1000);
+    ExternalSorter<DF, Asc<"city">, Desc<"revenue">, Asc<"id">> sorter{};
+    sorter.insert(df);
+    EXPECT_EQ(sorter.getNumberOfRuns(), 0);
+    auto sorted_df = sorter.finish();
+    EXPECT_EQ(sorted_df.getColumn<"id">(), (df.sort<Asc<"city">, Desc<"revenue">, Asc<"id">>().getColumn<"id">()));
+}
+
+TEST(IoExternalSort, SortWithSpilledRuns) {
+    auto df = createTestDataFrame(20000);
+    auto expected_df = df.sort<Asc<"city">, Desc<"revenue">, Asc<"id">>();
+
+    ExternalSorter<DF, Asc<"city">, Desc<"revenue">, Asc<"id">> sorter{ExternalSortOptions{.memory_budget = 64 * 1024}};
+    const auto& cities = df.getColumn<"city">();
+    const auto& revenues = df.getColumn<"revenue">();
+    const auto& ids = df.getColumn<"id">();
+    const auto& flags = df.getColumn<"flag">();
+    for (std::size_t i = 0; i < df.getSize(); ++i) {
+        sorter.insert(cities[i], revenues[i], ids[i], static_cast<bool>(flags[i]));
+    }
+    EXPECT_GT(sorter.getNumberOfRuns(), 10);
+
+    auto sorted_df = sorter.finish();
+    EXPECT_EQ(sorted_df.getColumn<"city">(), expected_df.getColumn<"city">());
+    EXPECT_EQ(sorted_df.getColumn<"revenue">(), expected_df.getColumn<"revenue">());
+    EXPECT_EQ(sorted_df.getColumn<"id">(), expected_df.getColumn<"id">());
+    EXPECT_EQ(sorted_df.getColumn<"flag">(), expected_df.getColumn<"flag">());
+    EXPECT_EQ(sorter.getNumberOfRuns(), 0);
+}
+
+TEST(IoExternalSort, SortIntoSink) {
+    ExternalSorter<DF, Desc<"id">> sorter{ExternalSortOptions{.memory_budget = 1024}};
+    for (int chunk = 0; chunk < 5; ++chunk) {
+        sorter.insert(createTestDataFrame(100 * (chunk + 1)));
+    }
+    EXPECT_EQ(sorter.getNumberOfRuns(), 5);
+
+    std::vector<int> ids{};
+    sorter.finish([&ids](const std::string&, double, int id, bool) {
+        ids.push_back(id);
+    });
+    ASSERT_EQ(ids.size(), 1500);
+    EXPECT_TRUE(std::is_sorted(ids.begin(), ids.end(), std::greater<int>{}));
+    EXPECT_EQ(ids.front(), 499);
+}
+
+TEST(IoExternalSort, RemovesRunFiles) {
+    const auto temp_directory = std::filesystem::temp_directory_path() / "dacr_external_sort_test";
+    std::filesystem::create_directories(temp_directory);
+    {
+        ExternalSorter<DF, Asc<"id">> sorter{ExternalSortOptions{.memory_budget = 1024, .temp_directory = temp_directory}};
+        sorter.insert(createTestDataFrame(1000));
+        EXPECT_GT(sorter.getNumberOfRuns(), 0);
+        EXPECT_FALSE(std::filesystem::is_empty(temp_directory));
+    }
+    EXPECT_TRUE(std::filesystem::is_empty(temp_directory));
+    std::filesystem::remove(temp_directory);
+}
+
+TEST(IoExternalSort, ThrowsForInvalidTempDirectory) {
+    ExternalSorter<DF, Asc<"id">> sorter{ExternalSortOptions{.memory_budget = 1, .temp_directory = "/non/existing/directory"}};
+    EXPECT_THROW(sorter.insert("a", 1.0, 1, true), IoException);
+}